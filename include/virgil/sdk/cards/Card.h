@@ -45,7 +45,13 @@
 
 namespace virgil {
     namespace sdk {
+        namespace crypto {
+            class Crypto;
+        }
+
         namespace cards {
+            class CardManager;
+
             /*!
              * @brief Class representing Virgil Card
              */
@@ -160,9 +166,21 @@ namespace virgil {
                 client::models::RawSignedModel getRawCard() const;
 
             private:
+                friend CardManager;
+
+                // Values of lazily parsed Card, shared by its copies
+                struct LazyState;
+
+                Card(const client::models::RawSignedModel& rawCard, std::shared_ptr<crypto::Crypto> crypto);
+
+                static std::string generateIdentifier(const VirgilByteArray& contentSnapshot,
+                                                      const std::shared_ptr<crypto::Crypto>& crypto);
+
+                LazyState& parsedContent() const;
+
                 std::string identifier_;
                 std::string identity_;
-                crypto::keys::PublicKey publicKey_;
+                std::shared_ptr<const crypto::keys::PublicKey> publicKey_;
                 std::string previousCardId_;
                 std::shared_ptr<Card> previousCard_;
                 bool isOutdated_;
@@ -170,6 +188,8 @@ namespace virgil {
                 std::time_t createdAt_;
                 std::vector<cards::CardSignature> signatures_;
                 VirgilByteArray contentSnapshot_;
+                bool hasPreviousCardId_;
+                std::shared_ptr<LazyState> lazyState_;
             };
         }
     }
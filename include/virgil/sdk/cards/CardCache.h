@@ -0,0 +1,166 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_CARDCACHE_H
+#define VIRGIL_SDK_CARDCACHE_H
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <virgil/sdk/cards/Card.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace cards {
+            /*!
+             * @brief Thread-safe size-bounded LRU cache of verified Cards
+             * @note Cards are cached by identifier (getCard results) and by identity (searchCards results).
+             * Outdated cards are never cached, caching card drops card it supersedes.
+             */
+            class CardCache {
+            public:
+                /*!
+                 * @brief Constructor
+                 * @param maxEntries maximum number of cached entries (by identifier and by identity in total)
+                 * @param ttl time entry stays valid after it was added
+                 */
+                explicit CardCache(size_t maxEntries = 4096,
+                                   std::chrono::milliseconds ttl = std::chrono::minutes(10));
+
+                /*!
+                 * @brief Returns cached Card with given identifier
+                 * @param cardId std::string with card identifier
+                 * @return std::shared_ptr to Card, nullptr if card is not cached or entry expired
+                 */
+                std::shared_ptr<const Card> findCard(const std::string& cardId);
+
+                /*!
+                 * @brief Returns cached actual Cards with given identity
+                 * @param identity std::string with identity
+                 * @return std::shared_ptr to std::vector with Cards, nullptr if identity is not cached or entry expired
+                 */
+                std::shared_ptr<const std::vector<Card>> findCards(const std::string& identity);
+
+                /*!
+                 * @brief Caches verified card by its identifier
+                 * @param card verified Card
+                 * @note Outdated card is removed from cache instead, previous card is removed as superseded
+                 */
+                void addCard(const Card& card);
+
+                /*!
+                 * @brief Caches verified actual cards of identity and each of them by identifier
+                 * @param identity std::string with identity
+                 * @param cards std::vector with verified actual Cards
+                 */
+                void addCards(const std::string& identity, const std::vector<Card>& cards);
+
+                /*!
+                 * @brief Removes card with given identifier from cache
+                 * @param cardId std::string with card identifier
+                 */
+                void invalidateCard(const std::string& cardId);
+
+                /*!
+                 * @brief Removes cards of given identity from cache
+                 * @param identity std::string with identity
+                 */
+                void invalidateIdentity(const std::string& identity);
+
+                /*!
+                 * @brief Removes all entries
+                 */
+                void clear();
+
+                /*!
+                 * @brief Getter
+                 * @return maximum number of cached entries
+                 */
+                size_t maxEntries() const;
+
+                /*!
+                 * @brief Getter
+                 * @return time entry stays valid after it was added
+                 */
+                std::chrono::milliseconds ttl() const;
+
+                /*!
+                 * @brief Returns number of cached entries
+                 */
+                size_t size() const;
+
+                /*!
+                 * @brief Returns number of lookups served from cache
+                 */
+                size_t hits() const;
+
+                /*!
+                 * @brief Returns number of lookups which were not served from cache
+                 */
+                size_t misses() const;
+
+            private:
+                struct Entry {
+                    std::string key;
+                    std::shared_ptr<const Card> card;
+                    std::shared_ptr<const std::vector<Card>> cards;
+                    std::chrono::steady_clock::time_point expiresAt;
+                };
+
+                const Entry* find(const std::string& key);
+
+                void insert(Entry entry);
+
+                void erase(const std::string& key);
+
+                size_t maxEntries_;
+                std::chrono::milliseconds ttl_;
+                mutable std::mutex mutex_;
+                std::list<Entry> entries_;
+                std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+                size_t hits_;
+                size_t misses_;
+            };
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_CARDCACHE_H
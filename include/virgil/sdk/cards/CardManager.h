@@ -40,9 +40,11 @@
 #include <functional>
 #include <virgil/sdk/jwt/interfaces/AccessTokenProviderInterface.h>
 #include <virgil/sdk/cards/ModelSigner.h>
+#include <virgil/sdk/cards/CardCache.h>
 #include <virgil/sdk/crypto/Crypto.h>
 #include <virgil/sdk/cards/verification/CardVerifierInterface.h>
 #include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 
 using virgil::sdk::client::models::RawSignedModel;
 using virgil::sdk::client::models::GetCardResponse;
@@ -64,13 +66,18 @@ namespace virgil {
                  * @param signCallback std::function called to perform additional signatures for card before publishing
                  * @param cardClient CardClientInterface implementation used for performing queries
                  * @param retryOnUnauthorized will automatically perform second query with forceReload = true AccessToken if true
+                 * @param executor executors::ExecutorInterface implementation used to run asynchronous operations
+                 * @param cardCache CardCache for verified cards, caching is disabled if nullptr
                  */
                 CardManager(std::shared_ptr<crypto::Crypto> crypto,
                             std::shared_ptr<jwt::interfaces::AccessTokenProviderInterface> accessTokenProvider,
                             std::shared_ptr<verification::CardVerifierInterface> cardVerifier,
                             std::function<std::future<RawSignedModel>(RawSignedModel)> signCallback = nullptr,
                             std::shared_ptr<client::CardClientInterface> cardClient = std::make_shared<client::CardClient>(),
-                            bool retryOnUnauthorized = true);
+                            bool retryOnUnauthorized = true,
+                            std::shared_ptr<executors::ExecutorInterface> executor
+                            = executors::ThreadPoolExecutor::defaultExecutor(),
+                            std::shared_ptr<CardCache> cardCache = nullptr);
 
                 /*!
                  * @brief Generates self signed RawSignedModel
@@ -118,6 +125,21 @@ namespace virgil {
                  */
                 Card parseCard(const RawSignedModel& model) const;
 
+                /*!
+                 * @brief Imports Card from RawSignedModel, deferring parsing until values are accessed
+                 * @details Identifier is computed on first Card::identifier() call, content snapshot is parsed
+                 * on first identity(), version(), createdAt(), previousCardId() or publicKey() call,
+                 * Public Key is imported on first Card::publicKey() call and signatures extra fields
+                 * are parsed on first CardSignature::extraFields() call.
+                 * Useful for bulk imports, where most Cards are filtered out by identifier or identity
+                 * @param model RawSignedModel instance to import
+                 * @param crypto Crypto instance
+                 * @return imported Card
+                 * @note Copies of returned Card share parsed values. Getters are thread-safe
+                 * @note Parsing errors are thrown from the getter, which triggered parsing
+                 */
+                static Card parseCardLazily(const RawSignedModel& model, const std::shared_ptr<crypto::Crypto>& crypto);
+
                 /*!
                  * @brief Asynchronously creates Virgil Card instance on the Virgil Cards Service and associates it with unique identifier
                  * Also makes the Card accessible for search/get queries from other users
@@ -151,6 +173,14 @@ namespace virgil {
                  */
                 std::future<Card> getCard(const std::string& cardId) const;
 
+                /*!
+                 * @brief Asynchronously returns Cards with given identifiers using single token
+                 * @note Queries are sent concurrently and cards are verified in parallel
+                 * @param cardIds identifiers of cards to return
+                 * @return std::future with std::vector of found and verified Cards in the same order as cardIds
+                 */
+                std::future<std::vector<Card>> getCards(const std::vector<std::string>& cardIds) const;
+
                 /*!
                  * @brief Asynchronously performs search of Virgil Cards using identity on the Virgil Cards Service
                  * @param identity identity of Card to search
@@ -158,6 +188,15 @@ namespace virgil {
                  */
                 std::future<std::vector<Card>> searchCards(const std::string& identity) const;
 
+                /*!
+                 * @brief Asynchronously performs search of Virgil Cards using identities on the Virgil Cards Service
+                 * @note Uses single token, identities are searched in batched requests
+                 * @param identities identities of Cards to search
+                 * @return std::future with std::unordered_map with found and verified Cards for each identity
+                 */
+                std::future<std::unordered_map<std::string, std::vector<Card>>> searchCards(
+                        const std::vector<std::string>& identities) const;
+
                 /*!
                  * @brief Imports and verifies Card from base64 encoded std::string
                  * @param base64 base64 encoded std::string with Card
@@ -242,6 +281,18 @@ namespace virgil {
                  */
                 bool retryOnUnauthorized() const;
 
+                /*!
+                 * @brief Getter
+                 * @return std::shared_ptr to executors::ExecutorInterface implementation used to run asynchronous operations
+                 */
+                const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
+                /*!
+                 * @brief Getter
+                 * @return std::shared_ptr to CardCache with verified cards, nullptr if caching is disabled
+                 */
+                const std::shared_ptr<CardCache>& cardCache() const;
+
             private:
                 std::shared_ptr<crypto::Crypto> crypto_;
                 ModelSigner modelSigner_;
@@ -250,11 +301,15 @@ namespace virgil {
                 std::shared_ptr<client::CardClientInterface> cardClient_;
                 std::function<std::future<RawSignedModel>(RawSignedModel)> signCallback_;
                 bool retryOnUnauthorized_;
+                std::shared_ptr<executors::ExecutorInterface> executor_;
+                std::shared_ptr<CardCache> cardCache_;
 
                 template<typename T> T tryQuery(const jwt::TokenContext &tokenContext, const std::string& token,
                                                 std::function<std::future<T>(const std::string& token)> query) const;
 
                 bool validateSelfSignatures(const RawSignedModel& rawCard1, const RawSignedModel& rawCard2) const;
+
+                std::vector<Card> linkCards(std::vector<Card> cards) const;
             };
         }
     }
@@ -37,6 +37,8 @@
 #ifndef VIRGIL_SDK_CARDSIGNATURE_H
 #define VIRGIL_SDK_CARDSIGNATURE_H
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <virgil/sdk/Common.h>
@@ -44,6 +46,8 @@
 namespace virgil {
     namespace sdk {
         namespace cards {
+            class Card;
+
             /*!
              * @brief Class representing Virgil Card Signature
              */
@@ -85,14 +89,26 @@ namespace virgil {
                 /*!
                  * @brief Getter
                  * @return std::unordered_map with additional data
+                 * @note For signatures of lazily parsed Cards map is parsed from snapshot on first access
+                 * @throws std::exception if snapshot is not a valid json object
                  */
                 const std::unordered_map<std::string, std::string>& extraFields() const;
 
             private:
+                friend Card;
+
+                struct LazyExtraFields {
+                    std::once_flag once;
+                    std::unordered_map<std::string, std::string> extraFields;
+                };
+
+                CardSignature(std::string signer, VirgilByteArray signature, VirgilByteArray snapshot);
+
                 std::string signer_;
                 VirgilByteArray signature_;
                 VirgilByteArray snapshot_;
                 std::unordered_map<std::string, std::string> extraFields_;
+                std::shared_ptr<LazyExtraFields> lazyExtraFields_;
             };
         }
     }
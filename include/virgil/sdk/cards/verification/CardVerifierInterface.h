@@ -37,6 +37,7 @@
 #ifndef VIRGIL_SDK_CARDVERIFIERINTERFACE_H
 #define VIRGIL_SDK_CARDVERIFIERINTERFACE_H
 
+#include <vector>
 #include <virgil/sdk/cards/Card.h>
 
 namespace virgil {
@@ -55,6 +56,21 @@ namespace virgil {
                      */
                     virtual bool verifyCard(const Card &card) const = 0;
 
+                    /*!
+                     * @brief Verifies Card instances
+                     * @note Default implementation verifies cards one by one
+                     * @param cards std::vector with Cards to verify
+                     * @return true if all Cards verified, false otherwise
+                     */
+                    virtual bool verifyCards(const std::vector<Card> &cards) const {
+                        for (const auto& card : cards) {
+                            if (!verifyCard(card))
+                                return false;
+                        }
+
+                        return true;
+                    }
+
                     /*!
                      * @brief Virtual destructor
                      */
@@ -39,7 +39,10 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <functional>
 #include <virgil/sdk/crypto/Crypto.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 #include <virgil/sdk/cards/verification/Whitelist.h>
 #include <virgil/sdk/cards/verification/CardVerifierInterface.h>
 
@@ -59,13 +62,18 @@ namespace virgil {
                      * @param whitelists std::vector with collections of verifiers
                      * @param verifySelfSignature VirgilCardVerifier will verify self signature if true
                      * @param verifyVirgilSignature VirgilCardVerifier will verify Virgil Cards Service signature if true
+                     * @param verifyConcurrently VirgilCardVerifier will verify required signatures of Card concurrently if true
+                     * @param executor executors::ExecutorInterface implementation used for concurrent verification
                      * @note VirgilCardVerifier verifies Card if it contains signature from AT LEAST
                      * one verifier from EACH Whitelist
                      */
                     VirgilCardVerifier(std::shared_ptr<crypto::Crypto> crypto,
                                        std::vector<Whitelist> whitelists = std::vector<Whitelist>(),
                                        bool verifySelfSignature = true,
-                                       bool verifyVirgilSignature = true);
+                                       bool verifyVirgilSignature = true,
+                                       bool verifyConcurrently = false,
+                                       std::shared_ptr<executors::ExecutorInterface> executor
+                                       = executors::ThreadPoolExecutor::defaultExecutor());
 
                     /*!
                      * @brief Signer identifier for self signatures
@@ -112,6 +120,18 @@ namespace virgil {
                      */
                     bool verifyVirgilSignature() const;
 
+                    /*!
+                     * @brief Getter
+                     * @return true if VirgilCardVerifier verifies required signatures of Card concurrently, false otherwise
+                     */
+                    bool verifyConcurrently() const;
+
+                    /*!
+                     * @brief Getter
+                     * @return executors::ExecutorInterface implementation used for concurrent verification
+                     */
+                    const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
                     /*!
                      * @brief Verifies Card instance using set rules
                      * @param card Card to verify
@@ -121,18 +141,38 @@ namespace virgil {
                      */
                     bool verifyCard(const Card &card) const override;
 
+                    /*!
+                     * @brief Verifies Card instances concurrently using set rules
+                     * @param cards std::vector with Cards to verify
+                     * @return true if all Cards verified, false otherwise
+                     * @note Signatures of all Cards are checked with single Crypto::verifyBatch call
+                     */
+                    bool verifyCards(const std::vector<Card> &cards) const override;
+
                 private:
                     bool verifySelfSignature_;
                     bool verifyVirgilSignature_;
                     crypto::keys::PublicKey virgilPublicKey_;
                     std::shared_ptr<crypto::Crypto> crypto_;
                     std::vector<Whitelist> whitelists_;
+                    std::vector<std::unordered_multimap<std::string, crypto::keys::PublicKey>> whitelistsPublicKeys_;
+                    bool verifyConcurrently_;
+                    std::shared_ptr<executors::ExecutorInterface> executor_;
+
+                    static std::vector<std::unordered_multimap<std::string, crypto::keys::PublicKey>> importWhitelists(
+                            const std::shared_ptr<crypto::Crypto>& crypto, const std::vector<Whitelist>& whitelists);
 
                     bool verifySelf(const Card &card) const;
                     bool verifyVirgil(const Card &card) const;
                     bool verifyWhitelists(const Card &card) const;
+                    bool verifyWhitelist(const Card &card,
+                                         const std::unordered_multimap<std::string, crypto::keys::PublicKey>& publicKeys) const;
+                    bool verifySequentially(const Card &card) const;
+                    bool verifyAll(const std::vector<std::function<bool()>>& checks) const;
                     bool verify(const Card &card, const std::string& signer,
                                 const crypto::keys::PublicKey& signerPublicKey) const;
+
+                    static VirgilByteArray snapshot(const Card &card, const CardSignature &signature);
                 };
             }
         }
@@ -37,8 +37,16 @@
 #ifndef VIRGIL_SDK_CARDCLIENT_H
 #define VIRGIL_SDK_CARDCLIENT_H
 
+#include <functional>
+#include <memory>
+#include <virgil/sdk/client/HedgingPolicy.h>
+#include <virgil/sdk/client/RetryPolicy.h>
+#include <virgil/sdk/client/networking/AsyncConnection.h>
+#include <virgil/sdk/client/networking/Connection.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
 #include <virgil/sdk/client/networking/Response.h>
 #include <virgil/sdk/client/networking/errors/Error.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 #include <virgil/sdk/client/CardClientInterface.h>
 
 namespace virgil {
@@ -52,20 +60,66 @@ namespace virgil {
                 /*!
                  * @brief Constructor
                  * @param serviceUrl std::string with URL of service client will use
+                 * @param connection networking::Connection used to send requests,
+                 * by default requests reuse keep-alive connections from process-wide networking::ConnectionPool,
+                 * so clients of the same service share connections,
+                 * networking::Http2Connection multiplexes concurrent requests over single HTTP/2 connection,
+                 * networking::EventLoopConnection sends requests without occupying thread per request
+                 * @param executor executors::ExecutorInterface implementation used to run requests,
+                 * for networking::AsyncConnection implementations it is used only to parse responses
+                 * @param retryPolicy RetryPolicy used to resend requests failed because of temporary errors,
+                 * requests are sent once if nullptr
+                 * @param hedgingPolicy HedgingPolicy used to hedge getCard and searchCards requests,
+                 * requests are not hedged if nullptr
                  */
-                CardClient(std::string serviceUrl = "https://api.virgilsecurity.com");
+                CardClient(std::string serviceUrl = "https://api.virgilsecurity.com",
+                           std::shared_ptr<networking::Connection> connection
+                                   = networking::KeepAliveConnection::defaultConnection(),
+                           std::shared_ptr<executors::ExecutorInterface> executor
+                                   = executors::ThreadPoolExecutor::defaultExecutor(),
+                           std::shared_ptr<RetryPolicy> retryPolicy = std::make_shared<RetryPolicy>(),
+                           std::shared_ptr<HedgingPolicy> hedgingPolicy = nullptr);
 
                 /*!
                  * @brief HTTP header key for getCard response that marks outdated cards
                  */
                 static const std::string xVirgilIsSuperseededKey;
 
+                /*!
+                 * @brief Maximum number of identities sent in single search request
+                 */
+                static const size_t maxIdentitiesPerSearch;
+
                 /*!
                  * @brief Getter
                  * @return std::string with URL of service client use
                  */
                 const std::string& serviceUrl() const;
 
+                /*!
+                 * @brief Getter
+                 * @return networking::Connection client use to send requests
+                 */
+                const std::shared_ptr<networking::Connection>& connection() const;
+
+                /*!
+                 * @brief Getter
+                 * @return executors::ExecutorInterface implementation client use to run requests
+                 */
+                const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
+                /*!
+                 * @brief Getter
+                 * @return RetryPolicy client use to resend failed requests, nullptr if requests are not resent
+                 */
+                const std::shared_ptr<RetryPolicy>& retryPolicy() const;
+
+                /*!
+                 * @brief Getter
+                 * @return HedgingPolicy client use to hedge requests, nullptr if requests are not hedged
+                 */
+                const std::shared_ptr<HedgingPolicy>& hedgingPolicy() const;
+
                 /*!
                  * @brief Creates Virgil Card instance on the Virgil Cards Service.
                  * Also makes the Card accessible for search/get queries from other users.
@@ -95,10 +149,53 @@ namespace virgil {
                 std::future<std::vector<models::RawSignedModel>> searchCards(const std::string &identity,
                                                                              const std::string& token) const override;
 
+                /*!
+                 * @brief Performs search of Virgil Cards using given identities on the Virgil Cards Service
+                 * @note Identities are split into chunks of maxIdentitiesPerSearch, chunks are sent concurrently
+                 * @param identities std::vector with identities of cards to search
+                 * @param token std::string with AccessTokenInterface implementation
+                 * @return std::future with std::vector with RawSignedModels of matched Virgil Cards
+                 */
+                std::future<std::vector<models::RawSignedModel>> searchCards(const std::vector<std::string> &identities,
+                                                                             const std::string& token) const override;
+
+                /*!
+                 * @brief Returns GetCardResponses for given card IDs, queries are sent concurrently
+                 * @param cardIds std::vector with unique Virgil Card identifiers
+                 * @param token std::string with AccessTokenInterface implementation
+                 * @return std::future with std::vector with GetCardResponses in the same order as cardIds
+                 */
+                std::future<std::vector<models::GetCardResponse>> getCards(const std::vector<std::string> &cardIds,
+                                                                           const std::string& token) const override;
+
             private:
                 networking::errors::Error parseError(const client::networking::Response &response) const;
 
+                networking::Response send(const networking::Request &request) const;
+
+                void sendAsync(const networking::Request &request, networking::AsyncConnection::Callback callback) const;
+
+                // Doesn't use client, so request may be sent after client is destroyed
+                static void sendAsync(const std::shared_ptr<networking::Connection> &connection,
+                                      const std::shared_ptr<networking::AsyncConnection> &asyncConnection,
+                                      const std::shared_ptr<RetryPolicy> &retryPolicy,
+                                      const std::shared_ptr<executors::ExecutorInterface> &executor,
+                                      const networking::Request &request,
+                                      networking::AsyncConnection::Callback callback);
+
+                void sendHedged(const networking::Request &request, networking::AsyncConnection::Callback callback) const;
+
+                template<typename T>
+                std::future<T> query(const networking::Request &request,
+                                     std::function<T(const networking::Response &)> handleResponse,
+                                     bool hedged = false) const;
+
                 std::string serviceUrl_;
+                std::shared_ptr<networking::Connection> connection_;
+                std::shared_ptr<executors::ExecutorInterface> executor_;
+                std::shared_ptr<networking::AsyncConnection> asyncConnection_;
+                std::shared_ptr<RetryPolicy> retryPolicy_;
+                std::shared_ptr<HedgingPolicy> hedgingPolicy_;
             };
         }
     }
@@ -39,6 +39,7 @@
 
 #include <string>
 #include <future>
+#include <memory>
 #include <vector>
 #include <virgil/sdk/client/models/RawSignedModel.h>
 #include <virgil/sdk/client/models/GetCardResponse.h>
@@ -80,6 +81,52 @@ namespace virgil {
                 virtual std::future<std::vector<models::RawSignedModel>> searchCards(const std::string &identity,
                                                                                      const std::string& token) const = 0;
 
+                /*!
+                 * @brief Performs search of Virgil Cards using given identities on the Virgil Cards Service
+                 * @note Default implementation sends searchCards query for each identity concurrently
+                 * @param identities std::vector with identities of cards to search
+                 * @param token std::string with AccessTokenInterface implementation
+                 * @return std::future with std::vector with RawSignedModels of matched Virgil Cards
+                 */
+                virtual std::future<std::vector<models::RawSignedModel>> searchCards(const std::vector<std::string> &identities,
+                                                                                     const std::string& token) const {
+                    auto futures = std::make_shared<std::vector<std::future<std::vector<models::RawSignedModel>>>>();
+                    for (const auto& identity : identities)
+                        futures->push_back(searchCards(identity, token));
+
+                    return std::async(std::launch::deferred, [futures] {
+                        std::vector<models::RawSignedModel> rawCards;
+                        for (auto& future : *futures) {
+                            auto identityRawCards = future.get();
+                            rawCards.insert(rawCards.end(), identityRawCards.begin(), identityRawCards.end());
+                        }
+
+                        return rawCards;
+                    });
+                }
+
+                /*!
+                 * @brief Returns GetCardResponses for given card IDs using single token
+                 * @note Default implementation sends getCard queries concurrently
+                 * @param cardIds std::vector with unique Virgil Card identifiers
+                 * @param token std::string with AccessTokenInterface implementation
+                 * @return std::future with std::vector with GetCardResponses in the same order as cardIds
+                 */
+                virtual std::future<std::vector<models::GetCardResponse>> getCards(const std::vector<std::string> &cardIds,
+                                                                                   const std::string& token) const {
+                    auto futures = std::make_shared<std::vector<std::future<models::GetCardResponse>>>();
+                    for (const auto& cardId : cardIds)
+                        futures->push_back(getCard(cardId, token));
+
+                    return std::async(std::launch::deferred, [futures] {
+                        std::vector<models::GetCardResponse> responses;
+                        for (auto& future : *futures)
+                            responses.push_back(future.get());
+
+                        return responses;
+                    });
+                }
+
                 /*!
                  * @brief Virtual destructor
                  */
@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HEDGINGPOLICY_H
+#define VIRGIL_SDK_HEDGINGPOLICY_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <virgil/sdk/executors/DelayedTaskScheduler.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            /*!
+             * @brief Configures hedged requests of CardClient
+             * @note If response is not received within hedge delay, the same request is sent once more,
+             * the first successful response is used and the other request is cancelled.
+             * Each request adds maxHedgeRatio of hedge to hedge budget, so hedges can't exceed
+             * given part of traffic. Hedge delays are waited on scheduler owned by policy,
+             * so hedges which are not sent yet are dropped together with policy.
+             * @note Instance is thread-safe and is expected to be shared by all requests of the client
+             */
+            class HedgingPolicy {
+            public:
+                /*!
+                 * @brief Constructor
+                 * @param maxHedgeRatio maximum part of requests, which can be hedged
+                 * @param hedgeDelay time to wait for response before sending hedge,
+                 * zero means 95th percentile of recently observed latencies,
+                 * requests are not hedged until enough latencies are observed in this case
+                 */
+                explicit HedgingPolicy(double maxHedgeRatio = 0.05,
+                                       std::chrono::milliseconds hedgeDelay = std::chrono::milliseconds(0));
+
+                HedgingPolicy(const HedgingPolicy&) = delete;
+
+                HedgingPolicy& operator=(const HedgingPolicy&) = delete;
+
+                /*!
+                 * @brief Registers new request, which adds maxHedgeRatio to hedge budget
+                 */
+                void requestStarted();
+
+                /*!
+                 * @brief Returns time to wait for response before sending hedge
+                 * @param delay receives configured hedge delay or 95th percentile of observed latencies
+                 * @return false if delay is not known yet
+                 */
+                bool hedgeDelay(std::chrono::milliseconds &delay) const;
+
+                /*!
+                 * @brief Takes hedge from budget
+                 * @return true if hedge can be sent
+                 */
+                bool tryHedge();
+
+                /*!
+                 * @brief Registers latency of completed request
+                 * @param latency time passed from request start till successful response
+                 * @param hedgeWon true if response of hedge was received first
+                 */
+                void requestCompleted(std::chrono::milliseconds latency, bool hedgeWon);
+
+                /*!
+                 * @brief Runs task on timer thread after given delay
+                 * @param delay time to wait before running task
+                 * @param task std::function to run, it should not block
+                 */
+                void schedule(std::chrono::milliseconds delay, std::function<void()> task);
+
+                /*!
+                 * @brief Getter
+                 * @return maximum part of requests, which can be hedged
+                 */
+                double maxHedgeRatio() const;
+
+                /*!
+                 * @brief Getter
+                 * @return number of hedges sent since creation
+                 */
+                size_t hedges() const;
+
+                /*!
+                 * @brief Getter
+                 * @return number of requests completed by hedge response
+                 */
+                size_t wonHedges() const;
+
+            private:
+                double maxHedgeRatio_;
+                std::chrono::milliseconds hedgeDelay_;
+
+                mutable std::mutex mutex_;
+                double hedgeBudget_;
+                std::vector<std::chrono::milliseconds> latencies_;
+                size_t nextLatency_;
+                std::atomic<size_t> hedges_;
+                std::atomic<size_t> wonHedges_;
+
+                // Declared last, so that it's destroyed, and scheduled tasks are dropped, before other members
+                executors::DelayedTaskScheduler scheduler_;
+            };
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_HEDGINGPOLICY_H
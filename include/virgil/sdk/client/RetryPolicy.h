@@ -0,0 +1,185 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_RETRYPOLICY_H
+#define VIRGIL_SDK_RETRYPOLICY_H
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/networking/Response.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            /*!
+             * @brief Decides whether failed CardClient requests are resent and how long to wait before that.
+             * @note Delays grow exponentially with random jitter. Each request earns retryBudgetRatio of retry,
+             * so retries can't multiply load on service, which is already failing.
+             * Publish requests are not idempotent, so they are resent only if they didn't reach the server.
+             * @note Instance is thread-safe and is expected to be shared by all requests of the client
+             */
+            class RetryPolicy {
+            public:
+                /*!
+                 * @brief Constructor
+                 * @param maxAttempts maximum number of attempts per request, including first one
+                 * @param attemptTimeout maximum time single attempt is allowed to take
+                 * @param connectTimeout maximum time connection phase of single attempt is allowed to take
+                 * @param deadline maximum time all attempts of request together with delays are allowed to take
+                 * @param initialBackoff delay before first retry, doubled with each next retry
+                 * @param maxBackoff maximum delay between attempts
+                 * @param retryBudgetRatio part of retry each request adds to retry budget
+                 * @param retryBudgetBurst maximum number of retries budget can accumulate
+                 * @param random source of backoff jitter returning numbers uniformly distributed in [0, 1],
+                 * randomly seeded generator is used if empty
+                 */
+                RetryPolicy(size_t maxAttempts = 3,
+                            std::chrono::milliseconds attemptTimeout = std::chrono::milliseconds(7000),
+                            std::chrono::milliseconds connectTimeout = std::chrono::milliseconds(3000),
+                            std::chrono::milliseconds deadline = std::chrono::milliseconds(20000),
+                            std::chrono::milliseconds initialBackoff = std::chrono::milliseconds(100),
+                            std::chrono::milliseconds maxBackoff = std::chrono::milliseconds(2000),
+                            double retryBudgetRatio = 0.2,
+                            size_t retryBudgetBurst = 10,
+                            std::function<double()> random = nullptr);
+
+                /*!
+                 * @brief Applies timeouts of next attempt to request
+                 * @param request networking::Request to be sent
+                 * @param elapsed time passed since first attempt of request
+                 * @return networking::Request with timeouts, which don't exceed deadline
+                 */
+                networking::Request attemptRequest(const networking::Request &request,
+                                                   std::chrono::milliseconds elapsed) const;
+
+                /*!
+                 * @brief Registers new request, which adds retryBudgetRatio to retry budget
+                 */
+                void requestStarted();
+
+                /*!
+                 * @brief Decides whether request should be sent again
+                 * @param request sent networking::Request
+                 * @param error exception thrown by attempt, nullptr if response was received
+                 * @param response received networking::Response, ignored if error is not nullptr
+                 * @param attempt number of finished attempts
+                 * @param elapsed time passed since first attempt of request
+                 * @param delay receives time to wait before next attempt
+                 * @return true if request should be sent again, retry is taken from budget in this case,
+                 * cancelled requests are never sent again
+                 */
+                bool shouldRetry(const networking::Request &request, std::exception_ptr error,
+                                 const networking::Response &response, size_t attempt,
+                                 std::chrono::milliseconds elapsed, std::chrono::milliseconds &delay);
+
+                /*!
+                 * @brief Checks whether request can be safely sent more than once
+                 * @param request networking::Request to check
+                 * @return true if repeated request has the same effect as single one
+                 */
+                static bool isIdempotent(const networking::Request &request);
+
+                /*!
+                 * @brief Checks whether response reports temporary failure of service
+                 * @param response received networking::Response
+                 * @return true for 429, 500, 502, 503 and 504 status codes
+                 */
+                static bool isRetryable(const networking::Response &response);
+
+                /*!
+                 * @brief Getter
+                 * @return maximum number of attempts per request
+                 */
+                size_t maxAttempts() const;
+
+                /*!
+                 * @brief Getter
+                 * @return maximum time single attempt is allowed to take
+                 */
+                std::chrono::milliseconds attemptTimeout() const;
+
+                /*!
+                 * @brief Getter
+                 * @return maximum time connection phase of single attempt is allowed to take
+                 */
+                std::chrono::milliseconds connectTimeout() const;
+
+                /*!
+                 * @brief Getter
+                 * @return maximum time all attempts of request are allowed to take
+                 */
+                std::chrono::milliseconds deadline() const;
+
+                /*!
+                 * @brief Getter
+                 * @return number of retries performed since creation
+                 */
+                size_t retries() const;
+
+                /*!
+                 * @brief Getter
+                 * @return number of retries rejected because retry budget was exhausted
+                 */
+                size_t rejectedRetries() const;
+
+            private:
+                std::chrono::milliseconds backoff(size_t attempt);
+
+                size_t maxAttempts_;
+                std::chrono::milliseconds attemptTimeout_;
+                std::chrono::milliseconds connectTimeout_;
+                std::chrono::milliseconds deadline_;
+                std::chrono::milliseconds initialBackoff_;
+                std::chrono::milliseconds maxBackoff_;
+                double retryBudgetRatio_;
+                double retryBudgetBurst_;
+
+                std::mutex mutex_;
+                double retryBudget_;
+                std::function<double()> random_;
+                std::atomic<size_t> retries_;
+                std::atomic<size_t> rejectedRetries_;
+            };
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_RETRYPOLICY_H
@@ -92,13 +92,13 @@ namespace virgil {
                      * @brief Getter
                      * @return std::vector with RawSignatures of Card
                      */
-                    const std::vector<RawSignature> signatures() const;
+                    const std::vector<RawSignature>& signatures() const;
 
                     /*!
                      * @brief Adds new signature
                      * @param newSignature RawSignature to add
                      */
-                    void addSignature(const RawSignature &newSignature);
+                    void addSignature(RawSignature newSignature);
 
                 private:
                     VirgilByteArray contentSnapshot_;
@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_ASYNC_CONNECTION_H
+#define VIRGIL_SDK_HTTP_ASYNC_CONNECTION_H
+
+#include <exception>
+#include <functional>
+
+#include <virgil/sdk/client/networking/Connection.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Base class for connections, which send requests without blocking calling thread.
+                 *
+                 * CardClient detects such connections and completes its futures from completion callbacks,
+                 * so outstanding requests don't occupy executor threads.
+                 * @note This class belongs to the **private** API
+                 */
+                class AsyncConnection : public Connection {
+                public:
+                    /**
+                     * @brief Completion callback, receives either response or error of the request.
+                     */
+                    using Callback = std::function<void(std::exception_ptr, Response)>;
+
+                    /**
+                     * @brief Send asynchronous request.
+                     * @param request - request to be send.
+                     * @param callback - invoked once response is received or request failed,
+                     *                   may be invoked on internal thread, so it should not block.
+                     */
+                    virtual void sendAsync(const Request &request, Callback callback) = 0;
+
+                    /**
+                     * @brief Send synchronous request, waits for sendAsync() completion.
+                     * @param request - request to be send.
+                     * @throw std::logic_error - if given parameters are inconsistent.
+                     * @throw std::runtime_error - if error was occurred when send request.
+                     */
+                    Response send(const Request &request) override;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_ASYNC_CONNECTION_H */
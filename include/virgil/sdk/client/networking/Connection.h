@@ -50,6 +50,8 @@ namespace virgil {
                  */
                 class Connection {
                 public:
+                    virtual ~Connection() = default;
+
                     /**
                      * @brief Send synchronous request.
                      * @param request - request to be send.
@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_CONNECTION_POOL_H
+#define VIRGIL_SDK_HTTP_CONNECTION_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/networking/Response.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Thread-safe pool of keep-alive HTTP connections grouped by base address.
+                 *
+                 * Each pooled handle keeps its TCP (and TLS) session open between requests, so consecutive
+                 * requests to the same base address skip the handshake.
+                 * @note This class belongs to the **private** API
+                 */
+                class ConnectionPool {
+                public:
+                    /**
+                     * @brief Opaque pooled connection handle.
+                     */
+                    class Handle;
+
+                    /**
+                     * @brief Constructor.
+                     * @param maxIdleConnections maximum number of idle connections kept per base address
+                     * @param idleTimeout idle connections older than this value are closed instead of being reused
+                     */
+                    explicit ConnectionPool(size_t maxIdleConnections = 8,
+                                            std::chrono::milliseconds idleTimeout = std::chrono::seconds(60));
+
+                    /**
+                     * @brief Closes all idle connections.
+                     */
+                    ~ConnectionPool();
+
+                    ConnectionPool(const ConnectionPool&) = delete;
+
+                    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+                    /**
+                     * @brief Send synchronous request using pooled connection to the request's base address.
+                     * @param request - request to be send.
+                     * @throw std::logic_error - if given parameters are inconsistent.
+                     * @throw std::runtime_error - if error was occurred when send request.
+                     */
+                    Response send(const Request &request);
+
+                    /**
+                     * @brief Closes all idle connections.
+                     */
+                    void clear();
+
+                    /**
+                     * @brief Getter.
+                     * @return maximum number of idle connections kept per base address
+                     */
+                    size_t maxIdleConnections() const;
+
+                    /**
+                     * @brief Getter.
+                     * @return time after which idle connection is closed
+                     */
+                    std::chrono::milliseconds idleTimeout() const;
+
+                    /**
+                     * @brief Returns number of currently idle connections for all base addresses.
+                     */
+                    size_t idleConnections() const;
+
+                    /**
+                     * @brief Returns number of requests which were sent over already established connection.
+                     */
+                    size_t reusedConnections() const;
+
+                    /**
+                     * @brief Returns number of requests which had to establish new connection.
+                     */
+                    size_t newConnections() const;
+
+                private:
+                    struct IdleHandle {
+                        std::unique_ptr<Handle> handle;
+                        std::chrono::steady_clock::time_point releasedAt;
+                    };
+
+                    std::unique_ptr<Handle> acquire(const std::string &baseAddress);
+
+                    void release(const std::string &baseAddress, std::unique_ptr<Handle> handle);
+
+                    size_t maxIdleConnections_;
+                    std::chrono::milliseconds idleTimeout_;
+                    mutable std::mutex mutex_;
+                    std::unordered_map<std::string, std::deque<IdleHandle>> idle_;
+                    std::atomic<size_t> reusedConnections_;
+                    std::atomic<size_t> newConnections_;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_CONNECTION_POOL_H */
@@ -0,0 +1,130 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_CURL_MULTI_LOOP_H
+#define VIRGIL_SDK_HTTP_CURL_MULTI_LOOP_H
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/networking/Response.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Thread driving libcurl multi interface, which performs many transfers concurrently.
+                 *
+                 * Connections are cached by the multi handle and reused by subsequent transfers to the same host.
+                 * @note This class belongs to the **private** API
+                 */
+                class CurlMultiLoop {
+                public:
+                    /**
+                     * @brief Completion callback, receives either response or error of the transfer.
+                     * @note Callback is invoked on the loop thread, so it should not block.
+                     */
+                    using Callback = std::function<void(std::exception_ptr, Response)>;
+
+                    /**
+                     * @brief Starts loop thread.
+                     * @param http2 - if true requests are sent over HTTP/2 and multiplexed over shared connections,
+                     *                cleartext addresses use HTTP/2 with prior knowledge (h2c).
+                     * @param maxConcurrentStreams - maximum number of concurrent HTTP/2 streams per connection.
+                     * @param maxConnectionsPerHost - maximum number of connections per host, 0 means unlimited.
+                     */
+                    CurlMultiLoop(bool http2, size_t maxConcurrentStreams, size_t maxConnectionsPerHost);
+
+                    /**
+                     * @brief Stops loop thread, unfinished transfers are completed with std::runtime_error.
+                     */
+                    ~CurlMultiLoop();
+
+                    CurlMultiLoop(const CurlMultiLoop&) = delete;
+
+                    CurlMultiLoop& operator=(const CurlMultiLoop&) = delete;
+
+                    /**
+                     * @brief Queues request, which is sent by the loop thread.
+                     * @param request - request to be send.
+                     * @param callback - invoked once transfer is finished.
+                     */
+                    void send(const Request &request, Callback callback);
+
+                    /**
+                     * @brief Returns number of requests which were sent over already established connection.
+                     */
+                    size_t reusedConnections() const;
+
+                    /**
+                     * @brief Returns number of requests which had to establish new connection.
+                     */
+                    size_t newConnections() const;
+
+                private:
+                    struct Transfer;
+
+                    void run();
+
+                    void start(std::unique_ptr<Transfer> transfer);
+
+                    void finish(void *curl, int result);
+
+                    void *multi_;
+                    bool http2_;
+                    std::mutex mutex_;
+                    bool stopped_;
+                    std::deque<std::unique_ptr<Transfer>> queued_;
+                    // Accessed by loop thread only
+                    std::unordered_map<void *, std::unique_ptr<Transfer>> active_;
+                    std::atomic<size_t> reusedConnections_;
+                    std::atomic<size_t> newConnections_;
+                    std::thread thread_;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_CURL_MULTI_LOOP_H */
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_CURL_REQUEST_H
+#define VIRGIL_SDK_HTTP_CURL_REQUEST_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/networking/Response.h>
+
+struct curl_slist;
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Configures libcurl easy handle for sending single request and collects its response.
+                 *
+                 * Instance owns buffers referenced by the handle, so it should live until transfer is finished.
+                 * @note This class belongs to the **private** API
+                 */
+                class CurlRequest {
+                public:
+                    /**
+                     * @brief Sets options of given handle for sending given request.
+                     * @param curl - libcurl easy handle (CURL *), options are expected to be reset.
+                     * @param request - request to be send.
+                     * @throw std::logic_error - if given parameters are inconsistent.
+                     */
+                    CurlRequest(void *curl, const Request &request);
+
+                    /**
+                     * @brief Frees request headers.
+                     */
+                    ~CurlRequest();
+
+                    CurlRequest(const CurlRequest&) = delete;
+
+                    CurlRequest& operator=(const CurlRequest&) = delete;
+
+                    /**
+                     * @brief Initializes libcurl global state once per process.
+                     */
+                    static void globalInit();
+
+                    /**
+                     * @brief Checks result of finished transfer.
+                     * @param result - CURLcode of finished transfer.
+                     * @throw errors::TransportError - if transfer failed.
+                     */
+                    void checkResult(int result) const;
+
+                    /**
+                     * @brief Builds response from data received by finished transfer.
+                     * @param result - CURLcode of finished transfer.
+                     * @throw errors::TransportError - if transfer failed.
+                     * @throw std::runtime_error - if response has unknown status code.
+                     */
+                    Response response(int result) const;
+
+                private:
+                    void *curl_;
+                    std::string uri_;
+                    std::string body_;
+                    curl_slist *headerList_;
+                    std::shared_ptr<const std::atomic<bool>> cancellationFlag_;
+                    std::string responseBody_;
+                    Response::Header responseHeader_;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_CURL_REQUEST_H */
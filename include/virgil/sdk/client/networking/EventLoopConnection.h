@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_EVENT_LOOP_CONNECTION_H
+#define VIRGIL_SDK_HTTP_EVENT_LOOP_CONNECTION_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <virgil/sdk/client/networking/AsyncConnection.h>
+#include <virgil/sdk/client/networking/CurlMultiLoop.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Connection which sends requests from event-loop threads driving libcurl multi interface.
+                 *
+                 * Outstanding requests don't occupy threads: requests are distributed between loops round-robin,
+                 * each loop performs all its transfers concurrently and reuses keep-alive connections.
+                 * Requests above connections limit are queued by the loop until connection is available.
+                 * @note This class belongs to the **private** API
+                 */
+                class EventLoopConnection : public AsyncConnection {
+                public:
+                    /**
+                     * @brief Constructor, starts event-loop threads.
+                     * @param loopsCount - number of event-loop threads.
+                     * @param maxConnectionsPerHost - maximum number of connections per host for each loop,
+                     *                                0 means unlimited.
+                     */
+                    explicit EventLoopConnection(size_t loopsCount = 1, size_t maxConnectionsPerHost = 16);
+
+                    /**
+                     * @brief Stops event-loop threads, outstanding requests fail with std::runtime_error.
+                     */
+                    ~EventLoopConnection();
+
+                    /**
+                     * @brief Send asynchronous request.
+                     * @param request - request to be send.
+                     * @param callback - invoked on event-loop thread once response is received or request failed.
+                     */
+                    void sendAsync(const Request &request, Callback callback) override;
+
+                    /**
+                     * @brief Getter.
+                     * @return number of event-loop threads
+                     */
+                    size_t loopsCount() const;
+
+                    /**
+                     * @brief Getter.
+                     * @return maximum number of connections per host for each loop
+                     */
+                    size_t maxConnectionsPerHost() const;
+
+                    /**
+                     * @brief Returns number of requests, which were sent but not completed yet.
+                     */
+                    size_t pendingRequests() const;
+
+                    /**
+                     * @brief Returns number of requests which were sent over already established connection.
+                     */
+                    size_t reusedConnections() const;
+
+                    /**
+                     * @brief Returns number of requests which had to establish new connection.
+                     */
+                    size_t newConnections() const;
+
+                private:
+                    size_t maxConnectionsPerHost_;
+                    std::vector<std::unique_ptr<CurlMultiLoop>> loops_;
+                    std::atomic<size_t> nextLoop_;
+                    std::shared_ptr<std::atomic<size_t>> pendingRequests_;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_EVENT_LOOP_CONNECTION_H */
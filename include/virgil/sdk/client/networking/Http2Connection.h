@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_HTTP2_CONNECTION_H
+#define VIRGIL_SDK_HTTP_HTTP2_CONNECTION_H
+
+#include <memory>
+
+#include <virgil/sdk/client/networking/AsyncConnection.h>
+#include <virgil/sdk/client/networking/CurlMultiLoop.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Connection which sends requests over HTTP/2, concurrent requests to the same host
+                 * share single connection as multiplexed streams.
+                 *
+                 * Transfers are driven by single CurlMultiLoop thread, so requests don't block calling threads.
+                 * Cleartext (http://) addresses are expected to support HTTP/2 with prior knowledge (h2c).
+                 * @note This class belongs to the **private** API
+                 */
+                class Http2Connection : public AsyncConnection {
+                public:
+                    /**
+                     * @brief Constructor.
+                     * @param maxConcurrentStreams - maximum number of concurrent streams per connection,
+                     *                               server may lower it with its SETTINGS_MAX_CONCURRENT_STREAMS.
+                     * @param maxConnectionsPerHost - maximum number of connections per host,
+                     *                                requests above streams limit wait for free stream.
+                     * @throw std::runtime_error - if libcurl was built without HTTP/2 support.
+                     */
+                    explicit Http2Connection(size_t maxConcurrentStreams = 100, size_t maxConnectionsPerHost = 1);
+
+                    /**
+                     * @brief Send asynchronous request as stream of shared HTTP/2 connection.
+                     * @param request - request to be send.
+                     * @param callback - invoked on loop thread once response is received or request failed.
+                     */
+                    void sendAsync(const Request &request, Callback callback) override;
+
+                    /**
+                     * @brief Checks whether libcurl supports HTTP/2.
+                     */
+                    static bool isSupported();
+
+                    /**
+                     * @brief Getter.
+                     * @return maximum number of concurrent streams per connection
+                     */
+                    size_t maxConcurrentStreams() const;
+
+                    /**
+                     * @brief Getter.
+                     * @return maximum number of connections per host
+                     */
+                    size_t maxConnectionsPerHost() const;
+
+                    /**
+                     * @brief Returns number of requests which were sent over already established connection.
+                     */
+                    size_t reusedConnections() const;
+
+                    /**
+                     * @brief Returns number of requests which had to establish new connection.
+                     */
+                    size_t newConnections() const;
+
+                private:
+                    size_t maxConcurrentStreams_;
+                    size_t maxConnectionsPerHost_;
+                    std::unique_ptr<CurlMultiLoop> loop_;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_HTTP2_CONNECTION_H */
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTP_KEEP_ALIVE_CONNECTION_H
+#define VIRGIL_SDK_HTTP_KEEP_ALIVE_CONNECTION_H
+
+#include <memory>
+
+#include <virgil/sdk/client/networking/Connection.h>
+#include <virgil/sdk/client/networking/ConnectionPool.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                /**
+                 * @brief Connection which sends requests over keep-alive connections taken from ConnectionPool.
+                 * @note This class belongs to the **private** API
+                 */
+                class KeepAliveConnection : public Connection {
+                public:
+                    /**
+                     * @brief Constructor.
+                     * @param pool - pool of connections, can be shared between several KeepAliveConnection instances.
+                     */
+                    explicit KeepAliveConnection(std::shared_ptr<ConnectionPool> pool = std::make_shared<ConnectionPool>());
+
+                    /**
+                     * @brief Send synchronous request reusing idle connection to the same base address if any.
+                     * @param request - request to be send.
+                     * @throw std::logic_error - if given parameters are inconsistent.
+                     * @throw std::runtime_error - if error was occurred when send request.
+                     */
+                    Response send(const Request &request) override;
+
+                    /**
+                     * @brief Getter.
+                     * @return underlying ConnectionPool
+                     */
+                    const std::shared_ptr<ConnectionPool>& pool() const;
+
+                    /**
+                     * @brief Returns process-wide connection shared by SDK classes by default.
+                     */
+                    static std::shared_ptr<KeepAliveConnection> defaultConnection();
+
+                private:
+                    std::shared_ptr<ConnectionPool> pool_;
+                };
+            }
+        }
+    }
+}
+
+#endif /* VIRGIL_SDK_HTTP_KEEP_ALIVE_CONNECTION_H */
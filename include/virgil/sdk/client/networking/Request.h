@@ -37,6 +37,9 @@
 #ifndef VIRGIL_SDK_HTTP_REQUEST_H
 #define VIRGIL_SDK_HTTP_REQUEST_H
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <map>
 
@@ -129,6 +132,36 @@ namespace virgil {
                      */
                     Parameters parameters() const;
 
+                    /**
+                     * @brief Set maximum time the whole request is allowed to take.
+                     */
+                    Request &timeout(std::chrono::milliseconds timeout);
+
+                    /**
+                     * @brief Return maximum time the whole request is allowed to take.
+                     */
+                    std::chrono::milliseconds timeout() const;
+
+                    /**
+                     * @brief Set maximum time the connection phase is allowed to take, zero means no separate limit.
+                     */
+                    Request &connectTimeout(std::chrono::milliseconds connectTimeout);
+
+                    /**
+                     * @brief Return maximum time the connection phase is allowed to take.
+                     */
+                    std::chrono::milliseconds connectTimeout() const;
+
+                    /**
+                     * @brief Set flag, which aborts request once it's set.
+                     */
+                    Request &cancellationFlag(std::shared_ptr<const std::atomic<bool>> cancellationFlag);
+
+                    /**
+                     * @brief Return flag, which aborts request once it's set, may be nullptr.
+                     */
+                    std::shared_ptr<const std::atomic<bool>> cancellationFlag() const;
+
                     /**
                      * @brief Return request URI.
                      */
@@ -172,6 +205,9 @@ namespace virgil {
                     Header header_;
                     Parameters parameters_;
                     Method method_ = Method::GET;
+                    std::chrono::milliseconds timeout_ = std::chrono::milliseconds(7000);
+                    std::chrono::milliseconds connectTimeout_ = std::chrono::milliseconds(0);
+                    std::shared_ptr<const std::atomic<bool>> cancellationFlag_;
                 };
             }
         }
@@ -61,7 +61,11 @@ namespace virgil {
                         FORBIDDEN = 403,
                         ENTITY_NOT_FOUND = 404,
                         METHOD_NOT_ALLOWED = 405,
-                        SERVER_ERROR = 500
+                        TOO_MANY_REQUESTS = 429,
+                        SERVER_ERROR = 500,
+                        BAD_GATEWAY = 502,
+                        SERVICE_UNAVAILABLE = 503,
+                        GATEWAY_TIMEOUT = 504
                     };
                     /**
                      * @name Types aliases
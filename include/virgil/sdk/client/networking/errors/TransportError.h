@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_TRANSPORTERROR_H
+#define VIRGIL_SDK_TRANSPORTERROR_H
+
+#include <stdexcept>
+#include <string>
+
+namespace virgil {
+    namespace sdk {
+        namespace client {
+            namespace networking {
+                namespace errors {
+                    /*!
+                     * @brief Error of request, which failed before response was received.
+                     */
+                    class TransportError : public std::runtime_error {
+                    public:
+                        /*!
+                         * @brief Constructor.
+                         * @param message std::string with error description
+                         * @param requestSent false if request is known not to reach the server
+                         */
+                        TransportError(const std::string &message, bool requestSent);
+
+                        /*!
+                         * @brief Getter.
+                         * @return false if request is known not to reach the server, so it's safe to resend it
+                         */
+                        bool requestSent() const { return requestSent_; }
+
+                    private:
+                        bool requestSent_;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_TRANSPORTERROR_H
@@ -39,6 +39,10 @@
 
 #include <virgil/sdk/Common.h>
 #include <virgil/sdk/crypto/keys/KeyPair.h>
+#include <virgil/sdk/crypto/RecipientSet.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
+
+#include <vector>
 
 namespace virgil {
 namespace sdk {
@@ -48,6 +52,26 @@ namespace sdk {
          */
         class Crypto {
         public:
+            /*!
+             * @brief Data, signature and signer public key verified by verifyBatch
+             * @note Item references its fields, so they should outlive verifyBatch call
+             */
+            struct VerificationItem {
+                /*!
+                 * @brief Constructor
+                 * @param data data that was signed
+                 * @param signature digital signature
+                 * @param signerPublicKey signer public key
+                 */
+                VerificationItem(const VirgilByteArray &data, const VirgilByteArray &signature,
+                                 const keys::PublicKey &signerPublicKey)
+                        : data(data), signature(signature), signerPublicKey(signerPublicKey) {}
+
+                const VirgilByteArray &data;
+                const VirgilByteArray &signature;
+                const keys::PublicKey &signerPublicKey;
+            };
+
             /*!
              * @brief Constructor
              * @param useSHA256Fingerprints use old algorithm to generate key fingerprints
@@ -103,6 +127,13 @@ namespace sdk {
              */
             VirgilByteArray exportPublicKey(const keys::PublicKey &publicKey) const;
 
+            /*!
+             * @brief Prepares recipients for many encryptions
+             * @param recipients std::vector with recipient's Public Keys
+             * @return RecipientSet, which can be shared between threads
+             */
+            RecipientSet createRecipientSet(const std::vector<keys::PublicKey> &recipients) const;
+
             /*!
              * @brief Encrypts data for passed PublicKeys
              * @param data data to be encrypted
@@ -112,14 +143,47 @@ namespace sdk {
             VirgilByteArray encrypt(const VirgilByteArray &data,
                                     const std::vector<keys::PublicKey> &recipients) const;
 
+            /*!
+             * @brief Encrypts data for prepared recipients
+             * @param data data to be encrypted
+             * @param recipients RecipientSet created with createRecipientSet
+             * @return encrypted data
+             */
+            VirgilByteArray encrypt(const VirgilByteArray &data, const RecipientSet &recipients) const;
+
             /*!
              * @brief Encrypts data stream for passed PublicKeys
              * @param istream stream to be encrypted
              * @param ostream stream with encrypted data
              * @param recipients std::vector with recipient's Public Keys
+             * @param pipelined if true, reading from istream and writing to ostream are done on separate threads,
+             * concurrently with encryption. Output is the same, memory used for buffering stays bounded
+             */
+            void encrypt(std::istream &istream, std::ostream &ostream,
+                         const std::vector<keys::PublicKey> &recipients, bool pipelined = false) const;
+
+            /*!
+             * @brief Encrypts data stream for prepared recipients
+             * @param istream stream to be encrypted
+             * @param ostream stream with encrypted data
+             * @param recipients RecipientSet created with createRecipientSet
+             * @param pipelined if true, reading from istream and writing to ostream are done on separate threads,
+             * concurrently with encryption
              */
             void encrypt(std::istream &istream, std::ostream &ostream,
-                         const std::vector<keys::PublicKey> &recipients) const;
+                         const RecipientSet &recipients, bool pipelined = false) const;
+
+            /*!
+             * @brief Encrypts file for passed PublicKeys
+             * @note Input file is memory mapped and output is written directly to file descriptor,
+             * which is faster than going through streams
+             * @param inputPath path to file to be encrypted
+             * @param outputPath path to file with encrypted data, file is created or truncated
+             * @param recipients std::vector with recipient's Public Keys
+             * @throws std::system_error if file can't be read or written, or if output is the input file
+             */
+            void encryptFile(const std::string &inputPath, const std::string &outputPath,
+                             const std::vector<keys::PublicKey> &recipients) const;
 
             /*!
              * @brief Verifies digital signature of data
@@ -131,6 +195,17 @@ namespace sdk {
             bool verify(const VirgilByteArray &data, const VirgilByteArray &signature,
                         const keys::PublicKey &signerPublicKey) const;
 
+            /*!
+             * @brief Verifies digital signature of data using exported public key
+             * @note Allows to skip public key export when the same key verifies many signatures
+             * @param data data that was signed
+             * @param signature digital signature
+             * @param exportedSignerPublicKey signer public key exported with exportPublicKey
+             * @return true if signature is verified, else otherwise
+             */
+            bool verify(const VirgilByteArray &data, const VirgilByteArray &signature,
+                        const VirgilByteArray &exportedSignerPublicKey) const;
+
             /*!
              * @brief Verifies digital signature of data stream
              * @param istream data stream that was signed
@@ -141,6 +216,29 @@ namespace sdk {
             bool verify(std::istream &istream, const VirgilByteArray &signature,
                         const keys::PublicKey &signerPublicKey) const;
 
+            /*!
+             * @brief Verifies digital signature of file
+             * @note File is memory mapped, which is faster than going through stream
+             * @param path path to file that was signed
+             * @param signature digital signature
+             * @param signerPublicKey signer public key
+             * @return true if signature is verified, else otherwise
+             * @throws std::system_error if file can't be read
+             */
+            bool verifyFileSignature(const std::string &path, const VirgilByteArray &signature,
+                                     const keys::PublicKey &signerPublicKey) const;
+
+            /*!
+             * @brief Verifies digital signatures of many items concurrently
+             * @note Item with malformed signature or key is reported as not verified
+             * @param items VerificationItems to verify
+             * @param executor executors::ExecutorInterface implementation used for concurrent verification
+             * @return std::vector with verification result of each item, in the same order as items
+             */
+            std::vector<bool> verifyBatch(const std::vector<VerificationItem> &items,
+                                          const std::shared_ptr<executors::ExecutorInterface> &executor
+                                          = executors::ThreadPoolExecutor::defaultExecutor()) const;
+
             /*!
              * @brief Decrypts data using passed PrivateKey
              * @param data encrypted data
@@ -154,9 +252,23 @@ namespace sdk {
              * @param istream stream with encrypted data
              * @param ostream stream with decrypted data
              * @param privateKey recipient's private key
+             * @param pipelined if true, reading from istream and writing to ostream are done on separate threads,
+             * concurrently with decryption. Output is the same, memory used for buffering stays bounded
              */
             void decrypt(std::istream &istream, std::ostream &ostream,
-                         const keys::PrivateKey &privateKey) const;
+                         const keys::PrivateKey &privateKey, bool pipelined = false) const;
+
+            /*!
+             * @brief Decrypts file using passed PrivateKey
+             * @note Input file is memory mapped and output is written directly to file descriptor,
+             * which is faster than going through streams
+             * @param inputPath path to file with encrypted data
+             * @param outputPath path to file with decrypted data, file is created or truncated
+             * @param privateKey recipient's private key
+             * @throws std::system_error if file can't be read or written, or if output is the input file
+             */
+            void decryptFile(const std::string &inputPath, const std::string &outputPath,
+                             const keys::PrivateKey &privateKey) const;
 
             /*!
              * @brief Signs (with private key) Then Encrypts data for passed PublicKeys
@@ -168,6 +280,16 @@ namespace sdk {
             VirgilByteArray signThenEncrypt(const VirgilByteArray &data, const keys::PrivateKey &privateKey,
                                             const std::vector<keys::PublicKey> &recipients) const;
 
+            /*!
+             * @brief Signs (with private key) Then Encrypts data for prepared recipients
+             * @param data data to be signed, then encrypted
+             * @param privateKey sender private key
+             * @param recipients RecipientSet created with createRecipientSet
+             * @return signed, then encrypted data
+             */
+            VirgilByteArray signThenEncrypt(const VirgilByteArray &data, const keys::PrivateKey &privateKey,
+                                            const RecipientSet &recipients) const;
+
             /*!
              * @brief Decrypts (with private key) Then Verifies data using signer PublicKey
              * @param data data to be signed, then verified
@@ -197,6 +319,16 @@ namespace sdk {
             VirgilByteArray generateSignature(const VirgilByteArray &data,
                                               const keys::PrivateKey &privateKey) const;
 
+            /*!
+             * @brief Generates digital signature of data using exported private key
+             * @note Allows to skip private key export when the same key signs many messages
+             * @param data data to sign
+             * @param exportedPrivateKey Private Key exported with exportPrivateKey
+             * @return digital signature
+             */
+            VirgilByteArray generateSignature(const VirgilByteArray &data,
+                                              const VirgilByteArray &exportedPrivateKey) const;
+
             /*!
              * @brief Generates digital signature of data stream using private key
              * @param istream data stream to sign
@@ -205,6 +337,16 @@ namespace sdk {
              */
             VirgilByteArray generateSignature(std::istream &istream, const keys::PrivateKey &privateKey) const;
 
+            /*!
+             * @brief Generates digital signature of file using private key
+             * @note File is memory mapped, which is faster than going through stream
+             * @param path path to file to sign
+             * @param privateKey Private Key to be used to generate signature
+             * @return digital signature
+             * @throws std::system_error if file can't be read
+             */
+            VirgilByteArray generateFileSignature(const std::string &path, const keys::PrivateKey &privateKey) const;
+
             /*!
              * @brief Computes SHA-512
              * @param data data to be hashed
@@ -234,6 +376,9 @@ namespace sdk {
             bool useSHA256Fingerprints_;
 
             VirgilByteArray computeHashForPublicKey(const VirgilByteArray &publicKey) const;
+
+            template<typename Cipher>
+            static void addRecipients(Cipher &cipher, const RecipientSet &recipients);
         };
     }
 }
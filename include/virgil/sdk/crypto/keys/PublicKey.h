@@ -39,6 +39,9 @@
 
 #include <virgil/sdk/Common.h>
 
+#include <memory>
+#include <mutex>
+
 /// forward decl
 namespace virgil {
 namespace sdk {
@@ -61,9 +64,17 @@ namespace crypto {
 
             const VirgilByteArray &key() const { return key_; }
             const VirgilByteArray &identifier() const { return identifier_; }
+            const VirgilByteArray &derKey() const;
+
+            // DER representation consumed by crypto primitives, shared by copies of the key
+            struct DerKeyCache {
+                std::once_flag once;
+                VirgilByteArray derKey;
+            };
 
             VirgilByteArray key_;
             VirgilByteArray identifier_;
+            std::shared_ptr<DerKeyCache> derKeyCache_;
 
             friend Crypto;
         };
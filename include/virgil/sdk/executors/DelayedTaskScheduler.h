@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_DELAYEDTASKSCHEDULER_H
+#define VIRGIL_SDK_DELAYEDTASKSCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace virgil {
+    namespace sdk {
+        namespace executors {
+            /*!
+             * @brief Runs tasks after given delays on single timer thread
+             * @note Tasks should not block, since they delay each other. Long work should be passed to executor.
+             * Exceptions thrown by tasks are ignored
+             */
+            class DelayedTaskScheduler {
+            public:
+                /*!
+                 * @brief Constructor, starts timer thread
+                 */
+                DelayedTaskScheduler();
+
+                /*!
+                 * @brief Stops timer thread, scheduled tasks which are not started yet are dropped
+                 */
+                ~DelayedTaskScheduler();
+
+                DelayedTaskScheduler(const DelayedTaskScheduler&) = delete;
+
+                DelayedTaskScheduler& operator=(const DelayedTaskScheduler&) = delete;
+
+                /*!
+                 * @brief Runs task on timer thread after given delay
+                 * @param delay time to wait before running task
+                 * @param task std::function to run
+                 */
+                void schedule(std::chrono::milliseconds delay, std::function<void()> task);
+
+                /*!
+                 * @brief Returns number of tasks waiting for their time
+                 */
+                size_t pendingTasks() const;
+
+                /*!
+                 * @brief Returns process-wide scheduler shared by SDK classes by default
+                 */
+                static std::shared_ptr<DelayedTaskScheduler> defaultScheduler();
+
+            private:
+                void timerLoop();
+
+                mutable std::mutex mutex_;
+                std::condition_variable condition_;
+                std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> tasks_;
+                bool stopped_;
+                std::thread thread_;
+            };
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_DELAYEDTASKSCHEDULER_H
@@ -0,0 +1,174 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_EXECUTORINTERFACE_H
+#define VIRGIL_SDK_EXECUTORINTERFACE_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace virgil {
+    namespace sdk {
+        namespace executors {
+            /*!
+             * @brief Interface for executors running asynchronous SDK work (networking, verification, token retrieval)
+             */
+            class ExecutorInterface {
+            public:
+                /*!
+                 * @brief Schedules task for execution
+                 * @param task std::function to run
+                 */
+                virtual void execute(std::function<void()> task) = 0;
+
+                /*!
+                 * @brief Runs one of pending tasks on the calling thread, if any
+                 * @note Used to make progress while waiting for results of nested tasks
+                 * @return true if task was executed, false otherwise
+                 */
+                virtual bool runPendingTask() { return false; }
+
+                /*!
+                 * @brief Checks whether calling thread may run pending tasks while waiting
+                 * @return true if runPendingTask() can make progress on calling thread, false otherwise
+                 */
+                virtual bool canRunPendingTask() const { return false; }
+
+                /*!
+                 * @brief Returns function running pending tasks on the calling thread, see runPendingTask()
+                 * @note Returned function may keep executor state alive, so waiting can continue even if
+                 * last reference to executor is released by pending task
+                 * @return function returning true if task was executed, or empty function if canRunPendingTask() is false
+                 */
+                virtual std::function<bool()> pendingTaskRunner() {
+                    if (!canRunPendingTask())
+                        return nullptr;
+
+                    return [this] { return runPendingTask(); };
+                }
+
+                /*!
+                 * @brief Returns number of tasks waiting for execution
+                 */
+                virtual size_t queueDepth() const = 0;
+
+                /*!
+                 * @brief Schedules function for execution
+                 * @tparam F callable type
+                 * @param function callable without arguments
+                 * @return std::future with result of function
+                 */
+                template<typename F>
+                std::future<typename std::result_of<F()>::type> submit(F function) {
+                    using Result = typename std::result_of<F()>::type;
+                    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+                    auto future = task->get_future();
+                    execute([task] { (*task)(); });
+
+                    return future;
+                }
+
+                /*!
+                 * @brief Waits for future and returns its value, executor threads run pending tasks meanwhile,
+                 * so waiting from within executor thread can't exhaust the executor
+                 * @tparam T future value type
+                 * @param future std::future to wait for
+                 * @return future value
+                 */
+                template<typename T>
+                T get(std::future<T> future) {
+                    wait(future);
+
+                    return future.get();
+                }
+
+                /*!
+                 * @brief Waits for shared future and returns copy of its value, executing pending tasks meanwhile
+                 * @tparam T future value type
+                 * @param future std::shared_future to wait for
+                 * @return future value
+                 */
+                template<typename T>
+                T get(const std::shared_future<T> &future) {
+                    wait(future);
+
+                    return future.get();
+                }
+
+                /*!
+                 * @brief Waits for future, executing pending tasks meanwhile if canRunPendingTask() allows it,
+                 * other threads just block
+                 * @tparam Future std::future or std::shared_future
+                 * @param future future to wait for
+                 */
+                template<typename Future>
+                void wait(const Future &future) {
+                    auto status = future.wait_for(std::chrono::seconds(0));
+                    if (status != std::future_status::timeout)
+                        return;
+
+                    // Executor must not be touched after this point, helped task may release it
+                    auto runPendingTask = pendingTaskRunner();
+                    if (!runPendingTask) {
+                        future.wait();
+                        return;
+                    }
+
+                    auto pause = std::chrono::milliseconds(1);
+                    while (status == std::future_status::timeout) {
+                        if (runPendingTask()) {
+                            pause = std::chrono::milliseconds(1);
+                        } else {
+                            future.wait_for(pause);
+                            pause = std::min(pause * 2, std::chrono::milliseconds(16));
+                        }
+                        status = future.wait_for(std::chrono::seconds(0));
+                    }
+                }
+
+                /*!
+                 * @brief Virtual destructor
+                 */
+                virtual ~ExecutorInterface() = default;
+            };
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_EXECUTORINTERFACE_H
@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_EXECUTORUTILS_H
+#define VIRGIL_SDK_EXECUTORUTILS_H
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <virgil/sdk/executors/ExecutorInterface.h>
+
+namespace virgil {
+namespace sdk {
+    namespace executors {
+        /**
+         * @brief This class holds utils for splitting work between executor threads.
+         *
+         * @note This class belongs to the **private** API
+         */
+        class ExecutorUtils {
+        public:
+            /**
+             * @brief Splits [0, size) into chunks, maps them concurrently and concatenates results in order
+             * @param executor executor running all chunks except the first one, which runs on calling thread
+             * @param size number of items
+             * @param mapChunk callable taking (begin, end) and returning std::vector with results for items of chunk
+             * @return results of all chunks
+             * @note Chunks usually reference caller's data, so all of them complete before return,
+             * even if some throw. First exception is rethrown then
+             */
+            template<typename F>
+            static typename std::result_of<F(size_t, size_t)>::type mapChunks(
+                    const std::shared_ptr<ExecutorInterface> &executor, size_t size, F mapChunk) {
+                using Results = typename std::result_of<F(size_t, size_t)>::type;
+
+                // Few chunks per core keep tasks balanced without paying per-item scheduling
+                size_t chunksCount = std::max(1u, std::thread::hardware_concurrency()) * 4;
+                size_t chunkSize = std::max<size_t>(1, (size + chunksCount - 1) / chunksCount);
+                if (size <= chunkSize)
+                    return mapChunk(0, size);
+
+                auto futures = std::vector<std::future<Results>>();
+                for (auto begin = chunkSize; begin < size; begin += chunkSize) {
+                    auto end = std::min(begin + chunkSize, size);
+                    futures.push_back(executor->submit([&mapChunk, begin, end] { return mapChunk(begin, end); }));
+                }
+
+                std::exception_ptr error;
+                auto results = Results();
+                try {
+                    results = mapChunk(0, chunkSize);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                results.reserve(size);
+                for (auto& future : futures) {
+                    try {
+                        auto chunk = executor->get(std::move(future));
+                        std::move(chunk.begin(), chunk.end(), std::back_inserter(results));
+                    } catch (...) {
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+
+                if (error)
+                    std::rethrow_exception(error);
+
+                return results;
+            }
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_EXECUTORUTILS_H
@@ -0,0 +1,134 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_THREADPOOLEXECUTOR_H
+#define VIRGIL_SDK_THREADPOOLEXECUTOR_H
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <virgil/sdk/executors/ExecutorInterface.h>
+
+namespace virgil {
+    namespace sdk {
+        namespace executors {
+            /*!
+             * @brief Fixed-size work-stealing thread pool
+             * @note Each worker owns task queue. Tasks scheduled from worker thread go to its own queue,
+             * other tasks are distributed between queues. Idle workers steal tasks from other queues.
+             */
+            class ThreadPoolExecutor : public ExecutorInterface {
+            public:
+                /*!
+                 * @brief Constructor
+                 * @param threadCount number of worker threads, at least 1
+                 */
+                explicit ThreadPoolExecutor(size_t threadCount = defaultThreadCount());
+
+                /*!
+                 * @brief Finishes pending tasks and stops worker threads
+                 */
+                ~ThreadPoolExecutor();
+
+                ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+
+                ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+                /*!
+                 * @brief Schedules task for execution
+                 * @param task std::function to run
+                 * @throw std::logic_error if executor is being destroyed and task is scheduled outside of worker thread
+                 */
+                void execute(std::function<void()> task) override;
+
+                /*!
+                 * @brief Runs one of pending tasks on the calling worker thread, if any
+                 * @note Only tasks scheduled to worker's own queue are run, they are mostly nested tasks
+                 * of awaited work, so waiting worker is not held by unrelated requests
+                 * @return true if task was executed, false otherwise
+                 */
+                bool runPendingTask() override;
+
+                /*!
+                 * @brief Checks whether calling thread may run pending tasks while waiting
+                 * @return true for worker threads of this executor, unless nested helping is too deep
+                 */
+                bool canRunPendingTask() const override;
+
+                /*!
+                 * @brief Returns function running pending tasks on the calling worker thread
+                 * @note Function holds executor state, so it stays usable if executor is destroyed by helped task
+                 * @return function running pending task, or empty function if canRunPendingTask() is false
+                 */
+                std::function<bool()> pendingTaskRunner() override;
+
+                /*!
+                 * @brief Returns number of tasks waiting for execution
+                 */
+                size_t queueDepth() const override;
+
+                /*!
+                 * @brief Getter
+                 * @return number of worker threads
+                 */
+                size_t threadCount() const;
+
+                /*!
+                 * @brief Returns number of worker threads used by default
+                 */
+                static size_t defaultThreadCount();
+
+                /*!
+                 * @brief Returns process-wide executor shared by SDK classes by default
+                 */
+                static std::shared_ptr<ExecutorInterface> defaultExecutor();
+
+                /**
+                 * @brief Queues and synchronization shared with worker threads, so worker frames outlive executor
+                 * @note This struct belongs to the **private** API
+                 */
+                struct State;
+
+            private:
+                std::shared_ptr<State> state_;
+                std::vector<std::thread> threads_;
+            };
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_THREADPOOLEXECUTOR_H
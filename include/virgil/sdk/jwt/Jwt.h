@@ -44,6 +44,8 @@
 namespace virgil {
     namespace sdk {
         namespace jwt {
+            class JwtGenerator;
+
             /*!
              * @brief Class implementing AccessTokenInterface in terms of Virgil JWT
              */
@@ -120,6 +122,14 @@ namespace virgil {
                                                   const JwtBodyContent& bodyContent);
 
             private:
+                friend JwtGenerator;
+
+                Jwt(JwtHeaderContent headerContent,
+                    JwtBodyContent bodyContent,
+                    VirgilByteArray signatureContent,
+                    std::string stringRepresentation,
+                    VirgilByteArray dataToSign);
+
                 JwtHeaderContent headerContent_;
                 JwtBodyContent bodyContent_;
                 VirgilByteArray signatureContent_;
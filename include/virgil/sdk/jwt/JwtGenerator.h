@@ -40,7 +40,9 @@
 #include <memory>
 #include <virgil/sdk/crypto/Crypto.h>
 #include <virgil/sdk/jwt/Jwt.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 #include <unordered_map>
+#include <vector>
 
 namespace virgil {
     namespace sdk {
@@ -60,12 +62,15 @@ namespace virgil {
                  * @param appId Application Id.
                  * Can be taken  <a href="https://dashboard.virgilsecurity.com">here</a>
                  * @param ttl Lifetime of generated tokens
+                 * @param executor executors::ExecutorInterface implementation used for batch token generation
                  */
                 JwtGenerator(crypto::keys::PrivateKey apiKey,
                              std::string apiPublicKeyIdentifier,
                              std::shared_ptr<crypto::Crypto> crypto,
                              std::string appId,
-                             int ttl);
+                             int ttl,
+                             std::shared_ptr<executors::ExecutorInterface> executor
+                             = executors::ThreadPoolExecutor::defaultExecutor());
 
                 /*!
                  * @brief Generates new JWT
@@ -77,6 +82,17 @@ namespace virgil {
                                   const std::unordered_map<std::string, std::string>& additionalData
                                   = std::unordered_map<std::string, std::string>()) const;
 
+                /*!
+                 * @brief Generates new JWT for each identity
+                 * @note Tokens are signed concurrently and share issue date
+                 * @param identities std::vector with identities to generate with
+                 * @param additionalData std::unordered_map with additional data for all tokens
+                 * @return generated and signed Jwts in the same order as identities
+                 */
+                std::vector<Jwt> generateTokens(const std::vector<std::string>& identities,
+                                                const std::unordered_map<std::string, std::string>& additionalData
+                                                = std::unordered_map<std::string, std::string>()) const;
+
                 /*!
                  * @brief Getter
                  * @return Api Private Key Generator uses for signing generated tokens
@@ -109,12 +125,26 @@ namespace virgil {
                  */
                 int ttl() const;
 
+                /*!
+                 * @brief Getter
+                 * @return executors::ExecutorInterface implementation used for batch token generation
+                 */
+                const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
             private:
                 crypto::keys::PrivateKey apiKey_;
                 std::string apiPublicKeyIdentifier_;
                 std::shared_ptr<crypto::Crypto> crypto_;
                 std::string appId_;
                 int ttl_;
+                std::shared_ptr<executors::ExecutorInterface> executor_;
+                JwtHeaderContent headerContent_;
+                std::string headerBase64Url_;
+                VirgilByteArray exportedApiKey_;
+
+                Jwt generateToken(const std::string& identity,
+                                  const std::unordered_map<std::string, std::string>& additionalData,
+                                  std::time_t issuedAt) const;
             };
         }
     }
@@ -38,7 +38,11 @@
 #define VIRGIL_SDK_JWTVERIFIER_H
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <virgil/sdk/crypto/Crypto.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 #include <virgil/sdk/jwt/Jwt.h>
 
 namespace virgil {
@@ -54,10 +58,17 @@ namespace virgil {
                  * @param apiPublicKey Public Key which should be used to verify signatures
                  * @param apiPublicKeyIdentifier identifier of public key which should be used to verify signatures
                  * @param crypto std::shared_ptr to Crypto instance
+                 * @param verificationCacheSize maximum number of successfully verified tokens remembered
+                 * until their expiration, so that repeated verification of the same token skips signature check.
+                 * 0 disables cache
+                 * @param executor executors::ExecutorInterface implementation used for batch verification
                  */
                 JwtVerifier(crypto::keys::PublicKey apiPublicKey,
                             std::string apiPublicKeyIdentifier,
-                            std::shared_ptr<crypto::Crypto> crypto);
+                            std::shared_ptr<crypto::Crypto> crypto,
+                            size_t verificationCacheSize = 0,
+                            std::shared_ptr<executors::ExecutorInterface> executor
+                            = executors::ThreadPoolExecutor::defaultExecutor());
 
                 /*!
                  * @brief Verifies Jwt signature
@@ -66,6 +77,13 @@ namespace virgil {
                  */
                 bool verifyToken(const Jwt& token) const;
 
+                /*!
+                 * @brief Verifies signatures of many Jwts concurrently
+                 * @param tokens Jwts to be verified
+                 * @return std::vector with verification result of each token, in the same order as tokens
+                 */
+                std::vector<bool> verifyTokens(const std::vector<Jwt>& tokens) const;
+
                 /*!
                  * @brief Getter
                  * @return Public Key which Verifier uses to verify signatures
@@ -84,10 +102,46 @@ namespace virgil {
                  */
                 const std::shared_ptr<crypto::Crypto>& crypto() const;
 
+                /*!
+                 * @brief Getter
+                 * @return maximum number of remembered verified tokens
+                 */
+                size_t verificationCacheSize() const;
+
+                /*!
+                 * @brief Returns number of currently remembered verified tokens
+                 */
+                size_t cachedVerificationsCount() const;
+
+                /*!
+                 * @brief Getter
+                 * @return executors::ExecutorInterface implementation used for batch verification
+                 */
+                const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
             private:
+                struct CachedVerification {
+                    VirgilByteArray dataToSign;
+                    std::time_t expiresAt;
+                };
+
+                struct VerificationCache {
+                    std::mutex mutex;
+                    // Keyed by signature, signed data is compared on lookup
+                    std::unordered_map<std::string, CachedVerification> verifications;
+                };
+
+                bool isCachedVerification(const Jwt& token, const std::string& key, std::time_t now) const;
+
+                void cacheVerification(const Jwt& token, std::string key, std::time_t now) const;
+
                 crypto::keys::PublicKey apiPublicKey_;
                 std::string apiPublicKeyIdentifier_;
                 std::shared_ptr<crypto::Crypto> crypto_;
+                VirgilByteArray exportedApiPublicKey_;
+                size_t verificationCacheSize_;
+                std::shared_ptr<VerificationCache> verificationCache_;
+                std::shared_ptr<executors::ExecutorInterface> executor_;
             };
         }
     }
@@ -38,7 +38,11 @@
 #define VIRGIL_SDK_CACHINGJWTPROVIDER_H
 
 #include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <virgil/sdk/jwt/interfaces/AccessTokenProviderInterface.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 #include <virgil/sdk/jwt/Jwt.h>
 
 namespace virgil {
@@ -47,14 +51,28 @@ namespace virgil {
             namespace providers {
                 /*!
                  * @brief Implementation of AccessTokenProvider which provides AccessToken using cache+renew callback
+                 * @note Tokens are cached per service, operation and identity of TokenContext in sharded cache,
+                 * so that many identities can share one provider.
+                 * Provider is thread-safe. Concurrent callers share one in-flight renewal,
+                 * and token is renewed in background before it expires
                  */
                 class CachingJwtProvider : public interfaces::AccessTokenProviderInterface {
                 public:
                     /*!
                      * @brief Constructor
                      * @param renewJwtCallback std::function, which takes a TokenContext returns std::future with Jwt std::string
+                     * @param executor executors::ExecutorInterface implementation used to obtain tokens asynchronously
+                     * @param refreshFraction fraction of token lifetime after which token is renewed in background,
+                     * while cached one is still returned. Value >= 1 disables background renewal
+                     * @param maxEntries maximum number of cached tokens. Expired and soonest expiring tokens are evicted first.
+                     * Limit is soft: tokens being renewed are never evicted, so cache grows past it
+                     * while all tokens of a shard are being renewed
                      */
-                    CachingJwtProvider(std::function<std::future<std::string>(const TokenContext&)> renewJwtCallback);
+                    CachingJwtProvider(std::function<std::future<std::string>(const TokenContext&)> renewJwtCallback,
+                                       std::shared_ptr<executors::ExecutorInterface> executor
+                                       = executors::ThreadPoolExecutor::defaultExecutor(),
+                                       double refreshFraction = 0.75,
+                                       size_t maxEntries = 1024);
 
                     /*!
                      * @brief Provides access token using callback or cached token
@@ -69,15 +87,73 @@ namespace virgil {
                      */
                     const std::function<std::future<std::string>(const TokenContext&)>& renewJwtCallback() const;
 
+                    /*!
+                     * @brief Returns cached Jwt for TokenContext
+                     * @param tokenContext TokenContext token was requested with
+                     * @return cached Jwt, nullptr if there is no one
+                     */
+                    std::shared_ptr<Jwt> jwt(const TokenContext& tokenContext) const;
+
+                    /*!
+                     * @brief Returns number of cached tokens
+                     */
+                    size_t size() const;
+
                     /*!
                      * @brief Getter
-                     * @return cached Jwt
+                     * @return executors::ExecutorInterface implementation used to obtain tokens
                      */
-                    const std::shared_ptr<Jwt>& jwt() const;
+                    const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
+                    /*!
+                     * @brief Getter
+                     * @return fraction of token lifetime after which token is renewed in background
+                     */
+                    double refreshFraction() const;
+
+                    /*!
+                     * @brief Getter
+                     * @return maximum number of cached tokens, may be exceeded by tokens being renewed
+                     */
+                    size_t maxEntries() const;
 
                 private:
-                    std::shared_ptr<Jwt> jwt_;
+                    struct Entry {
+                        std::shared_ptr<Jwt> jwt;
+                        std::shared_future<std::shared_ptr<Jwt>> renewal;
+                    };
+
+                    struct Shard {
+                        std::mutex mutex;
+                        std::unordered_map<std::string, Entry> entries;
+                    };
+
+                    struct State {
+                        State(size_t shardsCount, size_t maxShardEntries);
+
+                        Shard& shard(const std::string& key);
+
+                        std::vector<Shard> shards;
+                        size_t maxShardEntries;
+                    };
+
+                    static std::string cacheKey(const TokenContext& tokenContext);
+
+                    static void evict(Shard& shard, size_t maxShardEntries, std::time_t now);
+
+                    // Registers renewal in entry under shard lock, returned task performs it and has to be
+                    // executed after the lock is released. Empty if renewal is already in progress
+                    std::function<void()> startRenewal(const std::string& key, Entry& entry,
+                                                       const TokenContext& tokenContext);
+
+                    std::time_t refreshTime(const Jwt& jwt) const;
+
                     std::function<std::future<std::string>(const TokenContext&)> renewJwtCallback_;
+                    std::shared_ptr<executors::ExecutorInterface> executor_;
+                    double refreshFraction_;
+                    size_t maxEntries_;
+                    // Shared with renewal tasks, so that they can outlive provider
+                    std::shared_ptr<State> state_;
                 };
             }
         }
@@ -39,6 +39,7 @@
 
 #include <functional>
 #include <virgil/sdk/jwt/interfaces/AccessTokenProviderInterface.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
 
 namespace virgil {
     namespace sdk {
@@ -52,8 +53,11 @@ namespace virgil {
                     /*!
                      * @brief Constructor
                      * @param getTokenCallback std::function, which takes a TokenContext returns std::future with Jwt std::string
+                     * @param executor executors::ExecutorInterface implementation used to obtain tokens asynchronously
                      */
-                    CallbackJwtProvider(std::function<std::future<std::string>(const TokenContext&)> getTokenCallback);
+                    CallbackJwtProvider(std::function<std::future<std::string>(const TokenContext&)> getTokenCallback,
+                                        std::shared_ptr<executors::ExecutorInterface> executor
+                                        = executors::ThreadPoolExecutor::defaultExecutor());
 
                     /*!
                      * @brief Provides access token using callback
@@ -68,8 +72,15 @@ namespace virgil {
                      */
                     const std::function<std::future<std::string>(const TokenContext&)>& getTokenCallback() const;
 
+                    /*!
+                     * @brief Getter
+                     * @return executors::ExecutorInterface implementation used to obtain tokens
+                     */
+                    const std::shared_ptr<executors::ExecutorInterface>& executor() const;
+
                 private:
                     std::function<std::future<std::string>(const TokenContext&)> getTokenCallback_;
+                    std::shared_ptr<executors::ExecutorInterface> executor_;
                 };
             }
         }
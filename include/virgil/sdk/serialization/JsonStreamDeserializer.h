@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_JSONSTREAMDESERIALIZER_H
+#define VIRGIL_SDK_JSONSTREAMDESERIALIZER_H
+
+#include <string>
+
+namespace virgil {
+namespace sdk {
+    namespace serialization {
+        /*!
+         * @brief This class is responsible for model deserialization without building intermediate Json document.
+         * @note Json is parsed by RapidJSON SAX reader, only needed values are copied out of it.
+         * @note Supported classes: RawSignedModel, std::vector<RawSignedModel>, JwtHeaderContent, JwtBodyContent
+         * @tparam T Class to be deserialized
+         */
+        template<typename T>
+        class JsonStreamDeserializer {
+        public:
+            /*!
+             * @brief Deserialize object from its Json representation.
+             * @tparam FAKE Fake parameter to allow implementation in source files
+             * @param jsonString std::string with json representation of model
+             * @return deserialized object
+             */
+            template<int FAKE = 0>
+            static T fromJsonString(const std::string &jsonString);
+
+            /*!
+             * @brief Forbid instantiation.
+             */
+            JsonStreamDeserializer() = delete;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_JSONSTREAMDESERIALIZER_H
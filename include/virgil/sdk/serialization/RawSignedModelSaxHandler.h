@@ -0,0 +1,171 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_RAWSIGNEDMODELSAXHANDLER_H
+#define VIRGIL_SDK_RAWSIGNEDMODELSAXHANDLER_H
+
+#include <vector>
+
+#include <virgil/sdk/client/models/RawSignedModel.h>
+#include <virgil/sdk/util/JsonKey.h>
+#include <virgil/sdk/util/JsonSaxHandler.h>
+
+namespace virgil {
+namespace sdk {
+    namespace serialization {
+        /**
+         * @brief SAX handler deserializing RawSignedModel or array of them.
+         * @note This class belongs to the **private** API
+         */
+        class RawSignedModelSaxHandler : public util::JsonSaxHandler<RawSignedModelSaxHandler> {
+        public:
+            /*!
+             * @brief Constructor
+             * @param isArray true if Json is an array of models, false if it's single model
+             */
+            explicit RawSignedModelSaxHandler(bool isArray)
+                    : JsonSaxHandler(isArray), modelDepth_(isArray ? 2 : 1), inSignatures_(false),
+                      hasContentSnapshot_(false), hasSigner_(false), hasSignature_(false) {}
+
+            /*!
+             * @brief Getter
+             * @return parsed models
+             */
+            std::vector<client::models::RawSignedModel>& models() { return models_; }
+
+            //! @cond Doxygen_Suppress
+            bool Default() {
+                return !expectsObject() ? JsonSaxHandler::Default() : fail("expected object");
+            }
+
+            bool String(const char *str, rapidjson::SizeType length, bool) {
+                if (depth_ == modelDepth_ && key_ == util::JsonKey::ContentSnapshot) {
+                    hasContentSnapshot_ = true;
+                    return decodeBase64(str, length, contentSnapshot_) || fail("invalid base64 string");
+                }
+
+                if (depth_ == modelDepth_ + 2 && inSignatures_) {
+                    if (key_ == util::JsonKey::Signer) {
+                        signer_.assign(str, length);
+                        hasSigner_ = true;
+                    } else if (key_ == util::JsonKey::Snapshot) {
+                        return decodeBase64(str, length, snapshot_) || fail("invalid base64 string");
+                    } else if (key_ == util::JsonKey::Signature) {
+                        hasSignature_ = true;
+                        return decodeBase64(str, length, signature_) || fail("invalid base64 string");
+                    }
+                    return true;
+                }
+
+                return Default();
+            }
+
+            bool StartObject() {
+                if (depth_ == modelDepth_ - 1) {
+                    contentSnapshot_.clear();
+                    hasContentSnapshot_ = false;
+                    signatures_.clear();
+                } else if (depth_ == modelDepth_ + 1 && inSignatures_) {
+                    signer_.clear();
+                    snapshot_.clear();
+                    signature_.clear();
+                    hasSigner_ = hasSignature_ = false;
+                }
+
+                return JsonSaxHandler::StartObject();
+            }
+
+            bool EndObject(rapidjson::SizeType length) {
+                if (depth_ == modelDepth_) {
+                    if (!hasContentSnapshot_)
+                        return fail("content_snapshot is missing");
+
+                    models_.emplace_back(std::move(contentSnapshot_));
+                    for (auto &signature : signatures_)
+                        models_.back().addSignature(std::move(signature));
+                } else if (depth_ == modelDepth_ + 2 && inSignatures_) {
+                    if (!hasSigner_ || !hasSignature_)
+                        return fail("signer or signature is missing");
+
+                    signatures_.emplace_back(std::move(signer_), std::move(signature_), std::move(snapshot_));
+                }
+
+                return JsonSaxHandler::EndObject(length);
+            }
+
+            bool StartArray() {
+                if (expectsObject())
+                    return fail("expected object");
+
+                if (depth_ == modelDepth_ && key_ == util::JsonKey::Signatures)
+                    inSignatures_ = true;
+
+                return JsonSaxHandler::StartArray();
+            }
+
+            bool EndArray(rapidjson::SizeType length) {
+                if (depth_ == modelDepth_ + 1)
+                    inSignatures_ = false;
+
+                return JsonSaxHandler::EndArray(length);
+            }
+            //! @endcond
+
+        private:
+            // Array elements and signatures must be objects
+            bool expectsObject() const {
+                return (depth_ > 0 && depth_ < modelDepth_) || (inSignatures_ && depth_ == modelDepth_ + 1);
+            }
+
+            const size_t modelDepth_;
+            std::vector<client::models::RawSignedModel> models_;
+
+            VirgilByteArray contentSnapshot_;
+            std::vector<client::models::RawSignature> signatures_;
+            bool inSignatures_;
+            bool hasContentSnapshot_;
+
+            std::string signer_;
+            VirgilByteArray snapshot_;
+            VirgilByteArray signature_;
+            bool hasSigner_;
+            bool hasSignature_;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_RAWSIGNEDMODELSAXHANDLER_H
@@ -37,6 +37,7 @@
 #ifndef VIRGIL_SDK_BASE64URL_H
 #define VIRGIL_SDK_BASE64URL_H
 
+#include <cstddef>
 #include <string>
 
 namespace virgil {
@@ -61,13 +62,30 @@ namespace virgil {
                  */
                 static std::string decode(const std::string &in);
 
+                /*!
+                 * @brief Decodes base64Url encoded characters into preallocated buffer
+                 * @note Decoding stops at the first character outside of base64Url alphabet (e.g. padding)
+                 * @param in pointer to base64Url encoded characters
+                 * @param length number of characters
+                 * @param out buffer, which should have room for at least length * 3 / 4 bytes
+                 * @return number of decoded bytes
+                 */
+                static size_t decode(const char *in, size_t length, unsigned char *out);
+
                 /*!
                  * @brief Forbid creation.
                  */
                 Base64Url() = delete;
 
             private:
+                static bool isSsse3Supported();
+
+                static size_t encodeSsse3(const unsigned char *in, size_t length, char *out);
+
+                static size_t decodeSsse3(const unsigned char *in, size_t length, unsigned char *out);
+
                 static const char base64_url_alphabet[];
+                static const signed char base64_url_decode_table[];
             };
         }
     }
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_UTIL_BOUNDED_QUEUE_H
+#define VIRGIL_SDK_UTIL_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace virgil {
+namespace sdk {
+    namespace util {
+        /**
+         * @brief Thread-safe FIFO queue holding limited number of items.
+         *
+         * Producer blocks while queue is full, consumer blocks while queue is empty.
+         * After queue is closed, producer can't add items, and consumer receives remaining ones.
+         * @note This class belongs to the **private** API
+         */
+        template<typename T>
+        class BoundedQueue {
+        public:
+            /*!
+             * @brief Constructor
+             * @param capacity maximum number of items in queue
+             */
+            explicit BoundedQueue(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+            /*!
+             * @brief Adds item to queue, waiting while queue is full
+             * @param item item to add
+             * @return false if queue is closed, true otherwise
+             */
+            bool push(T item) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+                if (closed_)
+                    return false;
+
+                items_.push_back(std::move(item));
+                notEmpty_.notify_one();
+
+                return true;
+            }
+
+            /*!
+             * @brief Takes item from queue, waiting while queue is empty
+             * @param item variable to store item into
+             * @return false if queue is closed and has no items, true otherwise
+             */
+            bool pop(T &item) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+                if (items_.empty())
+                    return false;
+
+                item = std::move(items_.front());
+                items_.pop_front();
+                notFull_.notify_one();
+
+                return true;
+            }
+
+            /*!
+             * @brief Closes queue and wakes up all waiting producers and consumers
+             */
+            void close() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+                notFull_.notify_all();
+                notEmpty_.notify_all();
+            }
+
+        private:
+            std::mutex mutex_;
+            std::condition_variable notFull_;
+            std::condition_variable notEmpty_;
+            std::deque<T> items_;
+            size_t capacity_;
+            bool closed_ = false;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_UTIL_BOUNDED_QUEUE_H
@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_UTIL_FILE_DATA_SINK_H
+#define VIRGIL_SDK_UTIL_FILE_DATA_SINK_H
+
+#include <string>
+
+#include <virgil/crypto/VirgilDataSink.h>
+
+#include <virgil/sdk/Common.h>
+
+namespace virgil {
+namespace sdk {
+    namespace util {
+        /**
+         * @brief Data sink writing to file descriptor with pwrite, without intermediate stream buffers.
+         * @note This class belongs to the **private** API
+         */
+        class FileDataSink : public virgil::crypto::VirgilDataSink {
+        public:
+            /*!
+             * @brief Constructor
+             * @param path path to file, file is created or truncated
+             * @param sizeHint expected size of output, space for it is reserved upfront if possible
+             * @throws std::system_error if file can't be opened
+             */
+            FileDataSink(const std::string &path, size_t sizeHint = 0);
+
+            /*!
+             * @brief Closes file
+             */
+            ~FileDataSink();
+
+            FileDataSink(const FileDataSink&) = delete;
+
+            FileDataSink& operator=(const FileDataSink&) = delete;
+
+            /*!
+             * @brief Checks if file is still writable
+             * @return true if no write errors happened, false otherwise
+             */
+            bool isGood() override;
+
+            /*!
+             * @brief Writes chunk to file
+             * @param data chunk of data
+             * @throws std::system_error if writing failed
+             */
+            void write(const VirgilByteArray &data) override;
+
+            /*!
+             * @brief Trims reserved space to actually written size and closes file
+             * @throws std::system_error if file can't be finalized
+             */
+            void finish();
+
+        private:
+            int fd_ = -1;
+            size_t offset_ = 0;
+            bool isGood_ = true;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_UTIL_FILE_DATA_SINK_H
@@ -0,0 +1,190 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_UTIL_JSON_SAX_HANDLER_H
+#define VIRGIL_SDK_UTIL_JSON_SAX_HANDLER_H
+
+#include <stdexcept>
+#include <string>
+
+#include <rapidjson/reader.h>
+#include <rapidjson/error/en.h>
+
+#include <virgil/sdk/Common.h>
+
+namespace virgil {
+namespace sdk {
+    namespace util {
+        /**
+         * @brief Base of RapidJSON SAX handlers, which deserialize models straight from Json text.
+         *
+         * Handler tracks nesting depth and the last key, so derived handler picks values it needs
+         * by their depth and key, and the rest are skipped without being stored anywhere.
+         * Derived handler hides events it's interested in and calls base ones to keep tracking.
+         * @tparam Derived handler class
+         * @note This class belongs to the **private** API
+         */
+        template<typename Derived>
+        class JsonSaxHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Derived> {
+        public:
+            /*!
+             * @brief Constructor
+             * @param rootIsArray true if Json root should be an array, false if it should be an object
+             */
+            explicit JsonSaxHandler(bool rootIsArray = false) : rootIsArray_(rootIsArray), depth_(0) {}
+
+            /*!
+             * @brief Parses Json passing its events to derived handler
+             * @param json std::string with Json
+             * @throws std::logic_error if Json is malformed or rejected by handler
+             */
+            void parse(const std::string &json) {
+                rapidjson::Reader reader;
+                rapidjson::StringStream stream(json.c_str());
+                auto result = reader.Parse(stream, static_cast<Derived&>(*this));
+                if (result.IsError()) {
+                    auto message = error_.empty() ? std::string(rapidjson::GetParseError_En(result.Code())) : error_;
+                    throw std::logic_error(message + " at offset " + std::to_string(result.Offset()));
+                }
+            }
+
+            //! @cond Doxygen_Suppress
+            bool Default() {
+                return depth_ > 0 || fail(rootIsArray_ ? "expected array" : "expected object");
+            }
+
+            bool StartObject() {
+                if (depth_ == 0 && rootIsArray_)
+                    return fail("expected array");
+                ++depth_;
+                return true;
+            }
+
+            bool EndObject(rapidjson::SizeType) {
+                --depth_;
+                return true;
+            }
+
+            bool StartArray() {
+                if (depth_ == 0 && !rootIsArray_)
+                    return fail("expected object");
+                ++depth_;
+                return true;
+            }
+
+            bool EndArray(rapidjson::SizeType) {
+                --depth_;
+                return true;
+            }
+
+            bool Key(const char *str, rapidjson::SizeType length, bool) {
+                key_.assign(str, length);
+                return true;
+            }
+            //! @endcond
+
+        protected:
+            /*!
+             * @brief Stops parsing with error
+             * @param message error description
+             * @return false, so it can be returned from event method
+             */
+            bool fail(const char *message) {
+                error_ = message;
+                return false;
+            }
+
+            /*!
+             * @brief Decodes base64 string value
+             * @param str pointer to string characters
+             * @param length number of characters
+             * @param value VirgilByteArray to store decoded bytes into
+             * @return false if string is not valid base64
+             */
+            static bool decodeBase64(const char *str, rapidjson::SizeType length, VirgilByteArray &value) {
+                value.clear();
+                value.reserve(length / 4 * 3);
+
+                unsigned accumulator = 0;
+                int bits = 0;
+                size_t padding = 0;
+                for (auto end = str + length; str != end; ++str) {
+                    if (*str == '=') {
+                        ++padding;
+                        continue;
+                    }
+
+                    auto decoded = base64Value(*str);
+                    if (decoded < 0 || padding > 0)
+                        return false;
+
+                    accumulator = (accumulator << 6) | static_cast<unsigned>(decoded);
+                    bits += 6;
+                    if (bits >= 8) {
+                        bits -= 8;
+                        value.push_back(static_cast<unsigned char>((accumulator >> bits) & 0xFF));
+                    }
+                }
+
+                return padding <= 2 && bits < 6;
+            }
+
+            const bool rootIsArray_;
+            size_t depth_;
+            std::string key_;
+
+        private:
+            static int base64Value(char c) {
+                if (c >= 'A' && c <= 'Z')
+                    return c - 'A';
+                if (c >= 'a' && c <= 'z')
+                    return c - 'a' + 26;
+                if (c >= '0' && c <= '9')
+                    return c - '0' + 52;
+                if (c == '+')
+                    return 62;
+                if (c == '/')
+                    return 63;
+                return -1;
+            }
+
+            std::string error_;
+        };
+    }
+}
+}
+
+#endif /* VIRGIL_SDK_UTIL_JSON_SAX_HANDLER_H */
@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_UTIL_MAPPED_FILE_DATA_SOURCE_H
+#define VIRGIL_SDK_UTIL_MAPPED_FILE_DATA_SOURCE_H
+
+#include <string>
+
+#include <virgil/crypto/VirgilDataSource.h>
+
+#include <virgil/sdk/Common.h>
+
+namespace virgil {
+namespace sdk {
+    namespace util {
+        /**
+         * @brief Data source reading file through memory mapping.
+         *
+         * File is mapped read-only as a whole, chunks are copied straight from mapped pages,
+         * without intermediate stream buffers.
+         * @note This class belongs to the **private** API
+         */
+        class MappedFileDataSource : public virgil::crypto::VirgilDataSource {
+        public:
+            /*!
+             * @brief Constructor
+             * @param path path to file
+             * @param chunkSize size of chunk returned by read()
+             * @throws std::system_error if file can't be opened or mapped
+             */
+            MappedFileDataSource(const std::string &path, size_t chunkSize);
+
+            /*!
+             * @brief Unmaps file
+             */
+            ~MappedFileDataSource();
+
+            MappedFileDataSource(const MappedFileDataSource&) = delete;
+
+            MappedFileDataSource& operator=(const MappedFileDataSource&) = delete;
+
+            /*!
+             * @brief Checks if there is more data
+             * @return true if there is more data, false otherwise
+             */
+            bool hasData() override;
+
+            /*!
+             * @brief Returns next chunk
+             * @return chunk of data, empty if there is no more data
+             */
+            VirgilByteArray read() override;
+
+            /*!
+             * @brief Returns size of file
+             */
+            size_t size() const;
+
+            /*!
+             * @brief Checks whether path refers to mapped file, e.g. through another name or link
+             * @param path path to file
+             * @return true if path refers to mapped file, false otherwise or if path doesn't exist
+             */
+            bool isSameFile(const std::string &path) const;
+
+        private:
+            const unsigned char *data_ = nullptr;
+            size_t size_ = 0;
+            size_t position_ = 0;
+            size_t chunkSize_;
+            unsigned long long device_ = 0;
+            unsigned long long inode_ = 0;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_UTIL_MAPPED_FILE_DATA_SOURCE_H
@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_UTIL_READ_AHEAD_DATA_SOURCE_H
+#define VIRGIL_SDK_UTIL_READ_AHEAD_DATA_SOURCE_H
+
+#include <exception>
+#include <istream>
+#include <thread>
+
+#include <virgil/crypto/VirgilDataSource.h>
+
+#include <virgil/sdk/Common.h>
+#include <virgil/sdk/util/BoundedQueue.h>
+
+namespace virgil {
+namespace sdk {
+    namespace util {
+        /**
+         * @brief Data source reading input stream ahead on dedicated thread.
+         *
+         * Reading runs concurrently with consumer processing previous chunks.
+         * At most maxBufferedChunks chunks are kept in memory.
+         * @note This class belongs to the **private** API
+         */
+        class ReadAheadDataSource : public virgil::crypto::VirgilDataSource {
+        public:
+            /*!
+             * @brief Constructor
+             * @param istream input stream, should outlive data source
+             * @param chunkSize size of chunk read from stream at once
+             * @param maxBufferedChunks maximum number of chunks read ahead
+             */
+            ReadAheadDataSource(std::istream &istream, size_t chunkSize, size_t maxBufferedChunks);
+
+            /*!
+             * @brief Stops reading and waits for reading thread to finish
+             */
+            ~ReadAheadDataSource();
+
+            ReadAheadDataSource(const ReadAheadDataSource&) = delete;
+
+            ReadAheadDataSource& operator=(const ReadAheadDataSource&) = delete;
+
+            /*!
+             * @brief Checks if there is more data, waiting for next chunk if needed
+             * @return true if there is more data, false otherwise
+             */
+            bool hasData() override;
+
+            /*!
+             * @brief Returns next chunk
+             * @return chunk of data, empty if there is no more data
+             */
+            VirgilByteArray read() override;
+
+        private:
+            void readLoop();
+
+            std::istream &istream_;
+            size_t chunkSize_;
+            BoundedQueue<VirgilByteArray> chunks_;
+            VirgilByteArray nextChunk_;
+            bool hasNextChunk_ = false;
+            std::exception_ptr error_;
+            std::thread reader_;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_UTIL_READ_AHEAD_DATA_SOURCE_H
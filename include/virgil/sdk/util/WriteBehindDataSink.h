@@ -0,0 +1,109 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_UTIL_WRITE_BEHIND_DATA_SINK_H
+#define VIRGIL_SDK_UTIL_WRITE_BEHIND_DATA_SINK_H
+
+#include <atomic>
+#include <exception>
+#include <ostream>
+#include <thread>
+
+#include <virgil/crypto/VirgilDataSink.h>
+
+#include <virgil/sdk/Common.h>
+#include <virgil/sdk/util/BoundedQueue.h>
+
+namespace virgil {
+namespace sdk {
+    namespace util {
+        /**
+         * @brief Data sink writing to output stream on dedicated thread.
+         *
+         * Writing runs concurrently with producer preparing next chunks.
+         * At most maxBufferedChunks chunks are kept in memory, producer waits when limit is reached.
+         * @note finish() should be called to make sure all data is written
+         * @note This class belongs to the **private** API
+         */
+        class WriteBehindDataSink : public virgil::crypto::VirgilDataSink {
+        public:
+            /*!
+             * @brief Constructor
+             * @param ostream output stream, should outlive data sink
+             * @param maxBufferedChunks maximum number of chunks waiting to be written
+             */
+            WriteBehindDataSink(std::ostream &ostream, size_t maxBufferedChunks);
+
+            /*!
+             * @brief Waits for writing thread to finish
+             */
+            ~WriteBehindDataSink();
+
+            WriteBehindDataSink(const WriteBehindDataSink&) = delete;
+
+            WriteBehindDataSink& operator=(const WriteBehindDataSink&) = delete;
+
+            /*!
+             * @brief Checks if output stream is still writable
+             * @return true if no write errors happened, false otherwise
+             */
+            bool isGood() override;
+
+            /*!
+             * @brief Schedules chunk for writing
+             * @param data chunk of data
+             */
+            void write(const VirgilByteArray &data) override;
+
+            /*!
+             * @brief Waits until all scheduled chunks are written
+             * @throws std::runtime_error if writing to output stream failed
+             */
+            void finish();
+
+        private:
+            void writeLoop();
+
+            std::ostream &ostream_;
+            BoundedQueue<VirgilByteArray> chunks_;
+            std::atomic<bool> isGood_;
+            std::thread writer_;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_UTIL_WRITE_BEHIND_DATA_SINK_H
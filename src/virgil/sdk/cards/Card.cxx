@@ -34,33 +34,107 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
+#include <mutex>
 #include <virgil/sdk/cards/Card.h>
+#include <virgil/sdk/client/models/RawCardContent.h>
+#include <virgil/sdk/crypto/Crypto.h>
 
 using virgil::sdk::cards::Card;
+using virgil::sdk::crypto::Crypto;
 using virgil::sdk::crypto::keys::PublicKey;
 using virgil::sdk::VirgilByteArray;
 using virgil::sdk::cards::CardSignature;
+using virgil::sdk::client::models::RawCardContent;
 using virgil::sdk::client::models::RawSignedModel;
 using virgil::sdk::client::models::RawSignature;
 
+// Card identifier is hex of first 32 bytes of content snapshot SHA-512
+static const size_t IdentifierBytesLength = 32;
+static const char HexAlphabet[] = "0123456789abcdef";
+
+struct Card::LazyState {
+    explicit LazyState(std::shared_ptr<Crypto> crypto) : crypto(std::move(crypto)) {}
+
+    std::shared_ptr<Crypto> crypto;
+
+    std::once_flag identifierOnce;
+    std::string identifier;
+
+    std::once_flag contentOnce;
+    std::unique_ptr<RawCardContent> content;
+
+    std::once_flag publicKeyOnce;
+    std::unique_ptr<PublicKey> publicKey;
+};
+
 Card::Card(std::string identifier, std::string identity, PublicKey publicKey,
            std::string version, std::time_t createdAt, VirgilByteArray contentSnapshot,
            bool isOutdated, std::vector<CardSignature> signatures, std::string previousCardId,
            std::shared_ptr<Card> previousCard)
-        : identifier_(std::move(identifier)), identity_(std::move(identity)), publicKey_(std::move(publicKey)),
-          version_(std::move(version)), createdAt_(createdAt), contentSnapshot_(std::move(contentSnapshot)),
-          isOutdated_(isOutdated), signatures_(std::move(signatures)), previousCardId_(std::move(previousCardId)),
-          previousCard_(std::move(previousCard)) {}
+        : identifier_(std::move(identifier)), identity_(std::move(identity)),
+          publicKey_(std::make_shared<PublicKey>(std::move(publicKey))),
+          previousCardId_(std::move(previousCardId)), previousCard_(std::move(previousCard)), isOutdated_(isOutdated),
+          version_(std::move(version)), createdAt_(createdAt), signatures_(std::move(signatures)),
+          contentSnapshot_(std::move(contentSnapshot)), hasPreviousCardId_(true) {}
+
+Card::Card(const RawSignedModel &rawCard, std::shared_ptr<Crypto> crypto)
+        : isOutdated_(false), createdAt_(0), contentSnapshot_(rawCard.contentSnapshot()), hasPreviousCardId_(false),
+          lazyState_(std::make_shared<LazyState>(std::move(crypto))) {
+    signatures_.reserve(rawCard.signatures().size());
+    for (auto& rawSignature : rawCard.signatures())
+        signatures_.push_back(CardSignature(rawSignature.signer(), rawSignature.signature(), rawSignature.snapshot()));
+}
+
+std::string Card::generateIdentifier(const VirgilByteArray &contentSnapshot, const std::shared_ptr<Crypto> &crypto) {
+    auto fingerprint = crypto->generateSHA512(contentSnapshot);
+
+    auto identifier = std::string(2 * IdentifierBytesLength, '0');
+    for (size_t i = 0; i < IdentifierBytesLength; ++i) {
+        identifier[2 * i] = HexAlphabet[fingerprint[i] >> 4];
+        identifier[2 * i + 1] = HexAlphabet[fingerprint[i] & 0x0f];
+    }
+
+    return identifier;
+}
+
+Card::LazyState& Card::parsedContent() const {
+    auto& lazyState = *lazyState_;
+    std::call_once(lazyState.contentOnce, [&] {
+        lazyState.content.reset(new RawCardContent(RawCardContent::parse(contentSnapshot_)));
+    });
+
+    return lazyState;
+}
+
+const std::string& Card::identifier() const {
+    if (!lazyState_)
+        return identifier_;
 
-const std::string& Card::identifier() const { return identifier_; }
+    auto& lazyState = *lazyState_;
+    std::call_once(lazyState.identifierOnce, [&] {
+        lazyState.identifier = generateIdentifier(contentSnapshot_, lazyState.crypto);
+    });
 
-const std::string& Card::identity() const { return identity_; }
+    return lazyState.identifier;
+}
 
-const PublicKey& Card::publicKey() const { return publicKey_; }
+const std::string& Card::identity() const { return lazyState_ ? parsedContent().content->identity() : identity_; }
 
-const std::string& Card::version() const { return version_; }
+const PublicKey& Card::publicKey() const {
+    if (!lazyState_)
+        return *publicKey_;
 
-std::time_t Card::createdAt() const { return createdAt_; }
+    auto& lazyState = parsedContent();
+    std::call_once(lazyState.publicKeyOnce, [&] {
+        lazyState.publicKey.reset(new PublicKey(lazyState.crypto->importPublicKey(lazyState.content->publicKey())));
+    });
+
+    return *lazyState.publicKey;
+}
+
+const std::string& Card::version() const { return lazyState_ ? parsedContent().content->version() : version_; }
+
+std::time_t Card::createdAt() const { return lazyState_ ? parsedContent().content->createdAt() : createdAt_; }
 
 const VirgilByteArray& Card::contentSnapshot() const { return contentSnapshot_; }
 
@@ -68,7 +142,9 @@ bool Card::isOutdated() const { return isOutdated_; }
 
 const std::vector<CardSignature>& Card::signatures() const { return signatures_; }
 
-const std::string& Card::previousCardId() const { return previousCardId_; }
+const std::string& Card::previousCardId() const {
+    return hasPreviousCardId_ ? previousCardId_ : parsedContent().content->previousCardId();
+}
 
 const std::shared_ptr<Card>& Card::previousCard() const { return previousCard_; }
 
@@ -82,16 +158,16 @@ void Card::isOutdated(bool newIsOutdated) {
 
 void Card::previousCardId(const std::string &newPreviousCardId) {
     previousCardId_ = newPreviousCardId;
+    hasPreviousCardId_ = true;
 }
 
 RawSignedModel Card::getRawCard() const {
     auto rawCard = RawSignedModel(contentSnapshot_);
 
     for (auto& cardSignature : signatures_) {
-        auto signature = RawSignature(cardSignature.signer(),
-                                      cardSignature.signature(),
-                                      cardSignature.snapshot());
-        rawCard.addSignature(signature);
+        rawCard.addSignature(RawSignature(cardSignature.signer(),
+                                          cardSignature.signature(),
+                                          cardSignature.snapshot()));
     }
 
     return rawCard;
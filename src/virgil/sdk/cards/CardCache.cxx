@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/cards/CardCache.h>
+
+using virgil::sdk::cards::CardCache;
+using virgil::sdk::cards::Card;
+
+namespace {
+    const std::string kCardKeyPrefix = "id:";
+    const std::string kIdentityKeyPrefix = "identity:";
+}
+
+CardCache::CardCache(size_t maxEntries, std::chrono::milliseconds ttl)
+        : maxEntries_(maxEntries), ttl_(ttl), hits_(0), misses_(0) {}
+
+std::shared_ptr<const Card> CardCache::findCard(const std::string &cardId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = find(kCardKeyPrefix + cardId);
+
+    return entry == nullptr ? nullptr : entry->card;
+}
+
+std::shared_ptr<const std::vector<Card>> CardCache::findCards(const std::string &identity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = find(kIdentityKeyPrefix + identity);
+
+    return entry == nullptr ? nullptr : entry->cards;
+}
+
+void CardCache::addCard(const Card &card) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!card.previousCardId().empty()) {
+        // Cached search results of identity may still contain superseded card
+        erase(kCardKeyPrefix + card.previousCardId());
+        erase(kIdentityKeyPrefix + card.identity());
+    }
+
+    if (card.isOutdated()) {
+        erase(kCardKeyPrefix + card.identifier());
+        erase(kIdentityKeyPrefix + card.identity());
+        return;
+    }
+
+    Entry entry;
+    entry.key = kCardKeyPrefix + card.identifier();
+    entry.card = std::make_shared<Card>(card);
+    insert(std::move(entry));
+}
+
+void CardCache::addCards(const std::string &identity, const std::vector<Card> &cards) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &card : cards) {
+        if (!card.previousCardId().empty())
+            erase(kCardKeyPrefix + card.previousCardId());
+
+        Entry entry;
+        entry.key = kCardKeyPrefix + card.identifier();
+        entry.card = std::make_shared<Card>(card);
+        insert(std::move(entry));
+    }
+
+    Entry entry;
+    entry.key = kIdentityKeyPrefix + identity;
+    entry.cards = std::make_shared<std::vector<Card>>(cards);
+    insert(std::move(entry));
+}
+
+void CardCache::invalidateCard(const std::string &cardId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    erase(kCardKeyPrefix + cardId);
+}
+
+void CardCache::invalidateIdentity(const std::string &identity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    erase(kIdentityKeyPrefix + identity);
+}
+
+void CardCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+}
+
+size_t CardCache::maxEntries() const { return maxEntries_; }
+
+std::chrono::milliseconds CardCache::ttl() const { return ttl_; }
+
+size_t CardCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t CardCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t CardCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+const CardCache::Entry* CardCache::find(const std::string &key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+
+    if (it->second->expiresAt <= std::chrono::steady_clock::now()) {
+        entries_.erase(it->second);
+        index_.erase(it);
+        ++misses_;
+        return nullptr;
+    }
+
+    // Move entry to the front as the most recently used
+    entries_.splice(entries_.begin(), entries_, it->second);
+    ++hits_;
+
+    return &entries_.front();
+}
+
+void CardCache::insert(Entry entry) {
+    if (maxEntries_ == 0)
+        return;
+
+    erase(entry.key);
+    entry.expiresAt = std::chrono::steady_clock::now() + ttl_;
+    entries_.push_front(std::move(entry));
+    index_[entries_.front().key] = entries_.begin();
+
+    while (entries_.size() > maxEntries_) {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+}
+
+void CardCache::erase(const std::string &key) {
+    auto it = index_.find(key);
+    if (it == index_.end())
+        return;
+
+    entries_.erase(it->second);
+    index_.erase(it);
+}
@@ -35,6 +35,7 @@
  */
 
 #include <map>
+#include <unordered_set>
 #include <virgil/sdk/cards/CardManager.h>
 #include <virgil/sdk/client/CardClient.h>
 #include <virgil/sdk/client/models/RawCardContent.h>
@@ -56,6 +57,8 @@ using virgil::sdk::util::JsonUtils;
 using virgil::sdk::make_error;
 using virgil::sdk::jwt::TokenContext;
 using virgil::sdk::client::networking::errors::Error;
+using virgil::sdk::executors::ExecutorInterface;
+using virgil::sdk::cards::CardCache;
 
 using virgil::sdk::jwt::interfaces::AccessTokenInterface;
 
@@ -64,11 +67,13 @@ CardManager::CardManager(std::shared_ptr<Crypto> crypto,
                          std::shared_ptr<CardVerifierInterface> cardVerifier,
                          std::function<std::future<RawSignedModel>(RawSignedModel)> signCallback,
                          std::shared_ptr<client::CardClientInterface> cardClient,
-                         bool retryOnUnauthorized)
+                         bool retryOnUnauthorized,
+                         std::shared_ptr<ExecutorInterface> executor,
+                         std::shared_ptr<CardCache> cardCache)
         : crypto_(std::move(crypto)), accessTokenProvider_(std::move(accessTokenProvider)),
           cardVerifier_(std::move(cardVerifier)), signCallback_(std::move(signCallback)),
           cardClient_(std::move(cardClient)), retryOnUnauthorized_(retryOnUnauthorized),
-          modelSigner_(ModelSigner(crypto_)) {}
+          modelSigner_(ModelSigner(crypto_)), executor_(std::move(executor)), cardCache_(std::move(cardCache)) {}
 
 RawSignedModel CardManager::generateRawCard(const PrivateKey &privateKey, const PublicKey &publicKey,
                                             const std::string& identity, const std::string &previousCardId,
@@ -92,7 +97,7 @@ RawSignedModel CardManager::generateRawCard(const std::shared_ptr<Crypto> &crypt
 }
 
 std::future<Card> CardManager::publishCard(const RawSignedModel& rawCard) const {
-    auto future = std::async([=]{
+    auto future = executor_->submit([=]{
         auto cardContent = RawCardContent::parse(rawCard.contentSnapshot());
         auto tokenContext = TokenContext("publish", "cards", cardContent.identity());
 
@@ -100,13 +105,13 @@ std::future<Card> CardManager::publishCard(const RawSignedModel& rawCard) const
 
         auto rawSignedModel = rawCard;
         if (signCallback_ != nullptr) {
-            rawSignedModel = signCallback_(rawCard).get();
+            rawSignedModel = executor_->get(signCallback_(rawCard));
         }
 
         std::function<std::future<RawSignedModel>(const std::string& token)> publishFunc = [&](const std::string& token) {
             return cardClient_->publishCard(rawSignedModel, token);
         };
-        auto publishedRawCard = tryQuery<RawSignedModel>(tokenContext, tokenFuture.get()->stringRepresentation(), publishFunc);
+        auto publishedRawCard = tryQuery<RawSignedModel>(tokenContext, executor_->get(std::move(tokenFuture))->stringRepresentation(), publishFunc);
 
         if (publishedRawCard.contentSnapshot() != rawSignedModel.contentSnapshot())
             throw make_error(VirgilSdkError::CardVerificationFailed, "Publishing returns invalid card");
@@ -121,6 +126,11 @@ std::future<Card> CardManager::publishCard(const RawSignedModel& rawCard) const
                 throw make_error(VirgilSdkError::CardVerificationFailed, "Card verification failed.");
         }
 
+        if (cardCache_ != nullptr) {
+            cardCache_->invalidateIdentity(card.identity());
+            cardCache_->addCard(card);
+        }
+
         return card;
     });
 
@@ -131,15 +141,15 @@ std::future<Card> CardManager::publishCard(const virgil::sdk::crypto::keys::Priv
                                            const virgil::sdk::crypto::keys::PublicKey &publicKey,
                                            const std::string &identity, const std::string &previousCardId,
                                            const std::unordered_map<std::string, std::string> &extraFields) const {
-    auto future = std::async([=]{
+    auto future = executor_->submit([=]{
         auto tokenContext = TokenContext("publish", "cards", identity);
-        auto token = accessTokenProvider_->getToken(tokenContext).get();
+        auto token = executor_->get(accessTokenProvider_->getToken(tokenContext));
 
         auto rawCard = generateRawCard(privateKey, publicKey, token->identity(), previousCardId, extraFields);
 
         auto rawSignedModel = rawCard;
         if (signCallback_ != nullptr) {
-            rawSignedModel = signCallback_(rawCard).get();
+            rawSignedModel = executor_->get(signCallback_(rawCard));
         }
 
         std::function<std::future<RawSignedModel>(const std::string& token)> publishFunc = [&](const std::string& token) {
@@ -160,6 +170,11 @@ std::future<Card> CardManager::publishCard(const virgil::sdk::crypto::keys::Priv
                 throw make_error(VirgilSdkError::CardVerificationFailed, "Card verification failed.");
         }
 
+        if (cardCache_ != nullptr) {
+            cardCache_->invalidateIdentity(card.identity());
+            cardCache_->addCard(card);
+        }
+
         return card;
     });
 
@@ -167,7 +182,17 @@ std::future<Card> CardManager::publishCard(const virgil::sdk::crypto::keys::Priv
 }
 
 std::future<Card> CardManager::getCard(const std::string &cardId) const {
-    auto future = std::async([=]{
+    if (cardCache_ != nullptr) {
+        auto cachedCard = cardCache_->findCard(cardId);
+        if (cachedCard != nullptr) {
+            std::promise<Card> p;
+            p.set_value(*cachedCard);
+
+            return p.get_future();
+        }
+    }
+
+    auto future = executor_->submit([=]{
         auto tokenContext = TokenContext("get", "cards");
         auto tokenFuture = accessTokenProvider_->getToken(tokenContext);
 
@@ -175,7 +200,7 @@ std::future<Card> CardManager::getCard(const std::string &cardId) const {
             return cardClient_->getCard(cardId, token);
         };
         auto getCardResponse = tryQuery<GetCardResponse>(tokenContext,
-                                                         tokenFuture.get()->stringRepresentation(),
+                                                         executor_->get(std::move(tokenFuture))->stringRepresentation(),
                                                          getFunc);
 
         auto card = parseCard(getCardResponse.rawCard());
@@ -190,14 +215,95 @@ std::future<Card> CardManager::getCard(const std::string &cardId) const {
                 throw make_error(VirgilSdkError::CardVerificationFailed, "Card verification failed.");
         }
 
+        // Outdated card is dropped from cache instead
+        if (cardCache_ != nullptr)
+            cardCache_->addCard(card);
+
         return card;
     });
 
     return future;
 }
 
+std::future<std::vector<Card>> CardManager::getCards(const std::vector<std::string> &cardIds) const {
+    auto future = executor_->submit([=]{
+        std::vector<std::shared_ptr<const Card>> cachedCards(cardIds.size());
+        std::vector<std::string> missingIds;
+        for (size_t i = 0; i < cardIds.size(); ++i) {
+            if (cardCache_ != nullptr)
+                cachedCards[i] = cardCache_->findCard(cardIds[i]);
+            if (cachedCards[i] == nullptr)
+                missingIds.push_back(cardIds[i]);
+        }
+
+        std::vector<std::future<Card>> verifiedCards;
+        if (!missingIds.empty()) {
+            auto tokenContext = TokenContext("get", "cards");
+            auto tokenFuture = accessTokenProvider_->getToken(tokenContext);
+
+            std::function<std::future<std::vector<GetCardResponse>>(const std::string& token)> getFunc = [&](const std::string& token) {
+                return cardClient_->getCards(missingIds, token);
+            };
+            auto getCardResponses = tryQuery<std::vector<GetCardResponse>>(tokenContext,
+                                                                           executor_->get(std::move(tokenFuture))->stringRepresentation(),
+                                                                           getFunc);
+
+            if (getCardResponses.size() != missingIds.size())
+                throw make_error(VirgilSdkError::CardVerificationFailed, "Get wrong cards");
+
+            for (size_t i = 0; i < getCardResponses.size(); ++i) {
+                auto cardId = missingIds[i];
+                auto getCardResponse = getCardResponses[i];
+                verifiedCards.push_back(executor_->submit([=]{
+                    auto card = parseCard(getCardResponse.rawCard());
+                    card.isOutdated(getCardResponse.isOutdated());
+
+                    if (card.identifier() != cardId) {
+                        throw make_error(VirgilSdkError::CardVerificationFailed, "Get wrong card");
+                    }
+
+                    if (cardVerifier_ != nullptr) {
+                        if (!cardVerifier_->verifyCard(card))
+                            throw make_error(VirgilSdkError::CardVerificationFailed, "Card verification failed.");
+                    }
+
+                    return card;
+                }));
+            }
+        }
+
+        auto cards = std::vector<Card>();
+        auto verifiedCard = verifiedCards.begin();
+        for (auto& cachedCard : cachedCards) {
+            if (cachedCard != nullptr) {
+                cards.push_back(*cachedCard);
+                continue;
+            }
+
+            auto card = executor_->get(std::move(*verifiedCard++));
+            if (cardCache_ != nullptr)
+                cardCache_->addCard(card);
+            cards.push_back(card);
+        }
+
+        return cards;
+    });
+
+    return future;
+}
+
 std::future<std::vector<Card>> CardManager::searchCards(const std::string &identity) const {
-    auto future = std::async([=]{
+    if (cardCache_ != nullptr) {
+        auto cachedCards = cardCache_->findCards(identity);
+        if (cachedCards != nullptr) {
+            std::promise<std::vector<Card>> p;
+            p.set_value(*cachedCards);
+
+            return p.get_future();
+        }
+    }
+
+    auto future = executor_->submit([=]{
         auto tokenContext = TokenContext("search", "cards");
         auto tokenFuture = accessTokenProvider_->getToken(tokenContext);
 
@@ -205,11 +311,10 @@ std::future<std::vector<Card>> CardManager::searchCards(const std::string &ident
             return cardClient_->searchCards(identity, token);
         };
         auto rawCards = tryQuery<std::vector<RawSignedModel>>(tokenContext,
-                                                              tokenFuture.get()->stringRepresentation(),
+                                                              executor_->get(std::move(tokenFuture))->stringRepresentation(),
                                                               searchFunc);
 
         auto cards = std::vector<Card>();
-        auto unsorted = std::map<std::string, std::shared_ptr<Card>>();
         for (auto& rawCard : rawCards) {
             auto card = parseCard(rawCard);
             if (card.identity() != identity) {
@@ -219,45 +324,120 @@ std::future<std::vector<Card>> CardManager::searchCards(const std::string &ident
                 if (!cardVerifier_->verifyCard(card))
                     throw make_error(VirgilSdkError::CardVerificationFailed, "Card verification failed.");
             }
-            unsorted[card.identifier()] = std::make_shared<Card>(card);
-            cards.push_back(parseCard(rawCard));
+            cards.push_back(card);
         }
 
-        for (auto& card : cards) {
-            if (unsorted.find(card.previousCardId()) != unsorted.end()) {
-                unsorted[card.previousCardId()]->isOutdated(true);
-                card.previousCard(unsorted[card.previousCardId()]);
-                unsorted.erase(card.previousCardId());
+        cards = linkCards(cards);
+
+        if (cardCache_ != nullptr)
+            cardCache_->addCards(identity, cards);
+
+        return cards;
+    });
+
+    return future;
+}
+
+std::future<std::unordered_map<std::string, std::vector<Card>>> CardManager::searchCards(
+        const std::vector<std::string> &identities) const {
+    auto future = executor_->submit([=]{
+        auto result = std::unordered_map<std::string, std::vector<Card>>();
+        auto missingIdentities = std::vector<std::string>();
+        for (auto& identity : identities) {
+            if (result.find(identity) != result.end())
+                continue;
+
+            auto cachedCards = cardCache_ != nullptr ? cardCache_->findCards(identity) : nullptr;
+            if (cachedCards != nullptr) {
+                result[identity] = *cachedCards;
+            } else {
+                result[identity] = std::vector<Card>();
+                missingIdentities.push_back(identity);
             }
         }
 
-        for (auto card = cards.begin(); card != cards.end(); card++) {
-            if (unsorted.find(card->identifier()) == unsorted.end()) {
-                cards.erase(card);
-                card--;
+        if (missingIdentities.empty())
+            return result;
+
+        auto tokenContext = TokenContext("search", "cards");
+        auto tokenFuture = accessTokenProvider_->getToken(tokenContext);
+
+        std::function<std::future<std::vector<RawSignedModel>>(const std::string& token)> searchFunc = [&](const std::string& token) {
+            return cardClient_->searchCards(missingIdentities, token);
+        };
+        auto rawCards = tryQuery<std::vector<RawSignedModel>>(tokenContext,
+                                                              executor_->get(std::move(tokenFuture))->stringRepresentation(),
+                                                              searchFunc);
+
+        auto verifiedCards = std::vector<std::future<Card>>();
+        for (auto& rawCard : rawCards) {
+            verifiedCards.push_back(executor_->submit([=]{
+                auto card = parseCard(rawCard);
+                if (cardVerifier_ != nullptr) {
+                    if (!cardVerifier_->verifyCard(card))
+                        throw make_error(VirgilSdkError::CardVerificationFailed, "Card verification failed.");
+                }
+
+                return card;
+            }));
+        }
+
+        auto requestedIdentities = std::unordered_set<std::string>(missingIdentities.begin(), missingIdentities.end());
+        auto foundCards = std::unordered_map<std::string, std::vector<Card>>();
+        for (auto& verifiedCard : verifiedCards) {
+            auto card = executor_->get(std::move(verifiedCard));
+            if (requestedIdentities.find(card.identity()) == requestedIdentities.end()) {
+                throw make_error(VirgilSdkError::CardVerificationFailed, "Get wrong card");
             }
+            foundCards[card.identity()].push_back(card);
         }
 
-        return cards;
+        for (auto& identity : missingIdentities) {
+            result[identity] = linkCards(foundCards[identity]);
+
+            if (cardCache_ != nullptr)
+                cardCache_->addCards(identity, result[identity]);
+        }
+
+        return result;
     });
 
     return future;
 }
 
+std::vector<Card> CardManager::linkCards(std::vector<Card> cards) const {
+    auto unsorted = std::map<std::string, std::shared_ptr<Card>>();
+    for (auto& card : cards)
+        unsorted[card.identifier()] = std::make_shared<Card>(card);
+
+    for (auto& card : cards) {
+        if (unsorted.find(card.previousCardId()) != unsorted.end()) {
+            unsorted[card.previousCardId()]->isOutdated(true);
+            card.previousCard(unsorted[card.previousCardId()]);
+            unsorted.erase(card.previousCardId());
+        }
+    }
+
+    auto actualCards = std::vector<Card>();
+    for (auto& card : cards) {
+        if (unsorted.find(card.identifier()) != unsorted.end())
+            actualCards.push_back(card);
+    }
+
+    return actualCards;
+}
+
 template<typename T>
 T CardManager::tryQuery(const virgil::sdk::jwt::TokenContext &tokenContext, const std::string &token,
                         std::function<std::future<T>(const std::string &)> query) const {
     try {
-        auto futureResponse = query(token);
-
-        return futureResponse.get();
+        return executor_->get(query(token));
     } catch (Error& error) {
         if (error.httpErrorCode() == 401 && retryOnUnauthorized_) {
             auto newTokenContext = TokenContext(tokenContext.operation(), "cards", tokenContext.identity(), true);
-            auto newTokenFuture = accessTokenProvider_->getToken(newTokenContext);
-            auto newFutureResponse = query(newTokenFuture.get()->stringRepresentation());
+            auto newToken = executor_->get(accessTokenProvider_->getToken(newTokenContext));
 
-            return newFutureResponse.get();
+            return executor_->get(query(newToken->stringRepresentation()));
         } else
             throw make_error(VirgilSdkError::ServiceQueryFailed, error.errorMsg());
     }
@@ -267,23 +447,21 @@ Card CardManager::parseCard(const RawSignedModel &model, const std::shared_ptr<C
     auto rawCardContent = RawCardContent::parse(model.contentSnapshot());
 
     auto publicKey = crypto->importPublicKey(rawCardContent.publicKey());
-    auto fingerprint = crypto->generateSHA512(model.contentSnapshot());
-    fingerprint.resize(32);
-    auto cardId = VirgilByteArrayUtils::bytesToHex(fingerprint);
+    auto cardId = Card::generateIdentifier(model.contentSnapshot(), crypto);
 
     auto cardSignatures = std::vector<CardSignature>();
+    cardSignatures.reserve(model.signatures().size());
     for (auto& rawSignature : model.signatures()) {
         auto extraFields = std::unordered_map<std::string, std::string>();
         if (!rawSignature.snapshot().empty())
             extraFields = JsonUtils::bytesToUnorderedMap(rawSignature.snapshot());
 
-        auto cardSignature = CardSignature(rawSignature.signer(), rawSignature.signature(),
-                                           rawSignature.snapshot(), extraFields);
-        cardSignatures.push_back(cardSignature);
+        cardSignatures.emplace_back(rawSignature.signer(), rawSignature.signature(),
+                                    rawSignature.snapshot(), std::move(extraFields));
     }
 
     return Card(cardId, rawCardContent.identity(), publicKey, rawCardContent.version(),
-                rawCardContent.createdAt(), model.contentSnapshot(), false, cardSignatures,
+                rawCardContent.createdAt(), model.contentSnapshot(), false, std::move(cardSignatures),
                 rawCardContent.previousCardId());
 }
 
@@ -291,6 +469,10 @@ Card CardManager::parseCard(const RawSignedModel &model) const {
     return CardManager::parseCard(model, crypto_);
 }
 
+Card CardManager::parseCardLazily(const RawSignedModel &model, const std::shared_ptr<Crypto>& crypto) {
+    return Card(model, crypto);
+}
+
 Card CardManager::importCardFromBase64(const std::string &base64) const {
     auto rawCard = RawSignedModel::importFromBase64EncodedString(base64);
 
@@ -351,4 +533,8 @@ const std::shared_ptr<CardClientInterface> & CardManager::cardClient() const { r
 
 const std::function<std::future<RawSignedModel>(RawSignedModel)>& CardManager::signCallback() const { return signCallback_; }
 
-bool CardManager::retryOnUnauthorized() const { return retryOnUnauthorized_; }
\ No newline at end of file
+bool CardManager::retryOnUnauthorized() const { return retryOnUnauthorized_; }
+
+const std::shared_ptr<ExecutorInterface>& CardManager::executor() const { return executor_; }
+
+const std::shared_ptr<CardCache>& CardManager::cardCache() const { return cardCache_; }
\ No newline at end of file
@@ -35,19 +35,33 @@
  */
 
 #include <virgil/sdk/cards/CardSignature.h>
+#include <virgil/sdk/util/JsonUtils.h>
 
 using virgil::sdk::cards::CardSignature;
 using virgil::sdk::VirgilByteArray;
+using virgil::sdk::util::JsonUtils;
 
 CardSignature::CardSignature(std::string signer, VirgilByteArray signature, VirgilByteArray snapshot,
                              std::unordered_map<std::string, std::string> extraFields)
         : signer_(std::move(signer)), signature_(std::move(signature)),
           snapshot_(std::move(snapshot)), extraFields_(std::move(extraFields)) {}
 
+CardSignature::CardSignature(std::string signer, VirgilByteArray signature, VirgilByteArray snapshot)
+        : signer_(std::move(signer)), signature_(std::move(signature)), snapshot_(std::move(snapshot)),
+          lazyExtraFields_(snapshot_.empty() ? nullptr : std::make_shared<LazyExtraFields>()) {}
+
 const std::string& CardSignature::signer() const { return signer_; }
 
 const VirgilByteArray& CardSignature::signature() const { return signature_; }
 
 const VirgilByteArray& CardSignature::snapshot() const { return snapshot_; }
 
-const std::unordered_map<std::string, std::string>& CardSignature::extraFields() const { return extraFields_; }
\ No newline at end of file
+const std::unordered_map<std::string, std::string>& CardSignature::extraFields() const {
+    if (!lazyExtraFields_)
+        return extraFields_;
+
+    auto& lazy = *lazyExtraFields_;
+    std::call_once(lazy.once, [&] { lazy.extraFields = JsonUtils::bytesToUnorderedMap(snapshot_); });
+
+    return lazy.extraFields;
+}
\ No newline at end of file
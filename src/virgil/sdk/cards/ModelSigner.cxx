@@ -65,9 +65,7 @@ void ModelSigner::sign(RawSignedModel &model, const std::string &signer, const P
     VirgilByteArrayUtils::append(combinedSnapshot, additionalData);
 
     auto signature = crypto_->generateSignature(combinedSnapshot, privateKey);
-    auto rawSignature = RawSignature(signer, signature, additionalData);
-
-    model.addSignature(rawSignature);
+    model.addSignature(RawSignature(signer, std::move(signature), additionalData));
 }
 
 void ModelSigner::selfSign(RawSignedModel &model, const PrivateKey &privateKey) const {
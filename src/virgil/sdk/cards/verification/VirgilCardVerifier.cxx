@@ -34,29 +34,158 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
+#include <algorithm>
+#include <atomic>
 #include <virgil/sdk/cards/verification/VirgilCardVerifier.h>
+#include <virgil/sdk/executors/ExecutorUtils.h>
 
 using virgil::sdk::cards::verification::VirgilCardVerifier;
 using virgil::sdk::cards::Card;
+using virgil::sdk::cards::CardSignature;
 using virgil::sdk::crypto::Crypto;
 using virgil::sdk::crypto::keys::PublicKey;
+using virgil::sdk::VirgilByteArray;
 using virgil::sdk::VirgilByteArrayUtils;
 using virgil::sdk::cards::verification::Whitelist;
+using virgil::sdk::executors::ExecutorInterface;
+using virgil::sdk::executors::ExecutorUtils;
 
 const std::string VirgilCardVerifier::selfSignerIdentifier_ = "self";
 const std::string VirgilCardVerifier::virgilSignerIdentifier_ = "virgil";
 const std::string VirgilCardVerifier::virgilPublicKeyBase64_ = "MCowBQYDK2VwAyEAljOYGANYiVq1WbvVvoYIKtvZi2ji9bAhxyu6iV/LF8M=";
 
 VirgilCardVerifier::VirgilCardVerifier(std::shared_ptr<Crypto> crypto, std::vector<Whitelist> whitelists,
-                                       bool verifySelfSignature, bool verifyVirgilSignature)
-        : crypto_(std::move(crypto)), whitelists_(std::move(whitelists)),
-          verifySelfSignature_(verifySelfSignature), verifyVirgilSignature_(verifyVirgilSignature),
-          virgilPublicKey_(crypto->importPublicKey(VirgilBase64::decode(virgilPublicKeyBase64_))) {}
+                                       bool verifySelfSignature, bool verifyVirgilSignature,
+                                       bool verifyConcurrently, std::shared_ptr<ExecutorInterface> executor)
+        : verifySelfSignature_(verifySelfSignature), verifyVirgilSignature_(verifyVirgilSignature),
+          virgilPublicKey_(crypto->importPublicKey(VirgilBase64::decode(virgilPublicKeyBase64_))),
+          crypto_(std::move(crypto)), whitelists_(std::move(whitelists)),
+          whitelistsPublicKeys_(importWhitelists(crypto_, whitelists_)),
+          verifyConcurrently_(verifyConcurrently), executor_(std::move(executor)) {}
+
+std::vector<std::unordered_multimap<std::string, PublicKey>> VirgilCardVerifier::importWhitelists(
+        const std::shared_ptr<Crypto> &crypto, const std::vector<Whitelist> &whitelists) {
+    auto whitelistsPublicKeys = std::vector<std::unordered_multimap<std::string, PublicKey>>();
+    for (const auto& whitelist : whitelists) {
+        auto publicKeys = std::unordered_multimap<std::string, PublicKey>();
+        // Signer may be listed several times, e.g. during key rotation
+        for (const auto& credentials : whitelist.verifierCredentials())
+            publicKeys.insert(std::make_pair(credentials.signer(), crypto->importPublicKey(credentials.publicKey())));
+        whitelistsPublicKeys.push_back(std::move(publicKeys));
+    }
+
+    return whitelistsPublicKeys;
+}
 
 bool VirgilCardVerifier::verifyCard(const Card &card) const {
+    if (!verifyConcurrently_)
+        return verifySequentially(card);
+
+    auto checks = std::vector<std::function<bool()>>();
+    if (verifySelfSignature_)
+        checks.push_back([this, &card] { return verifySelf(card); });
+    if (verifyVirgilSignature_)
+        checks.push_back([this, &card] { return verifyVirgil(card); });
+    for (const auto& publicKeys : whitelistsPublicKeys_)
+        checks.push_back([this, &card, &publicKeys] { return verifyWhitelist(card, publicKeys); });
+
+    return verifyAll(checks);
+}
+
+bool VirgilCardVerifier::verifyCards(const std::vector<Card> &cards) const {
+    // Each rule of each Card is satisfied by any of its candidate signatures,
+    // candidates of all Cards are verified with single batch
+    struct Candidate {
+        const Card &card;
+        const CardSignature &signature;
+        const PublicKey &signerPublicKey;
+        size_t rule;
+    };
+
+    auto candidates = std::vector<Candidate>();
+    size_t rulesCount = 0;
+    auto addSignerRule = [&](const Card &card, const std::string &signer, const PublicKey &signerPublicKey) {
+        for (const auto& signature : card.signatures()) {
+            if (signature.signer() == signer) {
+                candidates.push_back(Candidate { card, signature, signerPublicKey, rulesCount });
+                break;
+            }
+        }
+        ++rulesCount;
+    };
+
+    for (const auto& card : cards) {
+        if (verifySelfSignature_)
+            addSignerRule(card, selfSignerIdentifier_, card.publicKey());
+        if (verifyVirgilSignature_)
+            addSignerRule(card, virgilSignerIdentifier_, virgilPublicKey_);
+        for (const auto& publicKeys : whitelistsPublicKeys_) {
+            for (const auto& signature : card.signatures()) {
+                auto range = publicKeys.equal_range(signature.signer());
+                for (auto publicKey = range.first; publicKey != range.second; ++publicKey)
+                    candidates.push_back(Candidate { card, signature, publicKey->second, rulesCount });
+            }
+            ++rulesCount;
+        }
+    }
+
+    auto snapshots = std::vector<VirgilByteArray>();
+    snapshots.reserve(candidates.size());
+    for (const auto& candidate : candidates)
+        snapshots.push_back(snapshot(candidate.card, candidate.signature));
+
+    auto items = std::vector<Crypto::VerificationItem>();
+    items.reserve(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+        items.emplace_back(snapshots[i], candidates[i].signature.signature(), candidates[i].signerPublicKey);
+
+    auto results = crypto_->verifyBatch(items, executor_);
+
+    auto satisfiedRules = std::vector<bool>(rulesCount, false);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (results[i])
+            satisfiedRules[candidates[i].rule] = true;
+    }
+
+    return std::find(satisfiedRules.begin(), satisfiedRules.end(), false) == satisfiedRules.end();
+}
+
+bool VirgilCardVerifier::verifySequentially(const Card &card) const {
     return verifySelf(card) && verifyVirgil(card) && verifyWhitelists(card);
 }
 
+bool VirgilCardVerifier::verifyAll(const std::vector<std::function<bool()>> &checks) const {
+    // Checks which haven't started yet are skipped after first failure
+    std::atomic<bool> failed(false);
+    auto runChecks = [&checks, &failed](size_t begin, size_t end) {
+        auto results = std::vector<bool>();
+        results.reserve(end - begin);
+        for (auto i = begin; i < end; ++i) {
+            if (failed) {
+                results.push_back(false);
+                continue;
+            }
+
+            try {
+                auto result = checks[i]();
+                if (!result)
+                    failed = true;
+
+                results.push_back(result);
+            } catch (...) {
+                failed = true;
+                throw;
+            }
+        }
+
+        return results;
+    };
+
+    auto results = ExecutorUtils::mapChunks(executor_, checks.size(), runChecks);
+
+    return std::find(results.begin(), results.end(), false) == results.end();
+}
+
 bool VirgilCardVerifier::verifySelf(const virgil::sdk::cards::Card &card) const {
     if (verifySelfSignature_)
         return verify(card, selfSignerIdentifier_, card.publicKey());
@@ -72,37 +201,51 @@ bool VirgilCardVerifier::verifyVirgil(const virgil::sdk::cards::Card &card) cons
 }
 
 bool VirgilCardVerifier::verifyWhitelists(const virgil::sdk::cards::Card &card) const {
-    for (const auto& whitelist : whitelists_) {
-        bool result = false;
-        for (auto& credentials : whitelist.verifierCredentials()) {
-            for (auto &signature : card.signatures()) {
-                if (signature.signer() == credentials.signer()) {
-                    auto publicKey = crypto_->importPublicKey(credentials.publicKey());
-                    result = verify(card, credentials.signer(), publicKey);
-                }
-            }
-        }
-        if (!result)
+    for (const auto& publicKeys : whitelistsPublicKeys_) {
+        if (!verifyWhitelist(card, publicKeys))
             return false;
     }
 
     return true;
 }
 
-bool VirgilCardVerifier::verify(const virgil::sdk::cards::Card &card, const std::string &signer,
-                                const PublicKey &signerPublicKey) const {
+bool VirgilCardVerifier::verifyWhitelist(const Card &card,
+                                         const std::unordered_multimap<std::string, PublicKey> &publicKeys) const {
+    // Card should contain signature of at least one signer from whitelist valid for any of signer's keys
     for (auto& signature : card.signatures()) {
-        if (signature.signer() == signer) {
-            auto cardSnapshot = card.getRawCard().contentSnapshot();
-            VirgilByteArrayUtils::append(cardSnapshot, signature.snapshot());
+        auto range = publicKeys.equal_range(signature.signer());
+        if (range.first == range.second)
+            continue;
 
-            return crypto_->verify(cardSnapshot, signature.signature(), signerPublicKey);
+        auto signatureSnapshot = snapshot(card, signature);
+        for (auto publicKey = range.first; publicKey != range.second; ++publicKey) {
+            if (crypto_->verify(signatureSnapshot, signature.signature(), publicKey->second))
+                return true;
         }
     }
 
     return false;
 }
 
+bool VirgilCardVerifier::verify(const virgil::sdk::cards::Card &card, const std::string &signer,
+                                const PublicKey &signerPublicKey) const {
+    for (auto& signature : card.signatures()) {
+        if (signature.signer() == signer)
+            return crypto_->verify(snapshot(card, signature), signature.signature(), signerPublicKey);
+    }
+
+    return false;
+}
+
+VirgilByteArray VirgilCardVerifier::snapshot(const Card &card, const CardSignature &signature) {
+    auto cardSnapshot = VirgilByteArray();
+    cardSnapshot.reserve(card.contentSnapshot().size() + signature.snapshot().size());
+    VirgilByteArrayUtils::append(cardSnapshot, card.contentSnapshot());
+    VirgilByteArrayUtils::append(cardSnapshot, signature.snapshot());
+
+    return cardSnapshot;
+}
+
 const std::shared_ptr<Crypto>& VirgilCardVerifier::crypto() const { return crypto_; }
 
 const PublicKey VirgilCardVerifier::virgilPublicKey() const { return virgilPublicKey_; }
@@ -111,4 +254,8 @@ const std::vector<Whitelist>& VirgilCardVerifier::whitelists() const { return wh
 
 bool VirgilCardVerifier::verifySelfSignature() const { return verifySelfSignature_; }
 
-bool VirgilCardVerifier::verifyVirgilSignature() const { return verifyVirgilSignature_; }
\ No newline at end of file
+bool VirgilCardVerifier::verifyVirgilSignature() const { return verifyVirgilSignature_; }
+
+bool VirgilCardVerifier::verifyConcurrently() const { return verifyConcurrently_; }
+
+const std::shared_ptr<ExecutorInterface>& VirgilCardVerifier::executor() const { return executor_; }
\ No newline at end of file
@@ -34,25 +34,39 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
 #include <unordered_map>
 #include <virgil/sdk/client/CardClient.h>
 #include <virgil/sdk/client/networking/ClientRequest.h>
 #include <virgil/sdk/client/networking/CardEndpointUri.h>
 #include <virgil/sdk/serialization/JsonSerializer.h>
 #include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 #include <virgil/sdk/client/networking/Connection.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
 #include <virgil/sdk/client/networking/Response.h>
 #include <virgil/sdk/VirgilSdkError.h>
 #include <virgil/sdk/client/networking/errors/VirgilError.h>
+#include <virgil/sdk/executors/DelayedTaskScheduler.h>
 #include <virgil/sdk/util/JsonUtils.h>
 
 using virgil::sdk::client::CardClient;
+using virgil::sdk::client::HedgingPolicy;
+using virgil::sdk::client::RetryPolicy;
 using virgil::sdk::client::models::RawSignedModel;
 using virgil::sdk::client::networking::ClientRequest;
 using virgil::sdk::client::networking::CardEndpointUri;
 using virgil::sdk::serialization::JsonSerializer;
 using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::serialization::JsonStreamDeserializer;
 using virgil::sdk::client::networking::Connection;
+using virgil::sdk::client::networking::AsyncConnection;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::executors::DelayedTaskScheduler;
+using virgil::sdk::executors::ExecutorInterface;
 using virgil::sdk::client::networking::Response;
 using virgil::sdk::client::networking::errors::Error;
 using virgil::sdk::client::networking::errors::VirgilError;
@@ -61,11 +75,95 @@ using virgil::sdk::client::models::GetCardResponse;
 
 const std::string CardClient::xVirgilIsSuperseededKey = "X-Virgil-Is-Superseeded";
 
-CardClient::CardClient(std::string serviceUrl)
-        : serviceUrl_(std::move(serviceUrl)) {}
+const size_t CardClient::maxIdentitiesPerSearch = 50;
+
+namespace {
+    std::chrono::milliseconds elapsedSince(std::chrono::steady_clock::time_point startedAt) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startedAt);
+    }
+
+    struct HedgedRequest {
+        std::mutex mutex;
+        bool completed = false;
+        size_t pending = 1;
+        std::shared_ptr<std::atomic<bool>> cancellationFlags[2];
+        std::chrono::steady_clock::time_point startedAt;
+        AsyncConnection::Callback callback;
+    };
+
+    void sendWithRetries(std::shared_ptr<Connection> connection, std::shared_ptr<RetryPolicy> retryPolicy,
+                         std::shared_ptr<ExecutorInterface> executor, Request request,
+                         AsyncConnection::Callback callback, size_t attempt,
+                         std::chrono::steady_clock::time_point startedAt) {
+        executor->execute([=] {
+            std::exception_ptr error;
+            Response response;
+            try {
+                response = connection->send(retryPolicy->attemptRequest(request, elapsedSince(startedAt)));
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            auto delay = std::chrono::milliseconds(0);
+            if (!retryPolicy->shouldRetry(request, error, response, attempt, elapsedSince(startedAt), delay)) {
+                callback(error, std::move(response));
+                return;
+            }
+
+            // Backoff is waited on timer, so executor thread is free to run other tasks meanwhile
+            DelayedTaskScheduler::defaultScheduler()->schedule(delay, [=] {
+                try {
+                    sendWithRetries(connection, retryPolicy, executor, request, callback, attempt + 1, startedAt);
+                } catch (...) {
+                    callback(std::current_exception(), Response());
+                }
+            });
+        });
+    }
+
+    void sendWithRetries(std::shared_ptr<AsyncConnection> connection, std::shared_ptr<RetryPolicy> retryPolicy,
+                         Request request, AsyncConnection::Callback callback, size_t attempt,
+                         std::chrono::steady_clock::time_point startedAt) {
+        auto attemptRequest = retryPolicy->attemptRequest(request, elapsedSince(startedAt));
+        // Callback runs on connection thread, so it must not own the connection
+        std::weak_ptr<AsyncConnection> weakConnection = connection;
+        connection->sendAsync(attemptRequest, [=](std::exception_ptr error, Response response) {
+            auto delay = std::chrono::milliseconds(0);
+            if (!retryPolicy->shouldRetry(request, error, response, attempt, elapsedSince(startedAt), delay)) {
+                callback(error, std::move(response));
+                return;
+            }
+
+            // Backoff is waited on timer, so neither connection nor executor thread is blocked by it
+            DelayedTaskScheduler::defaultScheduler()->schedule(delay, [=] {
+                auto connection = weakConnection.lock();
+                if (!connection) {
+                    callback(std::make_exception_ptr(std::runtime_error("HTTP connection is closed.")), Response());
+                    return;
+                }
+                sendWithRetries(connection, retryPolicy, request, callback, attempt + 1, startedAt);
+            });
+        });
+    }
+}
+
+CardClient::CardClient(std::string serviceUrl, std::shared_ptr<Connection> connection,
+                       std::shared_ptr<ExecutorInterface> executor, std::shared_ptr<RetryPolicy> retryPolicy,
+                       std::shared_ptr<HedgingPolicy> hedgingPolicy)
+        : serviceUrl_(std::move(serviceUrl)), connection_(std::move(connection)), executor_(std::move(executor)),
+          asyncConnection_(std::dynamic_pointer_cast<AsyncConnection>(connection_)),
+          retryPolicy_(std::move(retryPolicy)), hedgingPolicy_(std::move(hedgingPolicy)) {}
 
 const std::string& CardClient::serviceUrl() const { return serviceUrl_; }
 
+const std::shared_ptr<Connection>& CardClient::connection() const { return connection_; }
+
+const std::shared_ptr<ExecutorInterface>& CardClient::executor() const { return executor_; }
+
+const std::shared_ptr<RetryPolicy>& CardClient::retryPolicy() const { return retryPolicy_; }
+
+const std::shared_ptr<HedgingPolicy>& CardClient::hedgingPolicy() const { return hedgingPolicy_; }
+
 Error CardClient::parseError(const Response &response) const {
     try {
         auto virgilError = JsonDeserializer<VirgilError>::fromJsonString(response.body());
@@ -76,47 +174,226 @@ Error CardClient::parseError(const Response &response) const {
     }
 }
 
-std::future<RawSignedModel> CardClient::publishCard(const RawSignedModel &model, const std::string &token) const {
-    auto future = std::async([=]{
-        ClientRequest httpRequest = ClientRequest(token);
-        httpRequest
-                .post()
-                .baseAddress(this->serviceUrl_)
-                .endpoint(CardEndpointUri::publish())
-                .body(JsonSerializer<RawSignedModel>::toJson(model));
+Response CardClient::send(const Request &request) const {
+    return connection_->send(request);
+}
+
+void CardClient::sendAsync(const Request &request, AsyncConnection::Callback callback) const {
+    sendAsync(connection_, asyncConnection_, retryPolicy_, executor_, request, std::move(callback));
+}
+
+void CardClient::sendAsync(const std::shared_ptr<Connection> &connection,
+                           const std::shared_ptr<AsyncConnection> &asyncConnection,
+                           const std::shared_ptr<RetryPolicy> &retryPolicy,
+                           const std::shared_ptr<ExecutorInterface> &executor,
+                           const Request &request, AsyncConnection::Callback callback) {
+    if (!retryPolicy && !asyncConnection) {
+        executor->execute([connection, request, callback] {
+            std::exception_ptr error;
+            Response response;
+            try {
+                response = connection->send(request);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            callback(error, std::move(response));
+        });
+        return;
+    }
+
+    if (!retryPolicy) {
+        asyncConnection->sendAsync(request, std::move(callback));
+        return;
+    }
+
+    retryPolicy->requestStarted();
+    if (!asyncConnection) {
+        sendWithRetries(connection, retryPolicy, executor, request, std::move(callback), 1,
+                        std::chrono::steady_clock::now());
+        return;
+    }
+
+    sendWithRetries(asyncConnection, retryPolicy, request, std::move(callback), 1, std::chrono::steady_clock::now());
+}
+
+void CardClient::sendHedged(const Request &request, AsyncConnection::Callback callback) const {
+    auto hedgingPolicy = hedgingPolicy_.get();
+    auto hedgedRequest = std::make_shared<HedgedRequest>();
+    hedgedRequest->cancellationFlags[0] = std::make_shared<std::atomic<bool>>(false);
+    hedgedRequest->cancellationFlags[1] = std::make_shared<std::atomic<bool>>(false);
+    hedgedRequest->startedAt = std::chrono::steady_clock::now();
+    hedgedRequest->callback = std::move(callback);
+
+    // Requests may complete after client and policy are destroyed, connection and executor are shared
+    std::weak_ptr<HedgingPolicy> weakHedgingPolicy = hedgingPolicy_;
+    auto complete = [hedgedRequest, weakHedgingPolicy](size_t index, std::exception_ptr error, Response response) {
+        {
+            std::lock_guard<std::mutex> lock(hedgedRequest->mutex);
+            --hedgedRequest->pending;
+            if (hedgedRequest->completed)
+                return;
+
+            // Failure is reported only if other request can't succeed anymore
+            auto succeeded = !error && !RetryPolicy::isRetryable(response);
+            if (!succeeded && hedgedRequest->pending > 0)
+                return;
+
+            hedgedRequest->completed = true;
+            *hedgedRequest->cancellationFlags[1 - index] = true;
+            auto hedgingPolicy = weakHedgingPolicy.lock();
+            if (succeeded && hedgingPolicy) {
+                // Latency is rounded up, so hedge delay doesn't fall below typical latency
+                auto latency = std::chrono::steady_clock::now() - hedgedRequest->startedAt + std::chrono::microseconds(999);
+                hedgingPolicy->requestCompleted(std::chrono::duration_cast<std::chrono::milliseconds>(latency),
+                                                index == 1);
+            }
+        }
+        hedgedRequest->callback(error, std::move(response));
+    };
+
+    hedgingPolicy->requestStarted();
+    auto hedgeDelay = std::chrono::milliseconds(0);
+    auto canHedge = hedgingPolicy->hedgeDelay(hedgeDelay);
+
+    auto primary = request;
+    primary.cancellationFlag(hedgedRequest->cancellationFlags[0]);
+    sendAsync(primary, [complete](std::exception_ptr error, Response response) {
+        complete(0, error, std::move(response));
+    });
 
-        Connection connection;
-        Response response = connection.send(httpRequest);
+    if (!canHedge)
+        return;
 
+    auto hedge = request;
+    hedge.cancellationFlag(hedgedRequest->cancellationFlags[1]);
+    // Hedge may outlive the client, so it holds everything it needs. Policy is not owned,
+    // since hedge runs on policy's own timer thread, which is stopped by policy destructor
+    auto connection = connection_;
+    auto asyncConnection = asyncConnection_;
+    auto retryPolicy = retryPolicy_;
+    auto executor = executor_;
+    hedgingPolicy->schedule(hedgeDelay, [=] {
+        {
+            std::lock_guard<std::mutex> lock(hedgedRequest->mutex);
+            if (hedgedRequest->completed || !hedgingPolicy->tryHedge())
+                return;
+            ++hedgedRequest->pending;
+        }
+        sendAsync(connection, asyncConnection, retryPolicy, executor, hedge,
+                  [complete](std::exception_ptr error, Response response) {
+            complete(1, error, std::move(response));
+        });
+    });
+}
+
+template<typename T>
+std::future<T> CardClient::query(const Request &request, std::function<T(const Response &)> handleResponse,
+                                 bool hedged) const {
+    hedged = hedged && hedgingPolicy_;
+    // Retries are scheduled as separate tasks, so blocking connection is used directly only without them
+    if (!asyncConnection_ && !retryPolicy_ && !hedged) {
+        return executor_->submit([=]{
+            return handleResponse(this->send(request));
+        });
+    }
+
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future = promise->get_future();
+    auto executor = executor_;
+
+    auto callback = [promise, executor, handleResponse](std::exception_ptr error, Response response) {
+        if (error) {
+            promise->set_exception(error);
+            return;
+        }
+
+        // Parsing is moved off the connection thread, so it only drives transfers
+        executor->execute([promise, handleResponse, response] {
+            try {
+                promise->set_value(handleResponse(response));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    };
+
+    if (hedged)
+        sendHedged(request, callback);
+    else
+        sendAsync(request, callback);
+
+    return future;
+}
+
+std::future<RawSignedModel> CardClient::publishCard(const RawSignedModel &model, const std::string &token) const {
+    ClientRequest httpRequest = ClientRequest(token);
+    httpRequest
+            .post()
+            .baseAddress(serviceUrl_)
+            .endpoint(CardEndpointUri::publish())
+            .body(JsonSerializer<RawSignedModel>::toJson(model));
+
+    return query<RawSignedModel>(httpRequest, [this](const Response &response) {
         if (response.fail())
             throw this->parseError(response);
 
-        auto rawCard = JsonDeserializer<RawSignedModel>::fromJsonString(response.body());
+        auto rawCard = JsonStreamDeserializer<RawSignedModel>::fromJsonString(response.body());
 
         return rawCard;
     });
-
-    return future;
 }
 
 std::future<std::vector<RawSignedModel>> CardClient::searchCards(const std::string &identity,
                                                                  const std::string &token) const {
-    auto future = std::async([=]{
+    ClientRequest httpRequest = ClientRequest(token);
+    std::unordered_map<std::string, std::string> bodyMap = { std::make_pair("identity", identity) };
+    httpRequest
+            .post()
+            .baseAddress(serviceUrl_)
+            .endpoint(CardEndpointUri::search())
+            .body(JsonUtils::unorderedMapToJson(bodyMap).dump());
+
+    return query<std::vector<RawSignedModel>>(httpRequest, [this](const Response &response) {
+        if (response.fail())
+            throw this->parseError(response);
+
+        auto rawCards = JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(response.body());
+
+        return rawCards;
+    }, true);
+}
+
+std::future<std::vector<RawSignedModel>> CardClient::searchCards(const std::vector<std::string> &identities,
+                                                                 const std::string &token) const {
+    auto futures = std::make_shared<std::vector<std::future<std::vector<RawSignedModel>>>>();
+    for (size_t offset = 0; offset < identities.size(); offset += maxIdentitiesPerSearch) {
+        auto end = identities.begin() + std::min(identities.size(), offset + maxIdentitiesPerSearch);
+        auto chunk = std::vector<std::string>(identities.begin() + offset, end);
+
         ClientRequest httpRequest = ClientRequest(token);
-        std::unordered_map<std::string, std::string> bodyMap = { std::make_pair("identity", identity) };
+        nlohmann::json body = { { "identities", chunk } };
         httpRequest
                 .post()
-                .baseAddress(this->serviceUrl_)
+                .baseAddress(serviceUrl_)
                 .endpoint(CardEndpointUri::search())
-                .body(JsonUtils::unorderedMapToJson(bodyMap).dump());
+                .body(body.dump());
 
-        Connection connection;
-        Response response = connection.send(httpRequest);
+        futures->push_back(query<std::vector<RawSignedModel>>(httpRequest, [this](const Response &response) {
+            if (response.fail())
+                throw this->parseError(response);
 
-        if (response.fail())
-            throw this->parseError(response);
+            auto rawCards = JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(response.body());
 
-        auto rawCards = JsonDeserializer<std::vector<RawSignedModel>>::fromJsonString(response.body());
+            return rawCards;
+        }, true));
+    }
+
+    auto future = executor_->submit([=]{
+        std::vector<RawSignedModel> rawCards;
+        for (auto& chunkFuture : *futures) {
+            auto chunkRawCards = executor_->get(std::move(chunkFuture));
+            rawCards.insert(rawCards.end(), chunkRawCards.begin(), chunkRawCards.end());
+        }
 
         return rawCards;
     });
@@ -125,20 +402,17 @@ std::future<std::vector<RawSignedModel>> CardClient::searchCards(const std::stri
 }
 
 std::future<GetCardResponse> CardClient::getCard(const std::string &cardId, const std::string &token) const {
-    auto future = std::async([=]{
-        ClientRequest httpRequest = ClientRequest(token);
-        httpRequest
-                .get()
-                .baseAddress(this->serviceUrl_)
-                .endpoint(CardEndpointUri::get(cardId));
-
-        Connection connection;
-        Response response = connection.send(httpRequest);
+    ClientRequest httpRequest = ClientRequest(token);
+    httpRequest
+            .get()
+            .baseAddress(serviceUrl_)
+            .endpoint(CardEndpointUri::get(cardId));
 
+    return query<GetCardResponse>(httpRequest, [this](const Response &response) {
         if (response.fail())
             throw this->parseError(response);
 
-        auto rawCard = JsonDeserializer<RawSignedModel>::fromJsonString(response.body());
+        auto rawCard = JsonStreamDeserializer<RawSignedModel>::fromJsonString(response.body());
 
         bool isOutdated = false;
         if (response.header()[CardClient::xVirgilIsSuperseededKey] == "true")
@@ -147,7 +421,22 @@ std::future<GetCardResponse> CardClient::getCard(const std::string &cardId, cons
         auto getCardResponse = GetCardResponse(rawCard, isOutdated);
 
         return getCardResponse;
+    }, true);
+}
+
+std::future<std::vector<GetCardResponse>> CardClient::getCards(const std::vector<std::string> &cardIds,
+                                                               const std::string &token) const {
+    auto futures = std::make_shared<std::vector<std::future<GetCardResponse>>>();
+    for (const auto& cardId : cardIds)
+        futures->push_back(getCard(cardId, token));
+
+    auto future = executor_->submit([=]{
+        std::vector<GetCardResponse> getCardResponses;
+        for (auto& getCardFuture : *futures)
+            getCardResponses.push_back(executor_->get(std::move(getCardFuture)));
+
+        return getCardResponses;
     });
 
     return future;
-}
\ No newline at end of file
+}
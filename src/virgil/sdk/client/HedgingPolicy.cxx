@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <algorithm>
+
+#include <virgil/sdk/client/HedgingPolicy.h>
+
+using virgil::sdk::client::HedgingPolicy;
+
+namespace {
+    const size_t kLatencySamples = 128;
+
+    const size_t kMinLatencySamples = 20;
+}
+
+HedgingPolicy::HedgingPolicy(double maxHedgeRatio, std::chrono::milliseconds hedgeDelay)
+        : maxHedgeRatio_(maxHedgeRatio), hedgeDelay_(hedgeDelay), hedgeBudget_(0), nextLatency_(0),
+          hedges_(0), wonHedges_(0) {
+    latencies_.reserve(kLatencySamples);
+}
+
+void HedgingPolicy::requestStarted() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Budget is capped by single hedge, so hedges don't burst after long period without them
+    hedgeBudget_ = std::min(1.0, hedgeBudget_ + maxHedgeRatio_);
+}
+
+bool HedgingPolicy::hedgeDelay(std::chrono::milliseconds &delay) const {
+    if (hedgeDelay_.count() > 0) {
+        delay = hedgeDelay_;
+        return true;
+    }
+
+    std::vector<std::chrono::milliseconds> latencies;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (latencies_.size() < kMinLatencySamples)
+            return false;
+        latencies = latencies_;
+    }
+
+    auto percentile = latencies.begin() + latencies.size() * 95 / 100;
+    std::nth_element(latencies.begin(), percentile, latencies.end());
+    delay = *percentile;
+
+    return true;
+}
+
+bool HedgingPolicy::tryHedge() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (hedgeBudget_ < 1.0)
+        return false;
+
+    hedgeBudget_ -= 1.0;
+    ++hedges_;
+
+    return true;
+}
+
+void HedgingPolicy::requestCompleted(std::chrono::milliseconds latency, bool hedgeWon) {
+    if (hedgeWon)
+        ++wonHedges_;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_.size() < kLatencySamples)
+        latencies_.push_back(latency);
+    else
+        latencies_[nextLatency_] = latency;
+    nextLatency_ = (nextLatency_ + 1) % kLatencySamples;
+}
+
+void HedgingPolicy::schedule(std::chrono::milliseconds delay, std::function<void()> task) {
+    scheduler_.schedule(delay, std::move(task));
+}
+
+double HedgingPolicy::maxHedgeRatio() const { return maxHedgeRatio_; }
+
+size_t HedgingPolicy::hedges() const { return hedges_; }
+
+size_t HedgingPolicy::wonHedges() const { return wonHedges_; }
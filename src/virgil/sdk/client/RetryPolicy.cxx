@@ -0,0 +1,170 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include <virgil/sdk/client/RetryPolicy.h>
+#include <virgil/sdk/client/networking/CardEndpointUri.h>
+#include <virgil/sdk/client/networking/errors/TransportError.h>
+
+using virgil::sdk::client::RetryPolicy;
+using virgil::sdk::client::networking::CardEndpointUri;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+using virgil::sdk::client::networking::errors::TransportError;
+
+namespace {
+    std::function<double()> defaultRandom() {
+        std::mt19937 generator(std::random_device{}());
+        std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+        return [generator, distribution]() mutable { return distribution(generator); };
+    }
+}
+
+RetryPolicy::RetryPolicy(size_t maxAttempts, std::chrono::milliseconds attemptTimeout,
+                         std::chrono::milliseconds connectTimeout, std::chrono::milliseconds deadline,
+                         std::chrono::milliseconds initialBackoff, std::chrono::milliseconds maxBackoff,
+                         double retryBudgetRatio, size_t retryBudgetBurst, std::function<double()> random)
+        : maxAttempts_(std::max<size_t>(maxAttempts, 1)), attemptTimeout_(attemptTimeout),
+          connectTimeout_(connectTimeout), deadline_(deadline), initialBackoff_(initialBackoff),
+          maxBackoff_(maxBackoff), retryBudgetRatio_(retryBudgetRatio),
+          retryBudgetBurst_(static_cast<double>(retryBudgetBurst)), retryBudget_(retryBudgetBurst_),
+          random_(random ? std::move(random) : defaultRandom()), retries_(0), rejectedRetries_(0) {}
+
+Request RetryPolicy::attemptRequest(const Request &request, std::chrono::milliseconds elapsed) const {
+    auto remaining = std::max(deadline_ - elapsed, std::chrono::milliseconds(1));
+    auto timeout = std::min(attemptTimeout_, remaining);
+
+    auto attempt = request;
+    attempt.timeout(timeout).connectTimeout(std::min(connectTimeout_, timeout));
+
+    return attempt;
+}
+
+void RetryPolicy::requestStarted() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retryBudget_ = std::min(retryBudgetBurst_, retryBudget_ + retryBudgetRatio_);
+}
+
+bool RetryPolicy::shouldRetry(const Request &request, std::exception_ptr error, const Response &response,
+                              size_t attempt, std::chrono::milliseconds elapsed, std::chrono::milliseconds &delay) {
+    if (attempt >= maxAttempts_)
+        return false;
+
+    auto cancellationFlag = request.cancellationFlag();
+    if (cancellationFlag && *cancellationFlag)
+        return false;
+
+    if (error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const TransportError &transportError) {
+            if (transportError.requestSent() && !isIdempotent(request))
+                return false;
+        } catch (...) {
+            return false;
+        }
+    } else if (!isRetryable(response) || !isIdempotent(request))
+        return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    delay = backoff(attempt);
+    if (!error) {
+        auto header = response.header();
+        auto retryAfter = header.find("Retry-After");
+        if (retryAfter != header.end())
+            delay = std::max(delay, std::chrono::milliseconds(1000 * std::atol(retryAfter->second.c_str())));
+    }
+
+    if (elapsed + delay >= deadline_)
+        return false;
+
+    if (retryBudget_ < 1.0) {
+        ++rejectedRetries_;
+        return false;
+    }
+    retryBudget_ -= 1.0;
+    ++retries_;
+
+    return true;
+}
+
+bool RetryPolicy::isIdempotent(const Request &request) {
+    // Search only reads cards, though it's sent with POST
+    return request.method() != Request::Method::POST || request.endpoint() == CardEndpointUri::search();
+}
+
+bool RetryPolicy::isRetryable(const Response &response) {
+    switch (response.statusCode()) {
+        case Response::StatusCode::TOO_MANY_REQUESTS:
+        case Response::StatusCode::SERVER_ERROR:
+        case Response::StatusCode::BAD_GATEWAY:
+        case Response::StatusCode::SERVICE_UNAVAILABLE:
+        case Response::StatusCode::GATEWAY_TIMEOUT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::chrono::milliseconds RetryPolicy::backoff(size_t attempt) {
+    auto backoff = initialBackoff_;
+    for (size_t i = 1; i < attempt && backoff < maxBackoff_; ++i)
+        backoff *= 2;
+    backoff = std::min(backoff, maxBackoff_);
+
+    // Half of delay is random, so clients failed at the same time don't retry at the same time
+    auto half = backoff.count() / 2;
+    auto jitter = static_cast<std::chrono::milliseconds::rep>(std::llround(random_() * half));
+
+    return std::chrono::milliseconds(backoff.count() - half + jitter);
+}
+
+size_t RetryPolicy::maxAttempts() const { return maxAttempts_; }
+
+std::chrono::milliseconds RetryPolicy::attemptTimeout() const { return attemptTimeout_; }
+
+std::chrono::milliseconds RetryPolicy::connectTimeout() const { return connectTimeout_; }
+
+std::chrono::milliseconds RetryPolicy::deadline() const { return deadline_; }
+
+size_t RetryPolicy::retries() const { return retries_; }
+
+size_t RetryPolicy::rejectedRetries() const { return rejectedRetries_; }
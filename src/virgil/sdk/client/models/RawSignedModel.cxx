@@ -35,27 +35,25 @@
  */
 
 #include <virgil/sdk/client/models/RawSignedModel.h>
-#include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 #include <virgil/sdk/serialization/JsonSerializer.h>
 #include <virgil/sdk/VirgilSdkError.h>
 
 using virgil::sdk::client::models::RawSignedModel;
 using virgil::sdk::client::models::RawSignature;
 using virgil::sdk::VirgilByteArray;
-using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::serialization::JsonStreamDeserializer;
 using virgil::sdk::serialization::JsonSerializer;
 
 RawSignedModel::RawSignedModel(VirgilByteArray contentSnapshot)
-        : contentSnapshot_(std::move(contentSnapshot)) {
-    signatures_ = std::vector<RawSignature>();
-}
+        : contentSnapshot_(std::move(contentSnapshot)) {}
 
-void RawSignedModel::addSignature(const RawSignature &newSignature) {
-    for (RawSignature& signature : signatures_) {
+void RawSignedModel::addSignature(RawSignature newSignature) {
+    for (const RawSignature& signature : signatures_) {
         if (signature.signer() == newSignature.signer())
             throw make_error(VirgilSdkError::AddSignatureFailed, "Signature with same signer already exist");
     }
-    signatures_.push_back(newSignature);
+    signatures_.push_back(std::move(newSignature));
 }
 
 std::string RawSignedModel::exportAsJson() const {
@@ -67,14 +65,14 @@ std::string RawSignedModel::exportAsBase64EncodedString() const {
 }
 
 RawSignedModel RawSignedModel::importFromJson(const std::string &data) {
-    return JsonDeserializer<RawSignedModel>::fromJsonString(data);
+    return JsonStreamDeserializer<RawSignedModel>::fromJsonString(data);
 }
 
 RawSignedModel RawSignedModel::importFromBase64EncodedString(const std::string &data) {
     auto decodedStr = VirgilByteArrayUtils::bytesToString(VirgilBase64::decode(data));
-    return JsonDeserializer<RawSignedModel>::fromJsonString(decodedStr);
+    return JsonStreamDeserializer<RawSignedModel>::fromJsonString(decodedStr);
 }
 
 const VirgilByteArray& RawSignedModel::contentSnapshot() const { return contentSnapshot_; }
 
-const std::vector<RawSignature> RawSignedModel::signatures() const { return signatures_; }
\ No newline at end of file
+const std::vector<RawSignature>& RawSignedModel::signatures() const { return signatures_; }
\ No newline at end of file
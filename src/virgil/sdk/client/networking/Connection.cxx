@@ -55,7 +55,8 @@ Response Connection::send(const Request& request) {
     // Make Request
     HttpRequest httpRequest;
     httpRequest.header(request.header()).content(request.contentType(), request.body());
-    httpRequest.timeout(7L);
+    // Client accepts whole seconds only, so timeout is rounded up
+    httpRequest.timeout(static_cast<long>((request.timeout().count() + 999) / 1000));
 
     switch (request.method()) {
         case Request::Method::GET:
@@ -0,0 +1,172 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <stdexcept>
+
+#include <curl/curl.h>
+
+#include <virgil/sdk/client/networking/ConnectionPool.h>
+#include <virgil/sdk/client/networking/CurlRequest.h>
+
+using virgil::sdk::client::networking::ConnectionPool;
+using virgil::sdk::client::networking::CurlRequest;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+
+class ConnectionPool::Handle {
+public:
+    Handle() : curl_(curl_easy_init()) {
+        if (curl_ == nullptr)
+            throw std::runtime_error("Can't initialize HTTP connection.");
+    }
+
+    ~Handle() {
+        curl_easy_cleanup(curl_);
+    }
+
+    Handle(const Handle&) = delete;
+
+    Handle& operator=(const Handle&) = delete;
+
+    CURL *curl() const { return curl_; }
+
+private:
+    CURL *curl_;
+};
+
+ConnectionPool::ConnectionPool(size_t maxIdleConnections, std::chrono::milliseconds idleTimeout)
+        : maxIdleConnections_(maxIdleConnections), idleTimeout_(idleTimeout),
+          reusedConnections_(0), newConnections_(0) {
+    CurlRequest::globalInit();
+}
+
+ConnectionPool::~ConnectionPool() = default;
+
+Response ConnectionPool::send(const Request &request) {
+    auto baseAddress = request.baseAddress();
+    auto handle = acquire(baseAddress);
+    auto curl = handle->curl();
+
+    // Resets options only, established connection stays in handle's cache
+    curl_easy_reset(curl);
+    CurlRequest curlRequest(curl, request);
+
+    auto result = curl_easy_perform(curl);
+    // Handle may hold broken connection, so it's not returned to the pool on failure
+    curlRequest.checkResult(result);
+
+    long numConnects = 0;
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &numConnects);
+    if (numConnects > 0)
+        ++newConnections_;
+    else
+        ++reusedConnections_;
+
+    Response response;
+    try {
+        response = curlRequest.response(result);
+    } catch (...) {
+        release(baseAddress, std::move(handle));
+        throw;
+    }
+    release(baseAddress, std::move(handle));
+
+    return response;
+}
+
+std::unique_ptr<ConnectionPool::Handle> ConnectionPool::acquire(const std::string &baseAddress) {
+    std::unique_ptr<Handle> handle;
+    std::deque<IdleHandle> expired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = idle_.find(baseAddress);
+        if (it != idle_.end()) {
+            auto &handles = it->second;
+            auto now = std::chrono::steady_clock::now();
+            // Most recently released handles are at the back, expired ones accumulate at the front
+            while (!handles.empty() && now - handles.front().releasedAt >= idleTimeout_) {
+                expired.push_back(std::move(handles.front()));
+                handles.pop_front();
+            }
+            if (!handles.empty()) {
+                handle = std::move(handles.back().handle);
+                handles.pop_back();
+            }
+        }
+    }
+
+    if (handle == nullptr)
+        handle.reset(new Handle());
+
+    return handle;
+}
+
+void ConnectionPool::release(const std::string &baseAddress, std::unique_ptr<Handle> handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &handles = idle_[baseAddress];
+    if (handles.size() >= maxIdleConnections_)
+        return;
+
+    IdleHandle idleHandle;
+    idleHandle.handle = std::move(handle);
+    idleHandle.releasedAt = std::chrono::steady_clock::now();
+    handles.push_back(std::move(idleHandle));
+}
+
+void ConnectionPool::clear() {
+    std::unordered_map<std::string, std::deque<IdleHandle>> idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle.swap(idle_);
+    }
+}
+
+size_t ConnectionPool::maxIdleConnections() const { return maxIdleConnections_; }
+
+std::chrono::milliseconds ConnectionPool::idleTimeout() const { return idleTimeout_; }
+
+size_t ConnectionPool::idleConnections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto &handles : idle_)
+        count += handles.second.size();
+
+    return count;
+}
+
+size_t ConnectionPool::reusedConnections() const { return reusedConnections_; }
+
+size_t ConnectionPool::newConnections() const { return newConnections_; }
@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <stdexcept>
+
+#include <curl/curl.h>
+
+#include <virgil/sdk/client/networking/CurlMultiLoop.h>
+#include <virgil/sdk/client/networking/CurlRequest.h>
+
+using virgil::sdk::client::networking::CurlMultiLoop;
+using virgil::sdk::client::networking::CurlRequest;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+
+namespace {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    const int kPollTimeoutMs = 1000;
+#else
+    // Without curl_multi_wakeup() queued requests are picked up by short wait timeout
+    const int kPollTimeoutMs = 10;
+#endif
+
+    void complete(const CurlMultiLoop::Callback &callback, std::exception_ptr error, Response response) {
+        try {
+            callback(error, std::move(response));
+        } catch (...) {
+            // Callback errors must not stop the loop
+        }
+    }
+
+    std::exception_ptr closedError() {
+        return std::make_exception_ptr(std::runtime_error("HTTP connection is closed."));
+    }
+}
+
+struct CurlMultiLoop::Transfer {
+    Transfer(const Request &request, Callback callback)
+            : request(request), callback(std::move(callback)), curl(nullptr) {}
+
+    ~Transfer() {
+        curlRequest.reset();
+        if (curl != nullptr)
+            curl_easy_cleanup(curl);
+    }
+
+    Request request;
+    Callback callback;
+    CURL *curl;
+    std::unique_ptr<CurlRequest> curlRequest;
+};
+
+CurlMultiLoop::CurlMultiLoop(bool http2, size_t maxConcurrentStreams, size_t maxConnectionsPerHost)
+        : multi_(nullptr), http2_(http2), stopped_(false), reusedConnections_(0), newConnections_(0) {
+    CurlRequest::globalInit();
+
+    multi_ = curl_multi_init();
+    if (multi_ == nullptr)
+        throw std::runtime_error("Can't initialize HTTP connection.");
+
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, http2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(maxConnectionsPerHost));
+#if LIBCURL_VERSION_NUM >= 0x074300
+    if (http2)
+        curl_multi_setopt(multi_, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(maxConcurrentStreams));
+#endif
+
+    thread_ = std::thread([this] { run(); });
+}
+
+CurlMultiLoop::~CurlMultiLoop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_wakeup(multi_);
+#endif
+    thread_.join();
+    curl_multi_cleanup(multi_);
+}
+
+void CurlMultiLoop::send(const Request &request, Callback callback) {
+    std::unique_ptr<Transfer> transfer(new Transfer(request, std::move(callback)));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopped_) {
+            queued_.push_back(std::move(transfer));
+        }
+    }
+
+    if (transfer != nullptr) {
+        complete(transfer->callback, closedError(), Response());
+        return;
+    }
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_wakeup(multi_);
+#endif
+}
+
+size_t CurlMultiLoop::reusedConnections() const { return reusedConnections_; }
+
+size_t CurlMultiLoop::newConnections() const { return newConnections_; }
+
+void CurlMultiLoop::run() {
+    while (true) {
+        std::deque<std::unique_ptr<Transfer>> queued;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_)
+                break;
+            queued.swap(queued_);
+        }
+
+        for (auto &transfer : queued)
+            start(std::move(transfer));
+
+        int running = 0;
+        curl_multi_perform(multi_, &running);
+
+        int left = 0;
+        while (auto message = curl_multi_info_read(multi_, &left)) {
+            if (message->msg == CURLMSG_DONE)
+                finish(message->easy_handle, message->data.result);
+        }
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+        curl_multi_poll(multi_, nullptr, 0, kPollTimeoutMs, nullptr);
+#else
+        curl_multi_wait(multi_, nullptr, 0, kPollTimeoutMs, nullptr);
+#endif
+    }
+
+    std::deque<std::unique_ptr<Transfer>> queued;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued.swap(queued_);
+    }
+    for (auto &active : active_) {
+        curl_multi_remove_handle(multi_, active.first);
+        complete(active.second->callback, closedError(), Response());
+    }
+    active_.clear();
+    for (auto &transfer : queued)
+        complete(transfer->callback, closedError(), Response());
+}
+
+void CurlMultiLoop::start(std::unique_ptr<Transfer> transfer) {
+    auto curl = curl_easy_init();
+    if (curl == nullptr) {
+        complete(transfer->callback,
+                 std::make_exception_ptr(std::runtime_error("Can't initialize HTTP connection.")), Response());
+        return;
+    }
+    transfer->curl = curl;
+
+    try {
+        transfer->curlRequest.reset(new CurlRequest(curl, transfer->request));
+    } catch (...) {
+        complete(transfer->callback, std::current_exception(), Response());
+        return;
+    }
+
+    if (http2_) {
+        auto isTls = transfer->request.uri().compare(0, 8, "https://") == 0;
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                         isTls ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+        // Wait for established connection to multiplex over it instead of opening new one
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    }
+
+    curl_multi_add_handle(multi_, curl);
+    active_[curl] = std::move(transfer);
+}
+
+void CurlMultiLoop::finish(void *curl, int result) {
+    auto it = active_.find(curl);
+    if (it == active_.end())
+        return;
+
+    auto transfer = std::move(it->second);
+    active_.erase(it);
+    curl_multi_remove_handle(multi_, curl);
+
+    if (result == CURLE_OK) {
+        long numConnects = 0;
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &numConnects);
+        if (numConnects > 0)
+            ++newConnections_;
+        else
+            ++reusedConnections_;
+    }
+
+    std::exception_ptr error;
+    Response response;
+    try {
+        response = transfer->curlRequest->response(result);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    complete(transfer->callback, error, std::move(response));
+}
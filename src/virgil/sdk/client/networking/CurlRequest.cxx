@@ -0,0 +1,191 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <mutex>
+#include <stdexcept>
+
+#include <curl/curl.h>
+
+#include <virgil/sdk/client/networking/CurlRequest.h>
+#include <virgil/sdk/client/networking/errors/TransportError.h>
+
+using virgil::sdk::client::networking::CurlRequest;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+using virgil::sdk::client::networking::errors::TransportError;
+
+namespace {
+    std::once_flag curlGlobalInitFlag;
+
+    size_t writeBodyCallback(char *data, size_t size, size_t count, void *userData) {
+        auto body = static_cast<std::string *>(userData);
+        body->append(data, size * count);
+        return size * count;
+    }
+
+    size_t writeHeaderCallback(char *data, size_t size, size_t count, void *userData) {
+        auto header = static_cast<Response::Header *>(userData);
+        auto line = std::string(data, size * count);
+
+        // Status line starts new header block (redirects, 100-continue)
+        if (line.compare(0, 5, "HTTP/") == 0) {
+            header->clear();
+            return size * count;
+        }
+
+        auto separator = line.find(':');
+        if (separator == std::string::npos)
+            return size * count;
+
+        auto valueBegin = line.find_first_not_of(" \t", separator + 1);
+        auto valueEnd = line.find_last_not_of(" \t\r\n");
+        auto value = (valueBegin == std::string::npos || valueEnd < valueBegin)
+                     ? std::string() : line.substr(valueBegin, valueEnd - valueBegin + 1);
+        (*header)[line.substr(0, separator)] = value;
+
+        return size * count;
+    }
+
+    int progressCallback(void *userData, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+        auto cancellationFlag = static_cast<const std::atomic<bool> *>(userData);
+        return *cancellationFlag ? 1 : 0;
+    }
+}
+
+CurlRequest::CurlRequest(void *curl, const Request &request)
+        : curl_(curl), uri_(request.uri()), body_(request.body()), headerList_(nullptr),
+          cancellationFlag_(request.cancellationFlag()) {
+    curl_easy_setopt(curl_, CURLOPT_URL, uri_.c_str());
+    curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeout().count()));
+    if (request.connectTimeout().count() > 0)
+        curl_easy_setopt(curl_, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(request.connectTimeout().count()));
+    curl_easy_setopt(curl_, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, writeBodyCallback);
+    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &responseBody_);
+    curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, writeHeaderCallback);
+    curl_easy_setopt(curl_, CURLOPT_HEADERDATA, &responseHeader_);
+    if (cancellationFlag_) {
+        // Non-zero result of progress callback aborts transfer
+        curl_easy_setopt(curl_, CURLOPT_XFERINFOFUNCTION, progressCallback);
+        curl_easy_setopt(curl_, CURLOPT_XFERINFODATA, cancellationFlag_.get());
+        curl_easy_setopt(curl_, CURLOPT_NOPROGRESS, 0L);
+    }
+
+    switch (request.method()) {
+        case Request::Method::GET:
+            curl_easy_setopt(curl_, CURLOPT_HTTPGET, 1L);
+            break;
+        case Request::Method::POST:
+            curl_easy_setopt(curl_, CURLOPT_POST, 1L);
+            break;
+        case Request::Method::PUT:
+            curl_easy_setopt(curl_, CURLOPT_CUSTOMREQUEST, "PUT");
+            break;
+        case Request::Method::DEL:
+            curl_easy_setopt(curl_, CURLOPT_CUSTOMREQUEST, "DELETE");
+            break;
+        default:
+            throw std::logic_error("Unknown HTTP method.");
+    }
+
+    if (request.method() != Request::Method::GET) {
+        curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, body_.c_str());
+        curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE, static_cast<long>(body_.size()));
+    }
+
+    for (const auto &header : request.header()) {
+        headerList_ = curl_slist_append(headerList_, (header.first + ": " + header.second).c_str());
+    }
+    if (!request.contentType().empty()) {
+        headerList_ = curl_slist_append(headerList_, ("Content-Type: " + request.contentType()).c_str());
+    }
+    // Disable "Expect: 100-continue" round trip for request bodies
+    headerList_ = curl_slist_append(headerList_, "Expect:");
+    curl_easy_setopt(curl_, CURLOPT_HTTPHEADER, headerList_);
+}
+
+CurlRequest::~CurlRequest() {
+    curl_slist_free_all(headerList_);
+}
+
+void CurlRequest::globalInit() {
+    std::call_once(curlGlobalInitFlag, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+}
+
+void CurlRequest::checkResult(int result) const {
+    auto code = static_cast<CURLcode>(result);
+    if (code == CURLE_OK)
+        return;
+
+    bool requestSent = true;
+    switch (code) {
+        case CURLE_COULDNT_RESOLVE_PROXY:
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_CONNECT:
+        case CURLE_SSL_CONNECT_ERROR:
+            requestSent = false;
+            break;
+        case CURLE_OPERATION_TIMEDOUT: {
+            // Zero pretransfer time means transfer was not started yet
+            double pretransferTime = 0;
+            curl_easy_getinfo(curl_, CURLINFO_PRETRANSFER_TIME, &pretransferTime);
+            requestSent = pretransferTime > 0;
+            break;
+        }
+        default:
+            break;
+    }
+
+    throw TransportError(curl_easy_strerror(code), requestSent);
+}
+
+Response CurlRequest::response(int result) const {
+    checkResult(result);
+
+    long code = 0;
+    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &code);
+
+    Response response;
+    try {
+        response.statusCodeRaw(static_cast<int>(code));
+    } catch (const std::logic_error&) {
+        throw std::runtime_error(responseBody_);
+    }
+    response.header(responseHeader_).body(responseBody_);
+
+    return response;
+}
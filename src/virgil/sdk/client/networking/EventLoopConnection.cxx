@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <algorithm>
+
+#include <virgil/sdk/client/networking/EventLoopConnection.h>
+
+using virgil::sdk::client::networking::EventLoopConnection;
+using virgil::sdk::client::networking::CurlMultiLoop;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+
+EventLoopConnection::EventLoopConnection(size_t loopsCount, size_t maxConnectionsPerHost)
+        : maxConnectionsPerHost_(maxConnectionsPerHost), nextLoop_(0),
+          pendingRequests_(std::make_shared<std::atomic<size_t>>(0)) {
+    loopsCount = std::max<size_t>(1, loopsCount);
+    for (size_t i = 0; i < loopsCount; ++i)
+        loops_.emplace_back(new CurlMultiLoop(false, 0, maxConnectionsPerHost_));
+}
+
+EventLoopConnection::~EventLoopConnection() = default;
+
+void EventLoopConnection::sendAsync(const Request &request, Callback callback) {
+    auto pendingRequests = pendingRequests_;
+    ++*pendingRequests;
+
+    auto &loop = loops_[nextLoop_++ % loops_.size()];
+    loop->send(request, [pendingRequests, callback](std::exception_ptr error, Response response) {
+        --*pendingRequests;
+        callback(error, std::move(response));
+    });
+}
+
+size_t EventLoopConnection::loopsCount() const { return loops_.size(); }
+
+size_t EventLoopConnection::maxConnectionsPerHost() const { return maxConnectionsPerHost_; }
+
+size_t EventLoopConnection::pendingRequests() const { return *pendingRequests_; }
+
+size_t EventLoopConnection::reusedConnections() const {
+    size_t count = 0;
+    for (const auto &loop : loops_)
+        count += loop->reusedConnections();
+
+    return count;
+}
+
+size_t EventLoopConnection::newConnections() const {
+    size_t count = 0;
+    for (const auto &loop : loops_)
+        count += loop->newConnections();
+
+    return count;
+}
@@ -0,0 +1,70 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <stdexcept>
+
+#include <curl/curl.h>
+
+#include <virgil/sdk/client/networking/Http2Connection.h>
+
+using virgil::sdk::client::networking::Http2Connection;
+using virgil::sdk::client::networking::CurlMultiLoop;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+
+Http2Connection::Http2Connection(size_t maxConcurrentStreams, size_t maxConnectionsPerHost)
+        : maxConcurrentStreams_(maxConcurrentStreams), maxConnectionsPerHost_(maxConnectionsPerHost) {
+    if (!isSupported())
+        throw std::runtime_error("HTTP/2 is not supported by libcurl.");
+
+    loop_.reset(new CurlMultiLoop(true, maxConcurrentStreams_, maxConnectionsPerHost_));
+}
+
+void Http2Connection::sendAsync(const Request &request, Callback callback) {
+    loop_->send(request, std::move(callback));
+}
+
+bool Http2Connection::isSupported() {
+    return (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
+}
+
+size_t Http2Connection::maxConcurrentStreams() const { return maxConcurrentStreams_; }
+
+size_t Http2Connection::maxConnectionsPerHost() const { return maxConnectionsPerHost_; }
+
+size_t Http2Connection::reusedConnections() const { return loop_->reusedConnections(); }
+
+size_t Http2Connection::newConnections() const { return loop_->newConnections(); }
@@ -101,6 +101,33 @@ Request::Parameters Request::parameters() const {
     return parameters_;
 }
 
+Request& Request::timeout(std::chrono::milliseconds timeout) {
+    timeout_ = timeout;
+    return *this;
+}
+
+std::chrono::milliseconds Request::timeout() const {
+    return timeout_;
+}
+
+Request& Request::connectTimeout(std::chrono::milliseconds connectTimeout) {
+    connectTimeout_ = connectTimeout;
+    return *this;
+}
+
+std::chrono::milliseconds Request::connectTimeout() const {
+    return connectTimeout_;
+}
+
+Request& Request::cancellationFlag(std::shared_ptr<const std::atomic<bool>> cancellationFlag) {
+    cancellationFlag_ = std::move(cancellationFlag);
+    return *this;
+}
+
+std::shared_ptr<const std::atomic<bool>> Request::cancellationFlag() const {
+    return cancellationFlag_;
+}
+
 std::string Request::uri() const {
     if (parameters_.empty()) {
         return baseAddress() + endpoint();
@@ -36,6 +36,11 @@
 
 #include <virgil/sdk/crypto/Crypto.h>
 #include <virgil/sdk/VirgilSdkError.h>
+#include <virgil/sdk/executors/ExecutorUtils.h>
+#include <virgil/sdk/util/FileDataSink.h>
+#include <virgil/sdk/util/MappedFileDataSource.h>
+#include <virgil/sdk/util/ReadAheadDataSource.h>
+#include <virgil/sdk/util/WriteBehindDataSink.h>
 #include <virgil/crypto/VirgilKeyPair.h>
 #include <virgil/crypto/foundation/VirgilHash.h>
 #include <virgil/crypto/VirgilByteArrayUtils.h>
@@ -46,6 +51,9 @@
 #include <virgil/crypto/VirgilSigner.h>
 #include <virgil/crypto/VirgilStreamSigner.h>
 
+#include <system_error>
+#include <unordered_set>
+
 static_assert(!std::is_abstract<virgil::sdk::crypto::Crypto>(), "Crypto must not be abstract.");
 
 using virgil::sdk::make_error;
@@ -64,12 +72,52 @@ using virgil::crypto::stream::VirgilStreamDataSink;
 using virgil::sdk::crypto::keys::PrivateKey;
 using virgil::sdk::crypto::keys::PublicKey;
 using virgil::sdk::crypto::keys::KeyPair;
+using virgil::sdk::crypto::RecipientSet;
 using virgil::sdk::VirgilHashAlgorithm;
+using virgil::sdk::executors::ExecutorInterface;
+using virgil::sdk::executors::ExecutorUtils;
+using virgil::sdk::util::FileDataSink;
+using virgil::sdk::util::MappedFileDataSource;
+using virgil::sdk::util::ReadAheadDataSource;
+using virgil::sdk::util::WriteBehindDataSink;
 
 const auto CustomParamKeySignature = VirgilByteArrayUtils::stringToBytes("VIRGIL-DATA-SIGNATURE");
 
 const auto CustomParamKeySignerId = VirgilByteArrayUtils::stringToBytes("VIRGIL-DATA-SIGNER-ID");
 
+// Pipelined streams keep at most (2 * PipelineBufferedChunks + 2) chunks in memory
+const size_t PipelineChunkSize = 1024 * 1024;
+
+const size_t PipelineBufferedChunks = 4;
+
+const size_t MappedFileChunkSize = 1024 * 1024;
+
+namespace {
+    void encryptStream(VirgilChunkCipher &cipher, std::istream &istream, std::ostream &ostream, bool pipelined) {
+        if (pipelined) {
+            ReadAheadDataSource dataSource(istream, PipelineChunkSize, PipelineBufferedChunks);
+            WriteBehindDataSink dataSink(ostream, PipelineBufferedChunks);
+
+            cipher.encrypt(dataSource, dataSink);
+            dataSink.finish();
+
+            return;
+        }
+
+        auto dataSource = VirgilStreamDataSource(istream);
+        auto dataSink = VirgilStreamDataSink(ostream);
+
+        cipher.encrypt(dataSource, dataSink);
+    }
+
+    void checkOutputFile(const MappedFileDataSource &dataSource, const std::string &outputPath) {
+        // Truncating output would truncate mapped input, and reading it would crash with SIGBUS
+        if (dataSource.isSameFile(outputPath))
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                    "virgil-sdk:\n Output file " + outputPath + " is the input file");
+    }
+}
+
 Crypto::Crypto(bool useSHA256Fingerprints)
         : useSHA256Fingerprints_(useSHA256Fingerprints) {}
 
@@ -107,8 +155,7 @@ PublicKey Crypto::importPublicKey(const VirgilByteArray &data) const {
 }
 
 PublicKey Crypto::extractPublicKeyFromPrivateKey(const PrivateKey &privateKey) const {
-    auto privateKeyData = exportPrivateKey(privateKey);
-    auto publicKeyData = VirgilKeyPair::extractPublicKey(privateKeyData, VirgilByteArray());
+    auto publicKeyData = VirgilKeyPair::extractPublicKey(privateKey.derKey(), VirgilByteArray());
 
     auto exportedPublicKey = VirgilKeyPair::publicKeyToDER(publicKeyData);
 
@@ -128,7 +175,26 @@ VirgilByteArray Crypto::exportPrivateKey(const PrivateKey &privateKey, const std
 }
 
 VirgilByteArray Crypto::exportPublicKey(const PublicKey &publicKey) const {
-    return VirgilKeyPair::publicKeyToDER(publicKey.key());
+    return publicKey.derKey();
+}
+
+template<typename Cipher>
+void Crypto::addRecipients(Cipher &cipher, const RecipientSet &recipients) {
+    for (const auto& recipient : recipients.recipients())
+        cipher.addKeyRecipient(recipient.identifier, recipient.publicKey);
+}
+
+RecipientSet Crypto::createRecipientSet(const std::vector<PublicKey> &recipients) const {
+    auto preparedRecipients = std::vector<RecipientSet::Recipient>();
+    preparedRecipients.reserve(recipients.size());
+    auto identifiers = std::unordered_set<std::string>();
+    for (const auto& recipient : recipients) {
+        const auto& identifier = recipient.identifier();
+        if (identifiers.insert(std::string(identifier.begin(), identifier.end())).second)
+            preparedRecipients.push_back(RecipientSet::Recipient { identifier, recipient.derKey() });
+    }
+
+    return RecipientSet(std::move(preparedRecipients));
 }
 
 // Crypto operations
@@ -136,74 +202,149 @@ VirgilByteArray Crypto::encrypt(const VirgilByteArray &data, const std::vector<P
     auto cipher = VirgilCipher();
 
     for (auto& recipient : recipients) {
-        auto publicKeyData = exportPublicKey(recipient);
-
-        cipher.addKeyRecipient(recipient.identifier(), publicKeyData);
+        cipher.addKeyRecipient(recipient.identifier(), recipient.derKey());
     }
 
     return cipher.encrypt(data);
 }
 
-void Crypto::encrypt(std::istream &istream, std::ostream &ostream, const std::vector<PublicKey> &recipients) const {
+void Crypto::encrypt(std::istream &istream, std::ostream &ostream, const std::vector<PublicKey> &recipients,
+                     bool pipelined) const {
     auto cipher = VirgilChunkCipher();
 
     for (auto& recipient : recipients) {
-        auto publicKeyData = exportPublicKey(recipient);
+        cipher.addKeyRecipient(recipient.identifier(), recipient.derKey());
+    }
 
-        cipher.addKeyRecipient(recipient.identifier(), publicKeyData);
+    encryptStream(cipher, istream, ostream, pipelined);
+}
+
+VirgilByteArray Crypto::encrypt(const VirgilByteArray &data, const RecipientSet &recipients) const {
+    auto cipher = VirgilCipher();
+
+    addRecipients(cipher, recipients);
+
+    return cipher.encrypt(data);
+}
+
+void Crypto::encrypt(std::istream &istream, std::ostream &ostream, const RecipientSet &recipients,
+                     bool pipelined) const {
+    auto cipher = VirgilChunkCipher();
+
+    addRecipients(cipher, recipients);
+
+    encryptStream(cipher, istream, ostream, pipelined);
+}
+
+void Crypto::encryptFile(const std::string &inputPath, const std::string &outputPath,
+                         const std::vector<PublicKey> &recipients) const {
+    auto cipher = VirgilChunkCipher();
+
+    for (auto& recipient : recipients) {
+        cipher.addKeyRecipient(recipient.identifier(), recipient.derKey());
     }
 
-    auto dataSource = VirgilStreamDataSource(istream);
-    auto dataSink = VirgilStreamDataSink(ostream);
+    MappedFileDataSource dataSource(inputPath, MappedFileChunkSize);
+    checkOutputFile(dataSource, outputPath);
+    FileDataSink dataSink(outputPath, dataSource.size());
 
     cipher.encrypt(dataSource, dataSink);
+    dataSink.finish();
 }
 
 bool Crypto::verify(const VirgilByteArray &data, const VirgilByteArray &signature,
                     const PublicKey &signerPublicKey) const {
-    auto signer = VirgilSigner();
+    return verify(data, signature, signerPublicKey.derKey());
+}
 
-    auto signerPublicKeyData = exportPublicKey(signerPublicKey);
+bool Crypto::verify(const VirgilByteArray &data, const VirgilByteArray &signature,
+                    const VirgilByteArray &exportedSignerPublicKey) const {
+    auto signer = VirgilSigner();
 
-    return signer.verify(data, signature, signerPublicKeyData);
+    return signer.verify(data, signature, exportedSignerPublicKey);
 }
 
 bool Crypto::verify(std::istream &istream, const VirgilByteArray &signature, const PublicKey &signerPublicKey) const {
     auto signer = VirgilStreamSigner();
 
-    auto signerPublicKeyData = exportPublicKey(signerPublicKey);
-
     auto dataSource = VirgilStreamDataSource(istream);
 
-    return signer.verify(dataSource, signature, signerPublicKeyData);
+    return signer.verify(dataSource, signature, signerPublicKey.derKey());
+}
+
+bool Crypto::verifyFileSignature(const std::string &path, const VirgilByteArray &signature,
+                                 const PublicKey &signerPublicKey) const {
+    auto signer = VirgilStreamSigner();
+
+    MappedFileDataSource dataSource(path, MappedFileChunkSize);
+
+    return signer.verify(dataSource, signature, signerPublicKey.derKey());
+}
+
+std::vector<bool> Crypto::verifyBatch(const std::vector<VerificationItem> &items,
+                                      const std::shared_ptr<ExecutorInterface> &executor) const {
+    auto verifyChunk = [&items](size_t begin, size_t end) {
+        auto results = std::vector<bool>();
+        results.reserve(end - begin);
+        auto signer = VirgilSigner();
+        for (auto i = begin; i < end; ++i) {
+            const auto& item = items[i];
+            try {
+                results.push_back(signer.verify(item.data, item.signature, item.signerPublicKey.derKey()));
+            } catch (...) {
+                results.push_back(false);
+            }
+        }
+
+        return results;
+    };
+
+    return ExecutorUtils::mapChunks(executor, items.size(), verifyChunk);
 }
 
 VirgilByteArray Crypto::decrypt(const VirgilByteArray &data, const PrivateKey &privateKey) const {
     auto cipher = VirgilCipher();
 
-    auto privateKeyData = exportPrivateKey(privateKey);
-
-    return cipher.decryptWithKey(data, privateKey.identifier(), privateKeyData);
+    return cipher.decryptWithKey(data, privateKey.identifier(), privateKey.derKey());
 }
 
-void Crypto::decrypt(std::istream &istream, std::ostream &ostream, const PrivateKey &privateKey) const {
+void Crypto::decrypt(std::istream &istream, std::ostream &ostream, const PrivateKey &privateKey,
+                     bool pipelined) const {
     auto cipher = VirgilChunkCipher();
 
-    auto privateKeyData = exportPrivateKey(privateKey);
+    if (pipelined) {
+        ReadAheadDataSource dataSource(istream, PipelineChunkSize, PipelineBufferedChunks);
+        WriteBehindDataSink dataSink(ostream, PipelineBufferedChunks);
+
+        cipher.decryptWithKey(dataSource, dataSink, privateKey.identifier(), privateKey.derKey());
+        dataSink.finish();
+
+        return;
+    }
 
     auto dataSource = VirgilStreamDataSource(istream);
     auto dataSink = VirgilStreamDataSink(ostream);
 
-    cipher.decryptWithKey(dataSource, dataSink, privateKey.identifier(), privateKeyData);
+    cipher.decryptWithKey(dataSource, dataSink, privateKey.identifier(), privateKey.derKey());
+}
+
+void Crypto::decryptFile(const std::string &inputPath, const std::string &outputPath,
+                         const PrivateKey &privateKey) const {
+    auto cipher = VirgilChunkCipher();
+
+    MappedFileDataSource dataSource(inputPath, MappedFileChunkSize);
+    checkOutputFile(dataSource, outputPath);
+    FileDataSink dataSink(outputPath, dataSource.size());
+
+    cipher.decryptWithKey(dataSource, dataSink, privateKey.identifier(), privateKey.derKey());
+    dataSink.finish();
 }
 
 VirgilByteArray Crypto::signThenEncrypt(const VirgilByteArray &data, const PrivateKey &privateKey,
                                         const std::vector<PublicKey> &recipients) const {
     auto signer = VirgilSigner(VirgilHashAlgorithm::SHA512);
 
-    auto privateKeyData = exportPrivateKey(privateKey);
-
-    auto signature = signer.sign(data, privateKeyData);
+    auto signature = signer.sign(data, privateKey.derKey());
 
     auto cipher = VirgilCipher();
 
@@ -213,26 +354,38 @@ VirgilByteArray Crypto::signThenEncrypt(const VirgilByteArray &data, const Priva
     cipher.customParams().setData(CustomParamKeySignerId, signerId);
 
     for (auto& recipient : recipients) {
-        auto publicKeyData = exportPublicKey(recipient);
-
-        cipher.addKeyRecipient(recipient.identifier(), publicKeyData);
+        cipher.addKeyRecipient(recipient.identifier(), recipient.derKey());
     }
 
     return cipher.encrypt(data);
 }
 
+VirgilByteArray Crypto::signThenEncrypt(const VirgilByteArray &data, const PrivateKey &privateKey,
+                                        const RecipientSet &recipients) const {
+    auto signer = VirgilSigner(VirgilHashAlgorithm::SHA512);
+
+    auto signature = signer.sign(data, privateKey.derKey());
+
+    auto cipher = VirgilCipher();
+
+    cipher.customParams().setData(CustomParamKeySignature, signature);
+    cipher.customParams().setData(CustomParamKeySignerId, privateKey.identifier());
+
+    addRecipients(cipher, recipients);
+
+    return cipher.encrypt(data);
+}
+
 VirgilByteArray Crypto::decryptThenVerify(const VirgilByteArray &data, const PrivateKey &privateKey,
                                           const PublicKey &signerPublicKey) const {
     auto cipher = VirgilCipher();
 
-    auto privateKeyData = exportPrivateKey(privateKey);
-    auto decryptedData = cipher.decryptWithKey(data, privateKey.identifier(), privateKeyData);
+    auto decryptedData = cipher.decryptWithKey(data, privateKey.identifier(), privateKey.derKey());
 
     auto signature = cipher.customParams().getData(CustomParamKeySignature);
 
     auto signer = VirgilSigner();
-    auto publicKeyData = exportPublicKey(signerPublicKey);
-    auto isVerified = signer.verify(decryptedData, signature, publicKeyData);
+    auto isVerified = signer.verify(decryptedData, signature, signerPublicKey.derKey());
 
     if (!isVerified) {
         throw make_error(VirgilSdkError::VerificationFailed, "Invalid signature.");
@@ -246,8 +399,7 @@ VirgilByteArray Crypto::decryptThenVerify(const virgil::sdk::VirgilByteArray &da
                                           const std::vector<PublicKey> &signersPublicKeys) const {
     auto cipher = VirgilCipher();
 
-    auto privateKeyData = exportPrivateKey(privateKey);
-    auto decryptedData = cipher.decryptWithKey(data, privateKey.identifier(), privateKeyData);
+    auto decryptedData = cipher.decryptWithKey(data, privateKey.identifier(), privateKey.derKey());
 
     auto signature = cipher.customParams().getData(CustomParamKeySignature);
     auto signerId = cipher.customParams().getData(CustomParamKeySignerId);
@@ -256,7 +408,7 @@ VirgilByteArray Crypto::decryptThenVerify(const virgil::sdk::VirgilByteArray &da
 
     for (auto& signerPublicKey : signersPublicKeys) {
         if (signerPublicKey.identifier() == signerId) {
-            publicKeyData = exportPublicKey(signerPublicKey);
+            publicKeyData = signerPublicKey.derKey();
         }
     }
 
@@ -271,20 +423,30 @@ VirgilByteArray Crypto::decryptThenVerify(const virgil::sdk::VirgilByteArray &da
 }
 
 VirgilByteArray Crypto::generateSignature(const VirgilByteArray &data, const PrivateKey &privateKey) const {
-    auto signer = VirgilSigner(VirgilHashAlgorithm::SHA512);
+    return generateSignature(data, privateKey.derKey());
+}
 
-    auto privateKeyData = exportPrivateKey(privateKey);
+VirgilByteArray Crypto::generateSignature(const VirgilByteArray &data,
+                                          const VirgilByteArray &exportedPrivateKey) const {
+    auto signer = VirgilSigner(VirgilHashAlgorithm::SHA512);
 
-    return signer.sign(data, privateKeyData);
+    return signer.sign(data, exportedPrivateKey);
 }
 
 VirgilByteArray Crypto::generateSignature(std::istream &istream, const PrivateKey &privateKey) const {
     auto signer = VirgilStreamSigner(VirgilHashAlgorithm::SHA512);
 
     auto dataSource = VirgilStreamDataSource(istream);
-    auto privateKeyData = exportPrivateKey(privateKey);
 
-    return signer.sign(dataSource, privateKeyData);
+    return signer.sign(dataSource, privateKey.derKey());
+}
+
+VirgilByteArray Crypto::generateFileSignature(const std::string &path, const PrivateKey &privateKey) const {
+    auto signer = VirgilStreamSigner(VirgilHashAlgorithm::SHA512);
+
+    MappedFileDataSource dataSource(path, MappedFileChunkSize);
+
+    return signer.sign(dataSource, privateKey.derKey());
 }
 
 //Utils
@@ -35,9 +35,18 @@
  */
 
 #include <virgil/sdk/crypto/keys/PrivateKey.h>
+#include <virgil/crypto/VirgilKeyPair.h>
 
 using virgil::sdk::VirgilByteArray;
 using virgil::sdk::crypto::keys::PrivateKey;
+using virgil::crypto::VirgilKeyPair;
 
 PrivateKey::PrivateKey(VirgilByteArray key, VirgilByteArray identifier)
-        : key_(std::move(key)), identifier_(std::move(identifier)) {}
+        : key_(std::move(key)), identifier_(std::move(identifier)),
+          derKeyCache_(std::make_shared<DerKeyCache>()) {}
+
+const VirgilByteArray& PrivateKey::derKey() const {
+    std::call_once(derKeyCache_->once, [this] { derKeyCache_->derKey = VirgilKeyPair::privateKeyToDER(key_); });
+
+    return derKeyCache_->derKey;
+}
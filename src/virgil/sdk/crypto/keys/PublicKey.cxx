@@ -35,9 +35,18 @@
  */
 
 #include <virgil/sdk/crypto/keys/PublicKey.h>
+#include <virgil/crypto/VirgilKeyPair.h>
 
 using virgil::sdk::VirgilByteArray;
 using virgil::sdk::crypto::keys::PublicKey;
+using virgil::crypto::VirgilKeyPair;
 
 PublicKey::PublicKey(VirgilByteArray key, VirgilByteArray identifier)
-        : key_(std::move(key)), identifier_(std::move(identifier)) {}
\ No newline at end of file
+        : key_(std::move(key)), identifier_(std::move(identifier)),
+          derKeyCache_(std::make_shared<DerKeyCache>()) {}
+
+const VirgilByteArray& PublicKey::derKey() const {
+    std::call_once(derKeyCache_->once, [this] { derKeyCache_->derKey = VirgilKeyPair::publicKeyToDER(key_); });
+
+    return derKeyCache_->derKey;
+}
\ No newline at end of file
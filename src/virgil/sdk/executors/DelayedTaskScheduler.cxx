@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/executors/DelayedTaskScheduler.h>
+
+using virgil::sdk::executors::DelayedTaskScheduler;
+
+DelayedTaskScheduler::DelayedTaskScheduler() : stopped_(false) {
+    thread_ = std::thread([this] { timerLoop(); });
+}
+
+DelayedTaskScheduler::~DelayedTaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+}
+
+void DelayedTaskScheduler::schedule(std::chrono::milliseconds delay, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.emplace(std::chrono::steady_clock::now() + delay, std::move(task));
+    }
+    condition_.notify_one();
+}
+
+size_t DelayedTaskScheduler::pendingTasks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return tasks_.size();
+}
+
+std::shared_ptr<DelayedTaskScheduler> DelayedTaskScheduler::defaultScheduler() {
+    static auto scheduler = std::make_shared<DelayedTaskScheduler>();
+
+    return scheduler;
+}
+
+void DelayedTaskScheduler::timerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+        if (tasks_.empty()) {
+            condition_.wait(lock);
+            continue;
+        }
+
+        auto next = tasks_.begin();
+        if (next->first > std::chrono::steady_clock::now()) {
+            condition_.wait_until(lock, next->first);
+            continue;
+        }
+
+        auto task = std::move(next->second);
+        tasks_.erase(next);
+        lock.unlock();
+        try {
+            task();
+        } catch (...) {
+            // Failed task must not stop other tasks
+        }
+        // Task is destroyed outside of lock, since it may own objects scheduling other tasks
+        task = nullptr;
+        lock.lock();
+    }
+}
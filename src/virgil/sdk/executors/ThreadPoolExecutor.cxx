@@ -0,0 +1,236 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
+
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::executors::ExecutorInterface;
+
+struct ThreadPoolExecutor::State {
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    explicit State(size_t threadCount) : queueDepth(0), nextQueue(0), stopped(false) {
+        for (size_t i = 0; i < threadCount; ++i)
+            queues.emplace_back(new TaskQueue());
+    }
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::atomic<size_t> queueDepth;
+    std::atomic<size_t> nextQueue;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopped;
+};
+
+namespace {
+    using State = ThreadPoolExecutor::State;
+
+    const size_t kNoWorker = static_cast<size_t>(-1);
+
+    // Executor state and queue index of current worker thread
+    thread_local const State *currentState = nullptr;
+    thread_local size_t currentIndex = kNoWorker;
+
+    // Each helped task may wait and help again, so nesting is limited to keep stack bounded
+    const size_t kMaxHelpingDepth = 16;
+    thread_local size_t helpingDepth = 0;
+
+    bool canRunPendingTask(const State &state) {
+        return currentState == &state && helpingDepth < kMaxHelpingDepth;
+    }
+
+    bool popTask(State &state, size_t index, std::function<void()> &task, bool steal = true) {
+        auto &queues = state.queues;
+
+        // Own queue is processed in LIFO order to keep nested tasks hot
+        if (index != kNoWorker) {
+            auto &queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                --state.queueDepth;
+                return true;
+            }
+        }
+
+        if (!steal)
+            return false;
+
+        // Steal oldest task from other queues
+        auto start = index == kNoWorker ? 0 : index + 1;
+        for (size_t i = 0; i < queues.size(); ++i) {
+            auto &queue = *queues[(start + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --state.queueDepth;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool runPendingTask(State &state) {
+        std::function<void()> task;
+        if (!canRunPendingTask(state) || !popTask(state, currentIndex, task, false))
+            return false;
+
+        ++helpingDepth;
+        try {
+            task();
+        } catch (...) {}
+        --helpingDepth;
+
+        return true;
+    }
+
+    void workerLoop(const std::shared_ptr<State> &state, size_t index) {
+        currentState = state.get();
+        currentIndex = index;
+
+        while (true) {
+            std::function<void()> task;
+            if (popTask(*state, index, task)) {
+                try {
+                    task();
+                } catch (...) {}
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (state->stopped && state->queueDepth == 0)
+                break;
+            state->condition.wait(lock, [&state] { return state->stopped || state->queueDepth > 0; });
+        }
+    }
+}
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t threadCount)
+        : state_(std::make_shared<State>(std::max<size_t>(threadCount, 1))) {
+    // Each worker holds state, so tasks may release last reference to executor
+    auto state = state_;
+    for (size_t i = 0; i < state->queues.size(); ++i)
+        threads_.emplace_back([state, i] { workerLoop(state, i); });
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopped = true;
+    }
+    state_->condition.notify_all();
+
+    for (auto &thread : threads_) {
+        // Last reference to executor may be released by task running on its own worker
+        if (thread.get_id() == std::this_thread::get_id())
+            thread.detach();
+        else
+            thread.join();
+    }
+}
+
+void ThreadPoolExecutor::execute(std::function<void()> task) {
+    auto &state = *state_;
+    size_t index;
+    if (currentState != &state) {
+        // Tasks being finished during destruction still may schedule nested tasks
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.stopped)
+            throw std::logic_error("Executor is stopped.");
+    }
+
+    if (currentState == &state)
+        index = currentIndex;
+    else
+        index = state.nextQueue++ % state.queues.size();
+
+    {
+        auto &queue = *state.queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+        ++state.queueDepth;
+    }
+
+    // Lock guarantees sleeping worker either sees new depth or receives notification
+    { std::lock_guard<std::mutex> lock(state.mutex); }
+    state.condition.notify_one();
+}
+
+bool ThreadPoolExecutor::runPendingTask() {
+    // Helped task may destroy executor, so state is held until it returns
+    auto state = state_;
+
+    return ::runPendingTask(*state);
+}
+
+bool ThreadPoolExecutor::canRunPendingTask() const {
+    return ::canRunPendingTask(*state_);
+}
+
+std::function<bool()> ThreadPoolExecutor::pendingTaskRunner() {
+    if (!canRunPendingTask())
+        return nullptr;
+
+    auto state = state_;
+    return [state] { return ::runPendingTask(*state); };
+}
+
+size_t ThreadPoolExecutor::queueDepth() const { return state_->queueDepth; }
+
+size_t ThreadPoolExecutor::threadCount() const { return threads_.size(); }
+
+size_t ThreadPoolExecutor::defaultThreadCount() {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 4);
+}
+
+std::shared_ptr<ExecutorInterface> ThreadPoolExecutor::defaultExecutor() {
+    static auto executor = std::make_shared<ThreadPoolExecutor>();
+
+    return executor;
+}
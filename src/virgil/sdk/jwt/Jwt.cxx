@@ -34,9 +34,9 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
-#include <sstream>
 #include <virgil/sdk/jwt/Jwt.h>
 #include <virgil/sdk/util/Base64Url.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 
 using virgil::sdk::jwt::Jwt;
 using virgil::sdk::jwt::JwtHeaderContent;
@@ -44,6 +44,16 @@ using virgil::sdk::jwt::JwtBodyContent;
 using virgil::sdk::VirgilByteArray;
 using virgil::sdk::VirgilByteArrayUtils;
 using virgil::sdk::util::Base64Url;
+using virgil::sdk::serialization::JsonStreamDeserializer;
+
+namespace {
+    const std::string& decodePart(const char *part, size_t length, std::string &buffer) {
+        buffer.resize(length * 3 / 4);
+        buffer.resize(Base64Url::decode(part, length, reinterpret_cast<unsigned char *>(&buffer[0])));
+
+        return buffer;
+    }
+}
 
 Jwt::Jwt(JwtHeaderContent headerContent, JwtBodyContent bodyContent, VirgilByteArray signatureContent)
         : headerContent_(std::move(headerContent)), bodyContent_(std::move(bodyContent)),
@@ -52,18 +62,33 @@ Jwt::Jwt(JwtHeaderContent headerContent, JwtBodyContent bodyContent, VirgilByteA
     stringRepresentation_ = headerContent_.base64Url() + "." + bodyContent_.base64Url() + "." + signatureBase64Url();
 }
 
+Jwt::Jwt(JwtHeaderContent headerContent, JwtBodyContent bodyContent, VirgilByteArray signatureContent,
+         std::string stringRepresentation, VirgilByteArray dataToSign)
+        : headerContent_(std::move(headerContent)), bodyContent_(std::move(bodyContent)),
+          signatureContent_(std::move(signatureContent)), stringRepresentation_(std::move(stringRepresentation)),
+          dataToSign_(std::move(dataToSign)) {}
+
 Jwt Jwt::parse(const std::string &stringRepresentation) {
-    std::stringstream ss(stringRepresentation);
-    std::string item;
-    std::vector<std::string> parts;
-    while (std::getline(ss, item, '.'))
-        parts.push_back(item);
+    auto headerEnd = stringRepresentation.find('.');
+    auto bodyEnd = headerEnd == std::string::npos ? headerEnd : stringRepresentation.find('.', headerEnd + 1);
+    if (bodyEnd == std::string::npos || stringRepresentation.find('.', bodyEnd + 1) != std::string::npos)
+        throw std::logic_error("virgil-sdk:\n Jwt::parse token should consist of 3 parts");
+
+    auto data = stringRepresentation.data();
+    // Header and body Json are decoded into buffer reused by subsequent parses
+    thread_local std::string json;
+
+    auto headerContent = JsonStreamDeserializer<JwtHeaderContent>::fromJsonString(decodePart(data, headerEnd, json));
+    auto bodyContent = JsonStreamDeserializer<JwtBodyContent>::fromJsonString(
+            decodePart(data + headerEnd + 1, bodyEnd - headerEnd - 1, json));
 
-    auto headerContent = JwtHeaderContent::parse(parts[0]);
-    auto bodyContent = JwtBodyContent::parse(parts[1]);
-    auto signatureContent = VirgilByteArrayUtils::stringToBytes(Base64Url::decode(parts[2]));
+    auto signatureLength = stringRepresentation.size() - bodyEnd - 1;
+    auto signatureContent = VirgilByteArray(signatureLength * 3 / 4);
+    signatureContent.resize(Base64Url::decode(data + bodyEnd + 1, signatureLength, signatureContent.data()));
 
-    return Jwt(headerContent, bodyContent, signatureContent);
+    // Signed data is kept as it was received, rather than serialized again
+    return Jwt(std::move(headerContent), std::move(bodyContent), std::move(signatureContent),
+               stringRepresentation, VirgilByteArray(data, data + bodyEnd));
 }
 
 VirgilByteArray Jwt::dataToSign(const virgil::sdk::jwt::JwtHeaderContent &headerContent,
@@ -37,13 +37,13 @@
 #include <virgil/sdk/jwt/JwtBodyContent.h>
 #include <virgil/sdk/util/Base64Url.h>
 #include <virgil/sdk/serialization/JsonSerializer.h>
-#include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 
 using virgil::sdk::jwt::JwtBodyContent;
 using virgil::sdk::VirgilByteArray;
 using virgil::sdk::util::Base64Url;
 using virgil::sdk::serialization::JsonSerializer;
-using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::serialization::JsonStreamDeserializer;
 
 JwtBodyContent::JwtBodyContent(std::string appId, std::string identity,
                                std::time_t expiresAt, std::time_t issuedAt,
@@ -52,7 +52,7 @@ JwtBodyContent::JwtBodyContent(std::string appId, std::string identity,
           issuedAt_(issuedAt), additionalData_(std::move(additionalData)) {}
 
 JwtBodyContent JwtBodyContent::parse(const std::string &base64url) {
-    return JsonDeserializer<JwtBodyContent>::fromJsonString(Base64Url::decode(base64url));
+    return JsonStreamDeserializer<JwtBodyContent>::fromJsonString(Base64Url::decode(base64url));
 }
 
 std::string JwtBodyContent::base64Url() const {
@@ -35,6 +35,8 @@
  */
 
 #include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/executors/ExecutorUtils.h>
+#include <virgil/sdk/util/Base64Url.h>
 
 using virgil::sdk::jwt::JwtGenerator;
 using virgil::sdk::jwt::Jwt;
@@ -42,20 +44,54 @@ using virgil::sdk::jwt::JwtHeaderContent;
 using virgil::sdk::jwt::JwtBodyContent;
 using virgil::sdk::crypto::Crypto;
 using virgil::sdk::crypto::keys::PrivateKey;
+using virgil::sdk::executors::ExecutorInterface;
+using virgil::sdk::executors::ExecutorUtils;
+using virgil::sdk::util::Base64Url;
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::VirgilByteArrayUtils;
 
 JwtGenerator::JwtGenerator(PrivateKey apiKey, std::string apiPublicKeyIdentifier,
-                           std::shared_ptr<Crypto> crypto, std::string appId, int ttl)
+                           std::shared_ptr<Crypto> crypto, std::string appId, int ttl,
+                           std::shared_ptr<ExecutorInterface> executor)
         : apiKey_(std::move(apiKey)), apiPublicKeyIdentifier_(std::move(apiPublicKeyIdentifier)),
-          crypto_(std::move(crypto)), appId_(std::move(appId)), ttl_(ttl) {}
+          crypto_(std::move(crypto)), appId_(std::move(appId)), ttl_(ttl), executor_(std::move(executor)),
+          headerContent_(apiPublicKeyIdentifier_) {
+    // Header and exported key are the same for every token, so they are prepared once
+    headerBase64Url_ = headerContent_.base64Url();
+    exportedApiKey_ = crypto_->exportPrivateKey(apiKey_);
+}
 
 Jwt JwtGenerator::generateToken(const std::string &identity,
                                 const std::unordered_map<std::string, std::string> &additionalData) const {
-    auto headerContent = JwtHeaderContent(apiPublicKeyIdentifier_);
-    auto bodyContent = JwtBodyContent(appId_, identity, std::time(0) + ttl_, std::time(0), additionalData);
-    auto data = Jwt::dataToSign(headerContent, bodyContent);
-    auto signatureContent = crypto_->generateSignature(data, apiKey_);
+    return generateToken(identity, additionalData, std::time(0));
+}
+
+std::vector<Jwt> JwtGenerator::generateTokens(const std::vector<std::string> &identities,
+                                              const std::unordered_map<std::string, std::string> &additionalData) const {
+    auto issuedAt = std::time(0);
+    auto generateChunk = [this, &identities, &additionalData, issuedAt](size_t begin, size_t end) {
+        auto tokens = std::vector<Jwt>();
+        tokens.reserve(end - begin);
+        for (auto i = begin; i < end; ++i)
+            tokens.push_back(generateToken(identities[i], additionalData, issuedAt));
 
-    return Jwt(headerContent, bodyContent, signatureContent);
+        return tokens;
+    };
+
+    return ExecutorUtils::mapChunks(executor_, identities.size(), generateChunk);
+}
+
+Jwt JwtGenerator::generateToken(const std::string &identity,
+                                const std::unordered_map<std::string, std::string> &additionalData,
+                                std::time_t issuedAt) const {
+    auto bodyContent = JwtBodyContent(appId_, identity, issuedAt + ttl_, issuedAt, additionalData);
+    auto stringRepresentation = headerBase64Url_ + "." + bodyContent.base64Url();
+    auto data = VirgilByteArrayUtils::stringToBytes(stringRepresentation);
+    auto signatureContent = crypto_->generateSignature(data, exportedApiKey_);
+    stringRepresentation += "." + Base64Url::encode(VirgilByteArrayUtils::bytesToString(signatureContent));
+
+    return Jwt(headerContent_, std::move(bodyContent), std::move(signatureContent),
+               std::move(stringRepresentation), std::move(data));
 }
 
 const PrivateKey& JwtGenerator::apiKey() const { return apiKey_; }
@@ -66,4 +102,6 @@ const std::shared_ptr<Crypto>& JwtGenerator::crypto() const { return crypto_; }
 
 const std::string& JwtGenerator::appId() const { return appId_; }
 
-int JwtGenerator::ttl() const { return ttl_; }
\ No newline at end of file
+int JwtGenerator::ttl() const { return ttl_; }
+
+const std::shared_ptr<ExecutorInterface>& JwtGenerator::executor() const { return executor_; }
@@ -37,12 +37,12 @@
 #include <virgil/sdk/jwt/JwtHeaderContent.h>
 #include <virgil/sdk/util/Base64Url.h>
 #include <virgil/sdk/serialization/JsonSerializer.h>
-#include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 
 using virgil::sdk::jwt::JwtHeaderContent;
 using virgil::sdk::util::Base64Url;
 using virgil::sdk::serialization::JsonSerializer;
-using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::serialization::JsonStreamDeserializer;
 
 JwtHeaderContent::JwtHeaderContent(std::string keyIdentifier, std::string algorithm,
                                    std::string type, std::string contentType)
@@ -50,7 +50,7 @@ JwtHeaderContent::JwtHeaderContent(std::string keyIdentifier, std::string algori
           type_(std::move(type)), contentType_(std::move(contentType)) {}
 
 JwtHeaderContent JwtHeaderContent::parse(const std::string &base64url) {
-    return JsonDeserializer<JwtHeaderContent>::fromJsonString(Base64Url::decode(base64url));
+    return JsonStreamDeserializer<JwtHeaderContent>::fromJsonString(Base64Url::decode(base64url));
 }
 
 std::string JwtHeaderContent::base64Url() const {
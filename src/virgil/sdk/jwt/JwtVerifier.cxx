@@ -40,25 +40,136 @@ using virgil::sdk::jwt::JwtVerifier;
 using virgil::sdk::jwt::Jwt;
 using virgil::sdk::crypto::Crypto;
 using virgil::sdk::crypto::keys::PublicKey;
+using virgil::sdk::executors::ExecutorInterface;
 
-JwtVerifier::JwtVerifier(PublicKey apiPublicKey, std::string apiPublicKeyIdentifier, std::shared_ptr<Crypto> crypto)
+JwtVerifier::JwtVerifier(PublicKey apiPublicKey, std::string apiPublicKeyIdentifier, std::shared_ptr<Crypto> crypto,
+                         size_t verificationCacheSize, std::shared_ptr<ExecutorInterface> executor)
         : apiPublicKey_(std::move(apiPublicKey)),
           apiPublicKeyIdentifier_(std::move(apiPublicKeyIdentifier)),
-          crypto_(std::move(crypto)) {}
+          crypto_(std::move(crypto)),
+          verificationCacheSize_(verificationCacheSize),
+          verificationCache_(verificationCacheSize > 0 ? std::make_shared<VerificationCache>() : nullptr),
+          executor_(std::move(executor)) {
+    exportedApiPublicKey_ = crypto_->exportPublicKey(apiPublicKey_);
+}
 
 bool JwtVerifier::verifyToken(const Jwt &token) const {
     try {
         const auto& data = token.dataToSign();
         const auto& signature = token.signatureContent();
 
-        return crypto_->verify(data, signature, apiPublicKey_);
+        if (verificationCache_ == nullptr)
+            return crypto_->verify(data, signature, exportedApiPublicKey_);
+
+        auto now = std::time(0);
+        auto key = std::string(signature.begin(), signature.end());
+        if (isCachedVerification(token, key, now))
+            return true;
+
+        if (!crypto_->verify(data, signature, exportedApiPublicKey_))
+            return false;
+
+        cacheVerification(token, std::move(key), now);
+
+        return true;
     } catch (...) {
         return false;
     }
 }
 
+std::vector<bool> JwtVerifier::verifyTokens(const std::vector<Jwt> &tokens) const {
+    auto now = std::time(0);
+    auto results = std::vector<bool>(tokens.size(), false);
+
+    // Only tokens missing in cache go to batch
+    auto pending = std::vector<size_t>();
+    auto keys = std::vector<std::string>();
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (verificationCache_ != nullptr) {
+            const auto& signature = tokens[i].signatureContent();
+            auto key = std::string(signature.begin(), signature.end());
+            if (isCachedVerification(tokens[i], key, now)) {
+                results[i] = true;
+                continue;
+            }
+            keys.push_back(std::move(key));
+        }
+        pending.push_back(i);
+    }
+
+    auto items = std::vector<Crypto::VerificationItem>();
+    items.reserve(pending.size());
+    for (auto i : pending)
+        items.emplace_back(tokens[i].dataToSign(), tokens[i].signatureContent(), apiPublicKey_);
+
+    auto verified = crypto_->verifyBatch(items, executor_);
+
+    for (size_t j = 0; j < pending.size(); ++j) {
+        if (!verified[j])
+            continue;
+
+        results[pending[j]] = true;
+        if (verificationCache_ != nullptr)
+            cacheVerification(tokens[pending[j]], std::move(keys[j]), now);
+    }
+
+    return results;
+}
+
+bool JwtVerifier::isCachedVerification(const Jwt &token, const std::string &key, std::time_t now) const {
+    std::lock_guard<std::mutex> lock(verificationCache_->mutex);
+
+    auto it = verificationCache_->verifications.find(key);
+    if (it == verificationCache_->verifications.end())
+        return false;
+
+    if (it->second.expiresAt <= now) {
+        verificationCache_->verifications.erase(it);
+        return false;
+    }
+
+    // Signature alone can't identify token, as it may be attached to other data
+    return it->second.dataToSign == token.dataToSign();
+}
+
+void JwtVerifier::cacheVerification(const Jwt &token, std::string key, std::time_t now) const {
+    auto expiresAt = token.bodyContent().expiresAt();
+    if (expiresAt <= now)
+        return;
+
+    std::lock_guard<std::mutex> lock(verificationCache_->mutex);
+    auto& verifications = verificationCache_->verifications;
+
+    if (verifications.size() >= verificationCacheSize_) {
+        for (auto it = verifications.begin(); it != verifications.end();) {
+            if (it->second.expiresAt <= now)
+                it = verifications.erase(it);
+            else
+                ++it;
+        }
+
+        if (verifications.size() >= verificationCacheSize_)
+            verifications.erase(verifications.begin());
+    }
+
+    verifications[std::move(key)] = CachedVerification { token.dataToSign(), expiresAt };
+}
+
 const PublicKey& JwtVerifier::apiPublicKey() const { return apiPublicKey_; }
 
 const std::string& JwtVerifier::apiPublicKeyIdentifier() const { return apiPublicKeyIdentifier_; }
 
-const std::shared_ptr<Crypto>& JwtVerifier::crypto() const { return crypto_; }
\ No newline at end of file
+const std::shared_ptr<Crypto>& JwtVerifier::crypto() const { return crypto_; }
+
+size_t JwtVerifier::verificationCacheSize() const { return verificationCacheSize_; }
+
+size_t JwtVerifier::cachedVerificationsCount() const {
+    if (verificationCache_ == nullptr)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(verificationCache_->mutex);
+
+    return verificationCache_->verifications.size();
+}
+
+const std::shared_ptr<ExecutorInterface>& JwtVerifier::executor() const { return executor_; }
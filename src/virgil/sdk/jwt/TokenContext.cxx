@@ -46,4 +46,6 @@ const std::string& TokenContext::operation() const { return operation_; }
 
 const std::string& TokenContext::identity() const { return identity_; }
 
+const std::string& TokenContext::service() const { return service_; }
+
 bool TokenContext::forceReload() const { return forceReload_; }
\ No newline at end of file
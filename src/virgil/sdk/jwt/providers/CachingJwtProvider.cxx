@@ -34,43 +34,204 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
+#include <algorithm>
+
 #include <virgil/sdk/jwt/providers/CachingJwtProvider.h>
 
 using virgil::sdk::jwt::providers::CachingJwtProvider;
 using virgil::sdk::jwt::interfaces::AccessTokenInterface;
 using virgil::sdk::jwt::TokenContext;
 using virgil::sdk::jwt::Jwt;
+using virgil::sdk::executors::ExecutorInterface;
+
+namespace {
+    // Token is considered expired a bit earlier, so that it doesn't expire on its way to the service
+    const std::time_t expirationMargin = 5;
+
+    const size_t shardsCount = 16;
+}
+
+CachingJwtProvider::State::State(size_t shardsCount, size_t maxShardEntries)
+        : shards(shardsCount), maxShardEntries(maxShardEntries) {}
 
-CachingJwtProvider::CachingJwtProvider(std::function<std::future<std::string>(const TokenContext &)> renewJwtCallback)
-        : renewJwtCallback_(std::move(renewJwtCallback)), jwt_(nullptr) {}
+CachingJwtProvider::Shard& CachingJwtProvider::State::shard(const std::string &key) {
+    return shards[std::hash<std::string>()(key) % shards.size()];
+}
+
+CachingJwtProvider::CachingJwtProvider(std::function<std::future<std::string>(const TokenContext &)> renewJwtCallback,
+                                       std::shared_ptr<ExecutorInterface> executor, double refreshFraction,
+                                       size_t maxEntries)
+        : renewJwtCallback_(std::move(renewJwtCallback)), executor_(std::move(executor)),
+          refreshFraction_(refreshFraction), maxEntries_(maxEntries),
+          state_(std::make_shared<State>(shardsCount, std::max<size_t>(1, (maxEntries + shardsCount - 1) / shardsCount))) {}
 
 std::future<std::shared_ptr<AccessTokenInterface>> CachingJwtProvider::getToken(const TokenContext &tokenContext) {
-    auto future = std::async([=]{
-        std::promise<std::shared_ptr<AccessTokenInterface>> p;
+    auto key = cacheKey(tokenContext);
+    auto& shard = state_->shard(key);
 
-        if (jwt_ == nullptr || jwt_->isExpired(std::time(0) + 5)) {
-            try {
-                auto future = renewJwtCallback_(tokenContext);
-                auto jwt = Jwt::parse(future.get());
-                jwt_ = std::make_shared<Jwt>(jwt);
-            } catch (...) {
-                p.set_exception(std::current_exception());
+    std::shared_ptr<Jwt> cachedJwt;
+    std::shared_future<std::shared_ptr<Jwt>> renewal;
+    std::function<void()> renewalTask;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto now = std::time(0);
 
-                return p.get_future().get();
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            auto& jwt = it->second.jwt;
+            if (!tokenContext.forceReload() && jwt != nullptr && !jwt->isExpired(now + expirationMargin)) {
+                cachedJwt = jwt;
+                if (now >= refreshTime(*jwt))
+                    renewalTask = startRenewal(key, it->second, tokenContext);
             }
+        } else {
+            evict(shard, state_->maxShardEntries, now);
+            it = shard.entries.emplace(key, Entry()).first;
+        }
+
+        if (cachedJwt == nullptr) {
+            renewalTask = startRenewal(key, it->second, tokenContext);
+            renewal = it->second.renewal;
+        }
+    }
+
+    // Executor may run task inline, and task locks the shard, so it's scheduled only after the lock is released
+    if (renewalTask) {
+        try {
+            executor_->execute(std::move(renewalTask));
+        } catch (...) {
+            // Task is dropped, so waiters get broken promise, and next call starts renewal again
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end())
+                it->second.renewal = std::shared_future<std::shared_ptr<Jwt>>();
+            // Failed background renewal doesn't affect valid cached token
+            if (cachedJwt == nullptr)
+                throw;
         }
-        p.set_value(jwt_);
+    }
+
+    if (cachedJwt != nullptr) {
+        std::promise<std::shared_ptr<AccessTokenInterface>> p;
+        p.set_value(cachedJwt);
 
-        return p.get_future().get();
+        return p.get_future();
+    }
+
+    auto executor = executor_;
+
+    return std::async(std::launch::deferred, [executor, renewal]() -> std::shared_ptr<AccessTokenInterface> {
+        return executor->get(renewal);
     });
+}
+
+std::function<void()> CachingJwtProvider::startRenewal(const std::string &key, Entry &entry,
+                                                       const TokenContext &tokenContext) {
+    if (entry.renewal.valid())
+        return std::function<void()>();
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Jwt>>>();
+    entry.renewal = promise->get_future().share();
+
+    auto state = state_;
+    auto executor = executor_;
+    auto renewJwtCallback = renewJwtCallback_;
+
+    return [state, key, executor, renewJwtCallback, tokenContext, promise] {
+        std::shared_ptr<Jwt> jwt;
+        std::exception_ptr exception;
+        try {
+            jwt = std::make_shared<Jwt>(Jwt::parse(executor->get(renewJwtCallback(tokenContext))));
+        } catch (...) {
+            exception = std::current_exception();
+        }
 
-    return future;
+        {
+            auto& shard = state->shard(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            // Entries with renewal in progress are not evicted
+            auto& entry = shard.entries[key];
+            if (jwt != nullptr)
+                entry.jwt = jwt;
+            entry.renewal = std::shared_future<std::shared_ptr<Jwt>>();
+        }
+
+        if (exception)
+            promise->set_exception(exception);
+        else
+            promise->set_value(jwt);
+    };
+}
+
+void CachingJwtProvider::evict(Shard &shard, size_t maxShardEntries, std::time_t now) {
+    // Entries with renewal in progress are awaited by callers, so they are kept even if that exceeds the limit
+    if (shard.entries.size() < maxShardEntries)
+        return;
+
+    auto soonest = shard.entries.end();
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+        auto& entry = it->second;
+        if (entry.renewal.valid()) {
+            ++it;
+        } else if (entry.jwt == nullptr || entry.jwt->isExpired(now)) {
+            it = shard.entries.erase(it);
+        } else {
+            if (soonest == shard.entries.end() ||
+                entry.jwt->bodyContent().expiresAt() < soonest->second.jwt->bodyContent().expiresAt())
+                soonest = it;
+            ++it;
+        }
+    }
+
+    if (shard.entries.size() >= maxShardEntries && soonest != shard.entries.end())
+        shard.entries.erase(soonest);
+}
+
+std::string CachingJwtProvider::cacheKey(const TokenContext &tokenContext) {
+    std::string key;
+    key.reserve(tokenContext.service().size() + tokenContext.operation().size() + tokenContext.identity().size() + 2);
+    key.append(tokenContext.service()).push_back('\0');
+    key.append(tokenContext.operation()).push_back('\0');
+    key.append(tokenContext.identity());
+
+    return key;
+}
+
+std::time_t CachingJwtProvider::refreshTime(const Jwt &jwt) const {
+    auto issuedAt = jwt.bodyContent().issuedAt();
+    auto lifetime = jwt.bodyContent().expiresAt() - issuedAt;
+
+    return issuedAt + static_cast<std::time_t>(lifetime * refreshFraction_);
 }
 
 const std::function<std::future<std::string>(const TokenContext&)>& CachingJwtProvider::renewJwtCallback() const {
     return renewJwtCallback_;
 }
 
-const std::shared_ptr<Jwt>& CachingJwtProvider::jwt() const {
-    return jwt_;
-}
\ No newline at end of file
+std::shared_ptr<Jwt> CachingJwtProvider::jwt(const TokenContext &tokenContext) const {
+    auto key = cacheKey(tokenContext);
+    auto& shard = state_->shard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+
+    return it != shard.entries.end() ? it->second.jwt : nullptr;
+}
+
+size_t CachingJwtProvider::size() const {
+    size_t size = 0;
+    for (auto& shard : state_->shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto& entry : shard.entries)
+            if (entry.second.jwt != nullptr)
+                ++size;
+    }
+
+    return size;
+}
+
+const std::shared_ptr<ExecutorInterface>& CachingJwtProvider::executor() const { return executor_; }
+
+double CachingJwtProvider::refreshFraction() const { return refreshFraction_; }
+
+size_t CachingJwtProvider::maxEntries() const { return maxEntries_; }
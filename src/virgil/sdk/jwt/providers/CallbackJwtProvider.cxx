@@ -41,16 +41,17 @@ using virgil::sdk::jwt::providers::CallbackJwtProvider;
 using virgil::sdk::jwt::interfaces::AccessTokenInterface;
 using virgil::sdk::jwt::TokenContext;
 using virgil::sdk::jwt::Jwt;
+using virgil::sdk::executors::ExecutorInterface;
 
-CallbackJwtProvider::CallbackJwtProvider(std::function<std::future<std::string>(const TokenContext&)> getTokenCallback)
-        : getTokenCallback_(std::move(getTokenCallback)) {}
+CallbackJwtProvider::CallbackJwtProvider(std::function<std::future<std::string>(const TokenContext&)> getTokenCallback,
+                                         std::shared_ptr<ExecutorInterface> executor)
+        : getTokenCallback_(std::move(getTokenCallback)), executor_(std::move(executor)) {}
 
 std::future<std::shared_ptr<AccessTokenInterface>> CallbackJwtProvider::getToken(const TokenContext &tokenContext) {
-    auto future = std::async([=]{
+    auto future = executor_->submit([=]{
         std::promise<std::shared_ptr<AccessTokenInterface>> p;
         try {
-            auto future = getTokenCallback_(tokenContext);
-            auto jwt = Jwt::parse(future.get());
+            auto jwt = Jwt::parse(executor_->get(getTokenCallback_(tokenContext)));
             p.set_value(std::make_shared<Jwt>(jwt));
         } catch (...) {
             p.set_exception(std::current_exception());
@@ -64,4 +65,6 @@ std::future<std::shared_ptr<AccessTokenInterface>> CallbackJwtProvider::getToken
 
 const std::function<std::future<std::string>(const TokenContext&)>& CallbackJwtProvider::getTokenCallback() const {
     return getTokenCallback_;
-}
\ No newline at end of file
+}
+
+const std::shared_ptr<ExecutorInterface>& CallbackJwtProvider::executor() const { return executor_; }
@@ -39,8 +39,10 @@
 #include <nlohman/json.hpp>
 
 #include <virgil/sdk/util/JsonKey.h>
+#include <virgil/sdk/util/JsonSaxHandler.h>
 #include <virgil/sdk/util/JsonUtils.h>
 #include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 #include <virgil/sdk/serialization/CanonicalSerializer.h>
 #include <virgil/sdk/jwt/JwtBodyContent.h>
 #include <ctime>
@@ -49,8 +51,86 @@ using json = nlohmann::json;
 
 using virgil::sdk::jwt::JwtBodyContent;
 using virgil::sdk::util::JsonKey;
+using virgil::sdk::util::JsonSaxHandler;
 using virgil::sdk::util::JsonUtils;
 
+namespace {
+    struct JwtBodyContentSaxHandler : public JsonSaxHandler<JwtBodyContentSaxHandler> {
+        bool Default() {
+            return !inAdditionalData() ? JsonSaxHandler::Default() : fail("expected string");
+        }
+
+        bool String(const char *str, rapidjson::SizeType length, bool) {
+            if (inAdditionalData()) {
+                additionalData[key_].assign(str, length);
+            } else if (depth_ == 1 && key_ == JsonKey::AppId) {
+                appId.assign(str, length).erase(0, 7);
+                ++fieldsCount;
+            } else if (depth_ == 1 && key_ == JsonKey::IdentityJWT) {
+                identity.assign(str, length).erase(0, 9);
+                ++fieldsCount;
+            } else
+                return Default();
+
+            return true;
+        }
+
+        bool Int(int value) { return Int64(value); }
+
+        bool Uint(unsigned value) { return Int64(value); }
+
+        bool Int64(int64_t value) {
+            if (!isTimestamp())
+                return Default();
+
+            (key_ == JsonKey::IssuedAt ? issuedAt : expiresAt) = value;
+            ++fieldsCount;
+
+            return true;
+        }
+
+        bool Uint64(uint64_t) {
+            return !isTimestamp() ? Default() : fail("integer overflow");
+        }
+
+        bool Double(double) {
+            return !isTimestamp() ? Default() : fail("expected integer");
+        }
+
+        bool StartObject() {
+            if (inAdditionalData())
+                return fail("expected string");
+
+            if (depth_ == 1 && key_ == JsonKey::AdditionalData)
+                additionalDataStarted = true;
+
+            return JsonSaxHandler::StartObject();
+        }
+
+        bool EndObject(rapidjson::SizeType length) {
+            if (inAdditionalData())
+                additionalDataStarted = false;
+
+            return JsonSaxHandler::EndObject(length);
+        }
+
+        bool StartArray() {
+            return !inAdditionalData() ? JsonSaxHandler::StartArray() : fail("expected string");
+        }
+
+        // Additional data values are strings, so no other object can start inside of it
+        bool inAdditionalData() const { return additionalDataStarted && depth_ == 2; }
+
+        bool isTimestamp() const { return depth_ == 1 && (key_ == JsonKey::IssuedAt || key_ == JsonKey::ExpiresAt); }
+
+        std::string appId, identity;
+        long long issuedAt = 0, expiresAt = 0;
+        std::unordered_map<std::string, std::string> additionalData;
+        bool additionalDataStarted = false;
+        int fieldsCount = 0;
+    };
+}
+
 namespace virgil {
     namespace sdk {
         namespace serialization {
@@ -84,6 +164,31 @@ namespace virgil {
                 JsonDeserializer() = delete;
             };
 
+            template<>
+            class JsonStreamDeserializer<JwtBodyContent> {
+            public:
+                template<int FAKE = 0>
+                static JwtBodyContent fromJsonString(const std::string &jsonString) {
+                    try {
+                        JwtBodyContentSaxHandler handler;
+                        handler.parse(jsonString);
+
+                        if (handler.fieldsCount != 4)
+                            throw std::logic_error("body fields are missing");
+
+                        return JwtBodyContent(std::move(handler.appId), std::move(handler.identity),
+                                              static_cast<std::time_t>(handler.expiresAt),
+                                              static_cast<std::time_t>(handler.issuedAt),
+                                              std::move(handler.additionalData));
+                    } catch (std::exception &exception) {
+                        throw std::logic_error(std::string("virgil-sdk:\n JsonStreamDeserializer<JwtBodyContent>::fromJsonString ") +
+                                               exception.what());
+                    }
+                }
+
+                JsonStreamDeserializer() = delete;
+            };
+
             template<>
             class JsonSerializer<JwtBodyContent> {
             public:
@@ -121,4 +226,7 @@ template JwtBodyContent
 virgil::sdk::serialization::JsonDeserializer<JwtBodyContent>::fromJson(const json&);
 
 template std::string
-virgil::sdk::serialization::JsonSerializer<JwtBodyContent>::toJson(const JwtBodyContent&);
\ No newline at end of file
+virgil::sdk::serialization::JsonSerializer<JwtBodyContent>::toJson(const JwtBodyContent&);
+
+template JwtBodyContent
+virgil::sdk::serialization::JsonStreamDeserializer<JwtBodyContent>::fromJsonString(const std::string&);
\ No newline at end of file
@@ -39,8 +39,10 @@
 #include <nlohman/json.hpp>
 
 #include <virgil/sdk/util/JsonKey.h>
+#include <virgil/sdk/util/JsonSaxHandler.h>
 #include <virgil/sdk/util/JsonUtils.h>
 #include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
 #include <virgil/sdk/serialization/CanonicalSerializer.h>
 #include <virgil/sdk/jwt/JwtHeaderContent.h>
 
@@ -48,8 +50,38 @@ using json = nlohmann::json;
 
 using virgil::sdk::jwt::JwtHeaderContent;
 using virgil::sdk::util::JsonKey;
+using virgil::sdk::util::JsonSaxHandler;
 using virgil::sdk::util::JsonUtils;
 
+namespace {
+    struct JwtHeaderContentSaxHandler : public JsonSaxHandler<JwtHeaderContentSaxHandler> {
+        bool String(const char *str, rapidjson::SizeType length, bool) {
+            std::string *field = nullptr;
+            if (depth_ == 1) {
+                if (key_ == JsonKey::KeyIdentifier)
+                    field = &keyIdentifier;
+                else if (key_ == JsonKey::Algorithm)
+                    field = &algorithm;
+                else if (key_ == JsonKey::Type)
+                    field = &type;
+                else if (key_ == JsonKey::ContentType)
+                    field = &contentType;
+            }
+
+            if (field == nullptr)
+                return Default();
+
+            field->assign(str, length);
+            ++fieldsCount;
+
+            return true;
+        }
+
+        std::string keyIdentifier, algorithm, type, contentType;
+        int fieldsCount = 0;
+    };
+}
+
 namespace virgil {
     namespace sdk {
         namespace serialization {
@@ -77,6 +109,29 @@ namespace virgil {
                 JsonDeserializer() = delete;
             };
 
+            template<>
+            class JsonStreamDeserializer<JwtHeaderContent> {
+            public:
+                template<int FAKE = 0>
+                static JwtHeaderContent fromJsonString(const std::string &jsonString) {
+                    try {
+                        JwtHeaderContentSaxHandler handler;
+                        handler.parse(jsonString);
+
+                        if (handler.fieldsCount != 4)
+                            throw std::logic_error("header fields are missing");
+
+                        return JwtHeaderContent(std::move(handler.keyIdentifier), std::move(handler.algorithm),
+                                                std::move(handler.type), std::move(handler.contentType));
+                    } catch (std::exception &exception) {
+                        throw std::logic_error(std::string("virgil-sdk:\n JsonStreamDeserializer<JwtHeaderContent>::fromJsonString ") +
+                                               exception.what());
+                    }
+                }
+
+                JsonStreamDeserializer() = delete;
+            };
+
             template<>
             class JsonSerializer<JwtHeaderContent> {
             public:
@@ -112,4 +167,7 @@ template JwtHeaderContent
 virgil::sdk::serialization::JsonDeserializer<JwtHeaderContent>::fromJson(const json&);
 
 template std::string
-virgil::sdk::serialization::JsonSerializer<JwtHeaderContent>::toJson(const JwtHeaderContent&);
\ No newline at end of file
+virgil::sdk::serialization::JsonSerializer<JwtHeaderContent>::toJson(const JwtHeaderContent&);
+
+template JwtHeaderContent
+virgil::sdk::serialization::JsonStreamDeserializer<JwtHeaderContent>::fromJsonString(const std::string&);
\ No newline at end of file
@@ -41,6 +41,8 @@
 #include <virgil/sdk/util/JsonKey.h>
 #include <virgil/sdk/util/JsonUtils.h>
 #include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
+#include <virgil/sdk/serialization/RawSignedModelSaxHandler.h>
 #include <virgil/sdk/serialization/CanonicalSerializer.h>
 #include <virgil/sdk/client/models/RawSignedModel.h>
 
@@ -67,9 +69,9 @@ namespace virgil {
 
                         VirgilByteArray contentSnapshot = VirgilBase64::decode(snapshotStr);
 
-                        json signaturesJson = j[JsonKey::Signatures];
+                        const json& signaturesJson = j[JsonKey::Signatures];
 
-                        auto rawCard = RawSignedModel(contentSnapshot);
+                        auto rawCard = RawSignedModel(std::move(contentSnapshot));
                         for (auto& element : signaturesJson) {
                             std::string signer = element[JsonKey::Signer];
 
@@ -79,8 +81,8 @@ namespace virgil {
                             std::string signatureStr = element[JsonKey::Signature];
                             VirgilByteArray signatureBytes = VirgilBase64::decode(signatureStr);
 
-                            auto signature = RawSignature(signer, signatureBytes, snapshot);
-                            rawCard.addSignature(signature);
+                            rawCard.addSignature(RawSignature(std::move(signer), std::move(signatureBytes),
+                                                              std::move(snapshot)));
                         }
 
                         return rawCard;
@@ -93,6 +95,25 @@ namespace virgil {
                 JsonDeserializer() = delete;
             };
 
+            template<>
+            class JsonStreamDeserializer<RawSignedModel> {
+            public:
+                template<int FAKE = 0>
+                static RawSignedModel fromJsonString(const std::string &jsonString) {
+                    try {
+                        RawSignedModelSaxHandler handler(false);
+                        handler.parse(jsonString);
+
+                        return std::move(handler.models().front());
+                    } catch (std::exception &exception) {
+                        throw std::logic_error(std::string("virgil-sdk:\n JsonStreamDeserializer<RawSignedModel>::fromJsonString ") +
+                                               exception.what());
+                    }
+                }
+
+                JsonStreamDeserializer() = delete;
+            };
+
             template<>
             class JsonSerializer<RawSignedModel> {
             public:
@@ -112,7 +133,7 @@ namespace virgil {
                                 signatureJson[JsonKey::Snapshot] = VirgilBase64::encode(signature.snapshot());
                             }
                             signatureJson[JsonKey::Signature] = VirgilBase64::encode(signature.signature());
-                            signatures.push_back(signatureJson);
+                            signatures.push_back(std::move(signatureJson));
                         }
                         j[JsonKey::Signatures] = signatures;
 
@@ -137,4 +158,7 @@ template RawSignedModel
 virgil::sdk::serialization::JsonDeserializer<RawSignedModel>::fromJson(const json&);
 
 template std::string
-virgil::sdk::serialization::JsonSerializer<RawSignedModel>::toJson(const RawSignedModel&);
\ No newline at end of file
+virgil::sdk::serialization::JsonSerializer<RawSignedModel>::toJson(const RawSignedModel&);
+
+template RawSignedModel
+virgil::sdk::serialization::JsonStreamDeserializer<RawSignedModel>::fromJsonString(const std::string&);
@@ -39,6 +39,8 @@
 #include <nlohman/json.hpp>
 
 #include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
+#include <virgil/sdk/serialization/RawSignedModelSaxHandler.h>
 #include <virgil/sdk/client/models/RawSignedModel.h>
 #include <virgil/sdk/util/JsonKey.h>
 #include <virgil/sdk/util/JsonUtils.h>
@@ -75,6 +77,28 @@ namespace virgil {
 
                 JsonDeserializer() = delete;
             };
+
+            /**
+             * @brief JsonStreamDeserializer<std::vector<RawSignedModel>> specialization.
+             */
+            template<>
+            class JsonStreamDeserializer<std::vector<RawSignedModel>> {
+            public:
+                template<int FAKE = 0>
+                static std::vector<RawSignedModel> fromJsonString(const std::string &jsonString) {
+                    try {
+                        RawSignedModelSaxHandler handler(true);
+                        handler.parse(jsonString);
+
+                        return std::move(handler.models());
+                    } catch (std::exception &exception) {
+                        throw std::logic_error(std::string("virgil-sdk:\n JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString ") +
+                                               exception.what());
+                    }
+                }
+
+                JsonStreamDeserializer() = delete;
+            };
         }
     }
 }
@@ -83,4 +107,7 @@ namespace virgil {
  * Explicit methods instantiation
  */
 template std::vector<RawSignedModel>
-virgil::sdk::serialization::JsonDeserializer<std::vector<RawSignedModel>>::fromJson(const json&);
\ No newline at end of file
+virgil::sdk::serialization::JsonDeserializer<std::vector<RawSignedModel>>::fromJson(const json&);
+
+template std::vector<RawSignedModel>
+virgil::sdk::serialization::JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(const std::string&);
\ No newline at end of file
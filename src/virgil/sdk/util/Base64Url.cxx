@@ -34,7 +34,12 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
-#include <vector>
+#include <cstring>
+
+#if VIRGIL_SDK_BASE64URL_SSSE3
+#include <cpuid.h>
+#endif
+
 #include <virgil/sdk/util/Base64Url.h>
 
 using virgil::sdk::util::Base64Url;
@@ -47,42 +52,134 @@ const char Base64Url::base64_url_alphabet[] = {
         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '_'
 };
 
+#define X -1
+const signed char Base64Url::base64_url_decode_table[] = {
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X, 62,  X,  X,
+        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, X,  X,  X,  X,  X,  X,
+        X,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, X,  X,  X,  X, 63,
+        X, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+        X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X
+};
+#undef X
+
 std::string Base64Url::encode(const std::string &in) {
-    std::string out;
-    int val = 0, valb = -6;
-    size_t len = in.length();
-    unsigned int i = 0;
-    for (i = 0; i < len; i++) {
-        unsigned char c = in[i];
-        val = (val<<8) + c;
-        valb += 8;
-        while (valb >= 0) {
-            out.push_back(base64_url_alphabet[(val>>valb)&0x3F]);
-            valb -= 6;
-        }
+    auto length = in.length();
+    // No padding is added, so last incomplete group takes one char per 6 bits
+    std::string out((length * 4 + 2) / 3, '\0');
+    if (length == 0)
+        return out;
+
+    auto src = reinterpret_cast<const unsigned char *>(in.data());
+    auto dst = &out[0];
+
+    size_t i = 0;
+    if (isSsse3Supported()) {
+        i = encodeSsse3(src, length, dst);
+        dst += i / 3 * 4;
     }
-    if (valb > -6) {
-        out.push_back(base64_url_alphabet[((val<<8)>>(valb+8))&0x3F]);
+
+    for (; i + 3 <= length; i += 3) {
+        unsigned val = (src[i] << 16) | (src[i + 1] << 8) | src[i + 2];
+        *dst++ = base64_url_alphabet[(val >> 18) & 0x3F];
+        *dst++ = base64_url_alphabet[(val >> 12) & 0x3F];
+        *dst++ = base64_url_alphabet[(val >> 6) & 0x3F];
+        *dst++ = base64_url_alphabet[val & 0x3F];
     }
+
+    if (i + 1 == length) {
+        unsigned val = src[i] << 16;
+        *dst++ = base64_url_alphabet[(val >> 18) & 0x3F];
+        *dst++ = base64_url_alphabet[(val >> 12) & 0x3F];
+    } else if (i + 2 == length) {
+        unsigned val = (src[i] << 16) | (src[i + 1] << 8);
+        *dst++ = base64_url_alphabet[(val >> 18) & 0x3F];
+        *dst++ = base64_url_alphabet[(val >> 12) & 0x3F];
+        *dst++ = base64_url_alphabet[(val >> 6) & 0x3F];
+    }
+
     return out;
 }
 
 std::string Base64Url::decode(const std::string &in) {
-    std::string out;
-    std::vector<int> T(256, -1);
-    unsigned int i;
-    for (i =0; i < 64; i++) T[base64_url_alphabet[i]] = i;
-
-    int val = 0, valb = -8;
-    for (i = 0; i < in.length(); i++) {
-        unsigned char c = in[i];
-        if (T[c] == -1) break;
-        val = (val<<6) + T[c];
+    // Output is shrunk afterwards if input contains characters outside of alphabet
+    std::string out(in.length() * 3 / 4, '\0');
+    if (out.empty())
+        return out;
+
+    out.resize(decode(in.data(), in.length(), reinterpret_cast<unsigned char *>(&out[0])));
+
+    return out;
+}
+
+size_t Base64Url::decode(const char *in, size_t length, unsigned char *out) {
+    auto src = reinterpret_cast<const unsigned char *>(in);
+    auto dst = out;
+
+    size_t i = 0;
+    if (isSsse3Supported()) {
+        i = decodeSsse3(src, length, dst);
+        dst += i / 4 * 3;
+    }
+
+    for (; i + 4 <= length; i += 4) {
+        int a = base64_url_decode_table[src[i]], b = base64_url_decode_table[src[i + 1]],
+            c = base64_url_decode_table[src[i + 2]], d = base64_url_decode_table[src[i + 3]];
+        if ((a | b | c | d) < 0)
+            break;
+
+        unsigned val = (a << 18) | (b << 12) | (c << 6) | d;
+        *dst++ = static_cast<unsigned char>(val >> 16);
+        *dst++ = static_cast<unsigned char>(val >> 8);
+        *dst++ = static_cast<unsigned char>(val);
+    }
+
+    unsigned val = 0;
+    int valb = -8;
+    for (; i < length; ++i) {
+        int decoded = base64_url_decode_table[src[i]];
+        if (decoded < 0)
+            break;
+        val = (val << 6) | decoded;
         valb += 6;
         if (valb >= 0) {
-            out.push_back(char((val>>valb)&0xFF));
+            *dst++ = static_cast<unsigned char>(val >> valb);
             valb -= 8;
         }
     }
-    return out;
-}
\ No newline at end of file
+
+    return static_cast<size_t>(dst - out);
+}
+
+#if VIRGIL_SDK_BASE64URL_SSSE3
+bool Base64Url::isSsse3Supported() {
+    static const bool supported = [] {
+        unsigned eax, ebx, ecx, edx;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) != 0;
+    }();
+
+    return supported;
+}
+#else
+bool Base64Url::isSsse3Supported() {
+    return false;
+}
+
+size_t Base64Url::encodeSsse3(const unsigned char *, size_t, char *) {
+    return 0;
+}
+
+size_t Base64Url::decodeSsse3(const unsigned char *, size_t, unsigned char *) {
+    return 0;
+}
+#endif
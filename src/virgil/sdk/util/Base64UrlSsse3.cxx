@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/util/Base64Url.h>
+
+#if VIRGIL_SDK_BASE64URL_SSSE3
+
+#include <tmmintrin.h>
+
+using virgil::sdk::util::Base64Url;
+
+// Vectorized codec handles 12 bytes <-> 16 chars per step,
+// see W. Mula, D. Lemire "Faster Base64 Encoding and Decoding Using AVX2 Instructions"
+
+size_t Base64Url::encodeSsse3(const unsigned char *in, size_t length, char *out) {
+    const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62,
+                                           '_' - 63, 'A', 0, 0);
+
+    size_t i = 0;
+    // Each step loads 16 bytes, but consumes only 12
+    for (; i + 16 <= length; i += 12, out += 16) {
+        auto input = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), shuffle);
+
+        // Split every 3 bytes into 4 six-bit indices
+        auto t0 = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        auto t1 = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        auto indices = _mm_or_si128(t0, t1);
+
+        // Map indices to alphabet ranges: 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+        auto ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        auto less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        ranges = _mm_or_si128(ranges, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+        auto result = _mm_add_epi8(_mm_shuffle_epi8(shiftLut, ranges), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), result);
+    }
+
+    return i;
+}
+
+size_t Base64Url::decodeSsse3(const unsigned char *in, size_t length, unsigned char *out) {
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t i = 0;
+    // Each step stores 16 bytes, but produces only 12, so enough input must be left to fit output
+    for (; i + 24 <= length; i += 16, out += 12) {
+        auto input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+
+        // Bytes >= 0x80 are negative and fall out of all ranges
+        auto upper = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('A' - 1)),
+                                   _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), input));
+        auto lower = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('a' - 1)),
+                                   _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), input));
+        auto digit = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)),
+                                   _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), input));
+        auto dash = _mm_cmpeq_epi8(input, _mm_set1_epi8('-'));
+        auto underscore = _mm_cmpeq_epi8(input, _mm_set1_epi8('_'));
+
+        auto valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(dash, underscore)));
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+            break;
+
+        auto shift = _mm_or_si128(
+                _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                             _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+                _mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+                             _mm_or_si128(_mm_and_si128(dash, _mm_set1_epi8(62 - '-')),
+                                          _mm_and_si128(underscore, _mm_set1_epi8(63 - '_')))));
+        auto values = _mm_add_epi8(input, shift);
+
+        // Merge four 6-bit values into 3 bytes
+        auto merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(merged, pack));
+    }
+
+    return i;
+}
+
+#endif
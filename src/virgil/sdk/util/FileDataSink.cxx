@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/util/FileDataSink.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::util::FileDataSink;
+
+FileDataSink::FileDataSink(const std::string &path, size_t sizeHint) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd_ < 0)
+        throw std::system_error(errno, std::generic_category(), "virgil-sdk:\n FileDataSink can't open " + path);
+
+#if defined(__linux__)
+    // Reserving space upfront avoids extending file on every write, failure here is not critical
+    if (sizeHint > 0)
+        ::posix_fallocate(fd_, 0, static_cast<off_t>(sizeHint));
+#else
+    (void)sizeHint;
+#endif
+}
+
+FileDataSink::~FileDataSink() {
+    if (fd_ >= 0) {
+        // Drops space reserved but not written
+        (void)::ftruncate(fd_, static_cast<off_t>(offset_));
+        ::close(fd_);
+    }
+}
+
+bool FileDataSink::isGood() {
+    return isGood_ && fd_ >= 0;
+}
+
+void FileDataSink::write(const VirgilByteArray &data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        auto result = ::pwrite(fd_, data.data() + written, data.size() - written,
+                               static_cast<off_t>(offset_ + written));
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+
+            isGood_ = false;
+            throw std::system_error(errno, std::generic_category(), "virgil-sdk:\n FileDataSink::write failed");
+        }
+        written += static_cast<size_t>(result);
+    }
+    offset_ += written;
+}
+
+void FileDataSink::finish() {
+    if (fd_ < 0)
+        return;
+
+    auto fd = fd_;
+    fd_ = -1;
+    auto error = ::ftruncate(fd, static_cast<off_t>(offset_)) == 0 ? 0 : errno;
+    if (::close(fd) != 0 && error == 0)
+        error = errno;
+
+    if (error != 0)
+        throw std::system_error(error, std::generic_category(), "virgil-sdk:\n FileDataSink::finish failed");
+}
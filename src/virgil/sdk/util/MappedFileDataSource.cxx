@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/util/MappedFileDataSource.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::util::MappedFileDataSource;
+
+MappedFileDataSource::MappedFileDataSource(const std::string &path, size_t chunkSize)
+        : chunkSize_(chunkSize == 0 ? 1 : chunkSize) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "virgil-sdk:\n MappedFileDataSource can't open " + path);
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(),
+                                "virgil-sdk:\n MappedFileDataSource can't stat " + path);
+    }
+
+    size_ = static_cast<size_t>(fileStat.st_size);
+    device_ = static_cast<unsigned long long>(fileStat.st_dev);
+    inode_ = static_cast<unsigned long long>(fileStat.st_ino);
+    // Empty file can't be mapped
+    if (size_ > 0) {
+        auto mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        auto error = errno;
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            throw std::system_error(error, std::generic_category(),
+                                    "virgil-sdk:\n MappedFileDataSource can't map " + path);
+
+        ::madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const unsigned char *>(mapping);
+    } else {
+        ::close(fd);
+    }
+}
+
+MappedFileDataSource::~MappedFileDataSource() {
+    if (data_ != nullptr)
+        ::munmap(const_cast<unsigned char *>(data_), size_);
+}
+
+bool MappedFileDataSource::hasData() {
+    return position_ < size_;
+}
+
+VirgilByteArray MappedFileDataSource::read() {
+    auto length = std::min(chunkSize_, size_ - position_);
+    auto chunk = VirgilByteArray(data_ + position_, data_ + position_ + length);
+    position_ += length;
+
+    return chunk;
+}
+
+size_t MappedFileDataSource::size() const { return size_; }
+
+bool MappedFileDataSource::isSameFile(const std::string &path) const {
+    struct stat fileStat;
+    if (::stat(path.c_str(), &fileStat) != 0)
+        return false;
+
+    return static_cast<unsigned long long>(fileStat.st_dev) == device_
+           && static_cast<unsigned long long>(fileStat.st_ino) == inode_;
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/util/ReadAheadDataSource.h>
+
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::util::ReadAheadDataSource;
+
+ReadAheadDataSource::ReadAheadDataSource(std::istream &istream, size_t chunkSize, size_t maxBufferedChunks)
+        : istream_(istream), chunkSize_(chunkSize), chunks_(maxBufferedChunks) {
+    reader_ = std::thread([this] { readLoop(); });
+}
+
+ReadAheadDataSource::~ReadAheadDataSource() {
+    // Unblocks reader waiting for free space
+    chunks_.close();
+    reader_.join();
+}
+
+bool ReadAheadDataSource::hasData() {
+    if (!hasNextChunk_) {
+        hasNextChunk_ = chunks_.pop(nextChunk_);
+
+        // Error is stored before queue is closed, so it's visible once queue is drained
+        if (!hasNextChunk_ && error_)
+            std::rethrow_exception(error_);
+    }
+
+    return hasNextChunk_;
+}
+
+VirgilByteArray ReadAheadDataSource::read() {
+    if (!hasData())
+        return VirgilByteArray();
+
+    hasNextChunk_ = false;
+
+    return std::move(nextChunk_);
+}
+
+void ReadAheadDataSource::readLoop() {
+    try {
+        while (istream_.good()) {
+            auto chunk = VirgilByteArray(chunkSize_);
+            istream_.read(reinterpret_cast<char *>(chunk.data()), chunk.size());
+            chunk.resize(static_cast<size_t>(istream_.gcount()));
+            if (chunk.empty())
+                break;
+
+            if (!chunks_.push(std::move(chunk)))
+                return;
+        }
+    } catch (...) {
+        error_ = std::current_exception();
+    }
+
+    chunks_.close();
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <virgil/sdk/util/WriteBehindDataSink.h>
+
+#include <stdexcept>
+
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::util::WriteBehindDataSink;
+
+WriteBehindDataSink::WriteBehindDataSink(std::ostream &ostream, size_t maxBufferedChunks)
+        : ostream_(ostream), chunks_(maxBufferedChunks), isGood_(ostream.good()) {
+    writer_ = std::thread([this] { writeLoop(); });
+}
+
+WriteBehindDataSink::~WriteBehindDataSink() {
+    chunks_.close();
+    if (writer_.joinable())
+        writer_.join();
+}
+
+bool WriteBehindDataSink::isGood() {
+    return isGood_;
+}
+
+void WriteBehindDataSink::write(const VirgilByteArray &data) {
+    if (!chunks_.push(data))
+        isGood_ = false;
+}
+
+void WriteBehindDataSink::finish() {
+    chunks_.close();
+    if (writer_.joinable())
+        writer_.join();
+
+    if (!isGood_)
+        throw std::runtime_error("virgil-sdk:\n WriteBehindDataSink::finish writing to output stream failed");
+}
+
+void WriteBehindDataSink::writeLoop() {
+    auto chunk = VirgilByteArray();
+    while (chunks_.pop(chunk)) {
+        ostream_.write(reinterpret_cast<const char *>(chunk.data()), chunk.size());
+        if (!ostream_.good()) {
+            // Unblocks producer, remaining chunks can't be written anyway
+            isGood_ = false;
+            chunks_.close();
+            return;
+        }
+    }
+}
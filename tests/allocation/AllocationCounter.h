@@ -0,0 +1,78 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_ALLOCATIONCOUNTER_H
+#define VIRGIL_SDK_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+namespace virgil {
+namespace sdk {
+    namespace test {
+        /**
+         * @brief Counts operator new calls made on the current thread while counter is alive.
+         * @note Global operator new is replaced in AllocationCounter.cxx,
+         * so it's linked only into allocation_test_runner
+         */
+        class AllocationCounter {
+        public:
+            AllocationCounter();
+
+            ~AllocationCounter();
+
+            AllocationCounter(const AllocationCounter&) = delete;
+
+            AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+            /// Number of allocations since construction
+            size_t count() const;
+
+            template<typename F>
+            static size_t countIn(F function) {
+                AllocationCounter counter;
+                function();
+
+                return counter.count();
+            }
+
+        private:
+            size_t start_;
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_ALLOCATIONCOUNTER_H
@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include "AllocationCounter.h"
+
+#include <virgil/sdk/cards/CardManager.h>
+
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::test::AllocationCounter;
+
+namespace {
+    RawSignedModel generateRawCard(const std::shared_ptr<Crypto>& crypto, size_t signaturesCount) {
+        auto modelSigner = ModelSigner(crypto);
+        auto keyPair = crypto->generateKeyPair();
+        auto rawCard = CardManager::generateRawCard(crypto, modelSigner, keyPair.privateKey(),
+                                                    keyPair.publicKey(), "alice");
+
+        for (size_t i = 1; i < signaturesCount; ++i)
+            modelSigner.sign(rawCard, "signer" + std::to_string(i), keyPair.privateKey());
+
+        return rawCard;
+    }
+}
+
+TEST_CASE("test001_ParseCard_Allocations", "[card_allocations]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto rawCard1 = generateRawCard(crypto, 1);
+    auto rawCard5 = generateRawCard(crypto, 5);
+    auto rawCard9 = generateRawCard(crypto, 9);
+
+    REQUIRE(rawCard9.signatures().size() == 9);
+    REQUIRE(AllocationCounter::countIn([&] { rawCard9.signatures(); }) == 0);
+
+    // Warm up one-time initialization
+    CardManager::parseCard(rawCard1, crypto);
+
+    auto allocations1 = AllocationCounter::countIn([&] { CardManager::parseCard(rawCard1, crypto); });
+    auto allocations5 = AllocationCounter::countIn([&] { CardManager::parseCard(rawCard5, crypto); });
+    auto allocations9 = AllocationCounter::countIn([&] { CardManager::parseCard(rawCard9, crypto); });
+
+    // Each extra signature costs the same fixed number of allocations, at most one per CardSignature buffer
+    // (signer, signature, snapshot), rest of parsing doesn't depend on number of signatures
+    REQUIRE(allocations9 - allocations5 == allocations5 - allocations1);
+    REQUIRE(allocations5 - allocations1 <= 4 * 3);
+}
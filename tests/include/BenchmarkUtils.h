@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_BENCHMARKUTILS_H
+#define VIRGIL_SDK_BENCHMARKUTILS_H
+
+#include <chrono>
+#include <sys/resource.h>
+#include <iostream>
+#include <string>
+
+namespace virgil {
+namespace sdk {
+    namespace test {
+        class BenchmarkUtils {
+        public:
+            template<typename F>
+            static double opsPerSecond(size_t iterations, F operation) {
+                // Warm up
+                operation();
+
+                auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < iterations; ++i)
+                    operation();
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                return elapsed > 0 ? iterations / elapsed : 0;
+            }
+
+            /// Peak resident set size of the process in kilobytes
+            static size_t peakResidentSetSize() {
+                struct rusage usage;
+                getrusage(RUSAGE_SELF, &usage);
+
+                return static_cast<size_t>(usage.ru_maxrss);
+            }
+
+            static void report(const std::string& name, double value, const std::string& unit) {
+                std::cout << name << ": " << static_cast<size_t>(value) << " " << unit << std::endl;
+            }
+        };
+    }
+}
+}
+
+#endif //VIRGIL_SDK_BENCHMARKUTILS_H
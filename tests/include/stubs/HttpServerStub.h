@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#ifndef VIRGIL_SDK_HTTPSERVERSTUB_H
+#define VIRGIL_SDK_HTTPSERVERSTUB_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace virgil {
+    namespace sdk {
+        namespace test {
+            namespace stubs {
+                /**
+                 * @brief Minimal HTTP/1.1 server listening on loopback interface for networking tests.
+                 * Keeps client connections open between requests, unless handler asks to close them.
+                 * Handler can also drop connection without response to simulate failure of request, which was sent.
+                 */
+                class HttpServerStub {
+                public:
+                    struct Request {
+                        std::string method;
+                        std::string path;
+                        std::map<std::string, std::string> header;
+                        std::string body;
+                    };
+
+                    struct Response {
+                        int statusCode = 200;
+                        std::map<std::string, std::string> header;
+                        std::string body;
+                        std::chrono::milliseconds delay = std::chrono::milliseconds(0);
+                        bool closeConnection = false;
+                        bool dropConnection = false;
+                    };
+
+                    using Handler = std::function<Response(const Request &)>;
+
+                    explicit HttpServerStub(Handler handler);
+
+                    ~HttpServerStub();
+
+                    HttpServerStub(const HttpServerStub&) = delete;
+
+                    HttpServerStub& operator=(const HttpServerStub&) = delete;
+
+                    std::string baseAddress() const;
+
+                    size_t acceptedConnections() const;
+
+                    size_t handledRequests() const;
+
+                private:
+                    void acceptLoop();
+
+                    void serve(int socket);
+
+                    bool readRequest(int socket, std::string &buffer, Request &request);
+
+                    Handler handler_;
+                    int listenSocket_;
+                    unsigned short port_;
+                    std::atomic<bool> stopped_;
+                    std::atomic<size_t> acceptedConnections_;
+                    std::atomic<size_t> handledRequests_;
+                    std::mutex mutex_;
+                    std::vector<std::thread> workers_;
+                    std::thread acceptThread_;
+                };
+            }
+        }
+    }
+}
+
+#endif //VIRGIL_SDK_HTTPSERVERSTUB_H
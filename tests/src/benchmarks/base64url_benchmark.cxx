@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <random>
+
+#include <BenchmarkUtils.h>
+
+#include <virgil/sdk/util/Base64Url.h>
+
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::util::Base64Url;
+
+namespace {
+    // Previous byte-per-iteration implementation
+    std::string previousDecode(const std::string &in) {
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        std::string out;
+        std::vector<int> T(256, -1);
+        for (int i = 0; i < 64; i++)
+            T[alphabet[i]] = i;
+
+        int val = 0, valb = -8;
+        for (unsigned char c : in) {
+            if (T[c] == -1)
+                break;
+            val = (val << 6) + T[c];
+            valb += 6;
+            if (valb >= 0) {
+                out.push_back(char((val >> valb) & 0xFF));
+                valb -= 8;
+            }
+        }
+        return out;
+    }
+}
+
+TEST_CASE("benchmark003_Base64Url", "[.benchmark]") {
+    std::mt19937 random(3);
+    for (size_t size : { 256, 64 * 1024 }) {
+        const size_t iterations = 20 * 1024 * 1024 / size;
+        std::string data(size, '\0');
+        for (auto& c : data)
+            c = static_cast<char>(random());
+        auto encoded = Base64Url::encode(data);
+
+        // Results are accumulated, so assertions do not dominate timing of small inputs
+        size_t total = 0;
+        auto encodeSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            total += Base64Url::encode(data).size();
+        });
+        auto decodeSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            total += Base64Url::decode(encoded).size();
+        });
+        auto previousDecodeSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            total += previousDecode(encoded).size();
+        });
+        REQUIRE(total == (iterations + 1) * (encoded.size() + 2 * size));
+
+        auto name = "Base64Url " + std::to_string(size) + " bytes";
+        BenchmarkUtils::report(name + ", encode", encodeSpeed * size / (1024 * 1024), "MB/s");
+        BenchmarkUtils::report(name + ", decode", decodeSpeed * size / (1024 * 1024), "MB/s");
+        BenchmarkUtils::report(name + ", previous decode", previousDecodeSpeed * size / (1024 * 1024), "MB/s");
+    }
+}
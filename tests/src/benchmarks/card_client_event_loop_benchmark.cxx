@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+#include <catch.hpp>
+
+#include <memory>
+
+#include <BenchmarkUtils.h>
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/networking/EventLoopConnection.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::networking::Connection;
+using virgil::sdk::client::networking::EventLoopConnection;
+using virgil::sdk::client::networking::KeepAliveConnection;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+TEST_CASE("benchmark012_CardClient_GetCards_EventLoop", "[.benchmark]") {
+    const size_t cardsCount = 256;
+    const size_t iterations = 3;
+    auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+
+    auto cardIds = std::vector<std::string>();
+    for (size_t i = 0; i < cardsCount; ++i)
+        cardIds.push_back("card" + std::to_string(i));
+
+    HttpServerStub server([&](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        response.delay = std::chrono::milliseconds(20);
+        return response;
+    });
+
+    auto getCards = [&](const std::shared_ptr<Connection> &connection) {
+        CardClient cardClient(server.baseAddress(), connection);
+        return BenchmarkUtils::opsPerSecond(iterations, [&] {
+            REQUIRE(cardClient.getCards(cardIds, "token").get().size() == cardsCount);
+        });
+    };
+
+    auto blocking = getCards(std::make_shared<KeepAliveConnection>());
+    auto eventLoop = getCards(std::make_shared<EventLoopConnection>(1, 64));
+
+    BenchmarkUtils::report("getCards, request per executor thread", blocking * cardsCount, "cards/s");
+    BenchmarkUtils::report("getCards, event loop", eventLoop * cardsCount, "cards/s");
+}
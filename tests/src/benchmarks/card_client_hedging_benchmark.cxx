@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <BenchmarkUtils.h>
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/HedgingPolicy.h>
+#include <virgil/sdk/client/networking/EventLoopConnection.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::HedgingPolicy;
+using virgil::sdk::client::RetryPolicy;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::networking::EventLoopConnection;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+TEST_CASE("benchmark013_CardClient_GetCard_HedgedLatency", "[.benchmark]") {
+    const size_t requestsCount = 500;
+    auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+
+    // Every 40th response is slow
+    std::atomic<size_t> requests(0);
+    HttpServerStub server([&](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        response.delay = std::chrono::milliseconds(requests++ % 40 == 39 ? 200 : 5);
+        return response;
+    });
+
+    auto latencies = [&](const std::shared_ptr<HedgingPolicy> &hedgingPolicy) {
+        CardClient cardClient(server.baseAddress(), std::make_shared<EventLoopConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), std::make_shared<RetryPolicy>(), hedgingPolicy);
+        std::vector<double> result;
+        for (size_t i = 0; i < requestsCount; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            cardClient.getCard("card" + std::to_string(i), "token").get();
+            result.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(result.begin(), result.end());
+
+        return result;
+    };
+
+    auto single = latencies(nullptr);
+    auto fixedDelayPolicy = std::make_shared<HedgingPolicy>(0.05, std::chrono::milliseconds(20));
+    auto fixedDelay = latencies(fixedDelayPolicy);
+    auto observedDelayPolicy = std::make_shared<HedgingPolicy>(0.1);
+    auto observedDelay = latencies(observedDelayPolicy);
+
+    BenchmarkUtils::report("getCard p50, single request", single[requestsCount / 2], "ms");
+    BenchmarkUtils::report("getCard p99, single request", single[requestsCount * 99 / 100], "ms");
+    BenchmarkUtils::report("getCard p50, hedged after 20ms", fixedDelay[requestsCount / 2], "ms");
+    BenchmarkUtils::report("getCard p99, hedged after 20ms", fixedDelay[requestsCount * 99 / 100], "ms");
+    BenchmarkUtils::report("getCard p50, hedged after observed p95", observedDelay[requestsCount / 2], "ms");
+    BenchmarkUtils::report("getCard p99, hedged after observed p95", observedDelay[requestsCount * 99 / 100], "ms");
+    BenchmarkUtils::report("hedges per 1000 requests, hedged after 20ms",
+                           1000.0 * fixedDelayPolicy->hedges() / requestsCount, "");
+    BenchmarkUtils::report("hedges per 1000 requests, hedged after observed p95",
+                           1000.0 * observedDelayPolicy->hedges() / requestsCount, "");
+}
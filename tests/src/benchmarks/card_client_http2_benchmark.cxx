@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+#include <catch.hpp>
+
+#include <memory>
+
+#include <BenchmarkUtils.h>
+#include <stubs/HttpServerStub.h>
+#include <stubs/Http2ServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/networking/Http2Connection.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::networking::Connection;
+using virgil::sdk::client::networking::Http2Connection;
+using virgil::sdk::client::networking::KeepAliveConnection;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::test::stubs::Http2ServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+TEST_CASE("benchmark011_CardClient_GetCards_Http2", "[.benchmark]") {
+    if (!Http2Connection::isSupported()) {
+        WARN("libcurl is built without HTTP/2 support");
+        return;
+    }
+
+    const size_t cardsCount = 64;
+    const size_t iterations = 5;
+    const auto delay = std::chrono::milliseconds(20);
+    auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+
+    auto cardIds = std::vector<std::string>();
+    for (size_t i = 0; i < cardsCount; ++i)
+        cardIds.push_back("card" + std::to_string(i));
+
+    HttpServerStub http1Server([&](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        response.delay = delay;
+        return response;
+    });
+    Http2ServerStub http2Server([&](const Http2ServerStub::Request &) {
+        Http2ServerStub::Response response;
+        response.body = rawCardJson;
+        response.delay = delay;
+        return response;
+    });
+
+    auto getCards = [&](const std::string &serviceUrl, const std::shared_ptr<Connection> &connection) {
+        CardClient cardClient(serviceUrl, connection);
+        return BenchmarkUtils::opsPerSecond(iterations, [&] {
+            REQUIRE(cardClient.getCards(cardIds, "token").get().size() == cardsCount);
+        });
+    };
+
+    auto keepAlive = getCards(http1Server.baseAddress(), std::make_shared<KeepAliveConnection>());
+    auto http2 = getCards(http2Server.baseAddress(), std::make_shared<Http2Connection>());
+
+    BenchmarkUtils::report("getCards, HTTP/1.1 keep-alive", keepAlive * cardsCount, "cards/s");
+    BenchmarkUtils::report("getCards, HTTP/1.1 keep-alive connections", http1Server.acceptedConnections(), "connections");
+    BenchmarkUtils::report("getCards, HTTP/2 multiplexed", http2 * cardsCount, "cards/s");
+    BenchmarkUtils::report("getCards, HTTP/2 multiplexed connections", http2Server.acceptedConnections(), "connections");
+}
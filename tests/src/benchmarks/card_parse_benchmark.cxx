@@ -0,0 +1,95 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+#include <catch.hpp>
+
+#include <memory>
+
+#include <BenchmarkUtils.h>
+
+#include <virgil/sdk/cards/CardManager.h>
+
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::test::BenchmarkUtils;
+
+TEST_CASE("benchmark010_CardManager_ParseCardLazily", "[.benchmark]") {
+    const size_t cardsCount = 200;
+    const size_t iterations = 20;
+    auto crypto = std::make_shared<Crypto>();
+    ModelSigner modelSigner(crypto);
+
+    auto rawCards = std::vector<RawSignedModel>();
+    for (size_t i = 0; i < cardsCount; ++i) {
+        auto keyPair = crypto->generateKeyPair();
+        auto identity = i % 10 == 0 ? "alice" : "bob" + std::to_string(i);
+        rawCards.push_back(CardManager::generateRawCard(crypto, modelSigner, keyPair.privateKey(),
+                                                        keyPair.publicKey(), identity));
+    }
+
+    // Bulk import keeping only cards of one identity, public keys are used only for matching cards
+    auto filterByIdentity = [&](bool lazily) {
+        size_t matched = 0;
+        for (const auto& rawCard : rawCards) {
+            auto card = lazily ? CardManager::parseCardLazily(rawCard, crypto)
+                               : CardManager::parseCard(rawCard, crypto);
+            if (card.identity() == "alice") {
+                card.publicKey();
+                ++matched;
+            }
+        }
+        REQUIRE(matched == cardsCount / 10);
+    };
+
+    auto eager = BenchmarkUtils::opsPerSecond(iterations, [&] { filterByIdentity(false); });
+    auto lazy = BenchmarkUtils::opsPerSecond(iterations, [&] { filterByIdentity(true); });
+
+    BenchmarkUtils::report("Filter by identity, eager parseCard", eager * cardsCount, "cards/s");
+    BenchmarkUtils::report("Filter by identity, parseCardLazily", lazy * cardsCount, "cards/s");
+
+    auto eagerIdentifiers = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        for (const auto& rawCard : rawCards)
+            CardManager::parseCard(rawCard, crypto).identifier();
+    });
+    auto lazyIdentifiers = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        for (const auto& rawCard : rawCards)
+            CardManager::parseCardLazily(rawCard, crypto).identifier();
+    });
+
+    BenchmarkUtils::report("Card identifiers, eager parseCard", eagerIdentifiers * cardsCount, "cards/s");
+    BenchmarkUtils::report("Card identifiers, parseCardLazily", lazyIdentifiers * cardsCount, "cards/s");
+}
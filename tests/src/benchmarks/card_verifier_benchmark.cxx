@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <memory>
+
+#include <BenchmarkUtils.h>
+
+#include <virgil/sdk/cards/CardManager.h>
+#include <virgil/sdk/cards/verification/VirgilCardVerifier.h>
+
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::cards::verification::VerifierCredentials;
+using virgil::sdk::cards::verification::VirgilCardVerifier;
+using virgil::sdk::cards::verification::Whitelist;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::VirgilByteArrayUtils;
+
+TEST_CASE("benchmark001_VirgilCardVerifier_Whitelists", "[.benchmark]") {
+    const size_t iterations = 2000;
+    auto crypto = std::make_shared<Crypto>();
+    ModelSigner modelSigner(crypto);
+
+    auto keyPair = crypto->generateKeyPair();
+    auto rawCard = CardManager::generateRawCard(crypto, modelSigner, keyPair.privateKey(), keyPair.publicKey(), "alice");
+
+    auto credentials = std::vector<VerifierCredentials>();
+    for (int i = 0; i < 4; ++i) {
+        auto signerKeyPair = crypto->generateKeyPair();
+        auto signer = "signer" + std::to_string(i);
+        modelSigner.sign(rawCard, signer, signerKeyPair.privateKey());
+        credentials.push_back(VerifierCredentials(signer, crypto->exportPublicKey(signerKeyPair.publicKey())));
+    }
+    auto card = CardManager::parseCard(rawCard, crypto);
+    auto whitelists = std::vector<Whitelist> { Whitelist(credentials) };
+
+    // Previous implementation imported whitelist key for every verification
+    auto importEveryTime = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        for (const auto& whitelistCredentials : whitelists[0].verifierCredentials()) {
+            for (const auto& signature : card.signatures()) {
+                if (signature.signer() == whitelistCredentials.signer()) {
+                    auto publicKey = crypto->importPublicKey(whitelistCredentials.publicKey());
+                    auto snapshot = card.contentSnapshot();
+                    VirgilByteArrayUtils::append(snapshot, signature.snapshot());
+                    REQUIRE(crypto->verify(snapshot, signature.signature(), publicKey));
+                }
+            }
+        }
+    });
+
+    VirgilCardVerifier verifier(crypto, whitelists, false, false);
+    auto importedOnce = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        REQUIRE(verifier.verifyCard(card));
+    });
+
+    BenchmarkUtils::report("Whitelist verification, key imported per card", importEveryTime, "cards/s");
+    BenchmarkUtils::report("Whitelist verification, keys imported once", importedOnce, "cards/s");
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <BenchmarkUtils.h>
+#include <helpers.h>
+
+#include <virgil/sdk/crypto/Crypto.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::Utils;
+using virgil::sdk::VirgilByteArrayUtils;
+
+namespace {
+    // Comma separated sizes in MB, e.g. "100,1000,10240"
+    std::vector<size_t> benchmarkFileSizes() {
+        auto sizes = std::vector<size_t>();
+        auto env = std::getenv("VIRGIL_SDK_BENCHMARK_FILE_SIZES_MB");
+        std::stringstream ss(env != nullptr ? env : "100");
+        std::string item;
+        while (std::getline(ss, item, ','))
+            sizes.push_back(std::stoul(item));
+
+        return sizes;
+    }
+}
+
+TEST_CASE("benchmark008_Crypto_FileVsStream", "[.benchmark]") {
+    const size_t iterations = 1;
+    const std::string plainPath = "benchmark008.plain";
+    const std::string encryptedPath = "benchmark008.encrypted";
+    const std::string decryptedPath = "benchmark008.decrypted";
+
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    auto chunk = VirgilByteArrayUtils::bytesToString(Utils::generateRandomData(1024 * 1024));
+
+    for (auto megabytes : benchmarkFileSizes()) {
+        {
+            std::ofstream plainFile(plainPath, std::ios::binary);
+            for (size_t i = 0; i < megabytes; ++i)
+                plainFile << chunk;
+        }
+
+        auto streamEncryptSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            std::ifstream input(plainPath, std::ios::binary);
+            std::ofstream output(encryptedPath, std::ios::binary);
+            crypto.encrypt(input, output, { keyPair.publicKey() });
+        });
+        auto streamDecryptSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            std::ifstream input(encryptedPath, std::ios::binary);
+            std::ofstream output(decryptedPath, std::ios::binary);
+            crypto.decrypt(input, output, keyPair.privateKey());
+        });
+        auto streamSignSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            std::ifstream input(plainPath, std::ios::binary);
+            REQUIRE(!crypto.generateSignature(input, keyPair.privateKey()).empty());
+        });
+
+        auto fileEncryptSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            crypto.encryptFile(plainPath, encryptedPath, { keyPair.publicKey() });
+        });
+        auto fileDecryptSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            crypto.decryptFile(encryptedPath, decryptedPath, keyPair.privateKey());
+        });
+        auto signature = crypto.generateFileSignature(plainPath, keyPair.privateKey());
+        auto fileSignSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+            REQUIRE(crypto.generateFileSignature(plainPath, keyPair.privateKey()) == signature);
+        });
+
+        std::ifstream decryptedFile(decryptedPath, std::ios::binary | std::ios::ate);
+        REQUIRE(static_cast<size_t>(decryptedFile.tellg()) == megabytes * chunk.size());
+
+        auto size = std::to_string(megabytes) + " MB";
+        BenchmarkUtils::report("Encrypt stream, " + size, streamEncryptSpeed * megabytes, "MB/s");
+        BenchmarkUtils::report("Encrypt file, " + size, fileEncryptSpeed * megabytes, "MB/s");
+        BenchmarkUtils::report("Decrypt stream, " + size, streamDecryptSpeed * megabytes, "MB/s");
+        BenchmarkUtils::report("Decrypt file, " + size, fileDecryptSpeed * megabytes, "MB/s");
+        BenchmarkUtils::report("Sign stream, " + size, streamSignSpeed * megabytes, "MB/s");
+        BenchmarkUtils::report("Sign file, " + size, fileSignSpeed * megabytes, "MB/s");
+    }
+
+    std::remove(plainPath.c_str());
+    std::remove(encryptedPath.c_str());
+    std::remove(decryptedPath.c_str());
+}
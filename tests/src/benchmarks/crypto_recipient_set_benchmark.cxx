@@ -0,0 +1,71 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <BenchmarkUtils.h>
+#include <helpers.h>
+
+#include <virgil/sdk/crypto/Crypto.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::crypto::keys::PublicKey;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::Utils;
+
+TEST_CASE("benchmark009_Crypto_EncryptForGroup", "[.benchmark]") {
+    const size_t iterations = 20;
+    const size_t groupSize = 1000;
+
+    Crypto crypto;
+    auto publicKeys = std::vector<PublicKey>();
+    for (size_t i = 0; i < groupSize; ++i)
+        publicKeys.push_back(crypto.generateKeyPair().publicKey());
+    auto data = Utils::generateRandomData(1024);
+
+    size_t total = 0;
+    auto recipientSet = crypto.createRecipientSet(publicKeys);
+    auto recipientSetSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        total += crypto.encrypt(data, recipientSet).size();
+    });
+    auto speed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        total += crypto.encrypt(data, publicKeys).size();
+    });
+    REQUIRE(total > 0);
+
+    BenchmarkUtils::report("Encrypt for 1000 recipients, std::vector", speed, "messages/s");
+    BenchmarkUtils::report("Encrypt for 1000 recipients, RecipientSet", recipientSetSpeed, "messages/s");
+}
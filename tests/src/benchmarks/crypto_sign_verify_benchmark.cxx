@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <BenchmarkUtils.h>
+#include <helpers.h>
+
+#include <virgil/sdk/crypto/Crypto.h>
+#include <virgil/crypto/VirgilKeyPair.h>
+#include <virgil/crypto/VirgilSigner.h>
+
+using virgil::crypto::VirgilKeyPair;
+using virgil::crypto::VirgilSigner;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::Utils;
+using virgil::sdk::VirgilHashAlgorithm;
+
+TEST_CASE("benchmark006_Crypto_SignVerify", "[.benchmark]") {
+    const size_t iterations = 5000;
+    Crypto crypto;
+    // Recommended key type is Ed25519
+    auto keyPair = crypto.generateKeyPair();
+    auto exportedPrivateKey = crypto.exportPrivateKey(keyPair.privateKey());
+    auto exportedPublicKey = crypto.exportPublicKey(keyPair.publicKey());
+    auto data = Utils::generateRandomData(100);
+    auto signature = crypto.generateSignature(data, keyPair.privateKey());
+
+    size_t total = 0;
+    // Previous implementation converted key to DER on every operation
+    auto previousSignSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        auto signer = VirgilSigner(VirgilHashAlgorithm::SHA512);
+        total += signer.sign(data, VirgilKeyPair::privateKeyToDER(exportedPrivateKey)).size();
+    });
+    auto signSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        total += crypto.generateSignature(data, keyPair.privateKey()).size();
+    });
+    REQUIRE(total == 2 * (iterations + 1) * signature.size());
+
+    size_t verified = 0;
+    auto previousVerifySpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        auto signer = VirgilSigner();
+        verified += signer.verify(data, signature, VirgilKeyPair::publicKeyToDER(exportedPublicKey));
+    });
+    auto verifySpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        verified += crypto.verify(data, signature, keyPair.publicKey());
+    });
+    REQUIRE(verified == 2 * (iterations + 1));
+
+    BenchmarkUtils::report("Ed25519 sign, previous implementation", previousSignSpeed, "signs/s");
+    BenchmarkUtils::report("Ed25519 sign", signSpeed, "signs/s");
+    BenchmarkUtils::report("Ed25519 verify, previous implementation", previousVerifySpeed, "verifies/s");
+    BenchmarkUtils::report("Ed25519 verify", verifySpeed, "verifies/s");
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include <BenchmarkUtils.h>
+#include <helpers.h>
+
+#include <virgil/sdk/crypto/Crypto.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::test::Utils;
+using virgil::sdk::VirgilByteArrayUtils;
+
+TEST_CASE("benchmark007_Crypto_StreamEncryptDecrypt", "[.benchmark]") {
+    const size_t iterations = 2;
+    const size_t dataSize = 64 * 1024 * 1024;
+    const double megabytes = static_cast<double>(dataSize) / (1024 * 1024);
+    const std::string plainPath = "benchmark007.plain";
+    const std::string encryptedPath = "benchmark007.encrypted";
+    const std::string decryptedPath = "benchmark007.decrypted";
+
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    {
+        auto chunk = VirgilByteArrayUtils::bytesToString(Utils::generateRandomData(1024 * 1024));
+        std::ofstream plainFile(plainPath, std::ios::binary);
+        for (size_t i = 0; i < dataSize / chunk.size(); ++i)
+            plainFile << chunk;
+    }
+
+    auto encrypt = [&](bool pipelined) {
+        std::ifstream input(plainPath, std::ios::binary);
+        std::ofstream output(encryptedPath, std::ios::binary);
+        crypto.encrypt(input, output, { keyPair.publicKey() }, pipelined);
+    };
+    auto decrypt = [&](bool pipelined) {
+        std::ifstream input(encryptedPath, std::ios::binary);
+        std::ofstream output(decryptedPath, std::ios::binary);
+        crypto.decrypt(input, output, keyPair.privateKey(), pipelined);
+    };
+
+    // Pipelined mode runs reading, cipher and writing on 3 threads
+    for (bool pipelined : { false, true }) {
+        auto encryptSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] { encrypt(pipelined); });
+        auto decryptSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] { decrypt(pipelined); });
+
+        std::ifstream decryptedFile(decryptedPath, std::ios::binary | std::ios::ate);
+        REQUIRE(static_cast<size_t>(decryptedFile.tellg()) == dataSize);
+
+        auto threads = std::string(pipelined ? "3 threads" : "1 thread");
+        BenchmarkUtils::report("Stream encrypt, " + threads, encryptSpeed * megabytes, "MB/s");
+        BenchmarkUtils::report("Stream decrypt, " + threads, decryptSpeed * megabytes, "MB/s");
+    }
+
+    std::remove(plainPath.c_str());
+    std::remove(encryptedPath.c_str());
+    std::remove(decryptedPath.c_str());
+}
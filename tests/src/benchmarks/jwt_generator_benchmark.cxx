@@ -0,0 +1,70 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <BenchmarkUtils.h>
+
+#include <virgil/sdk/jwt/JwtGenerator.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::test::BenchmarkUtils;
+
+TEST_CASE("benchmark005_JwtGenerator_GenerateTokens", "[.benchmark]") {
+    const size_t batches = 5;
+    const size_t batchSize = 200;
+    auto crypto = std::make_shared<Crypto>();
+    auto generator = JwtGenerator(crypto->generateKeyPair().privateKey(), "id", crypto, "appId", 60);
+
+    auto identities = std::vector<std::string>();
+    for (size_t i = 0; i < batchSize; ++i)
+        identities.push_back("identity" + std::to_string(i));
+
+    size_t total = 0;
+    auto sequentialSpeed = BenchmarkUtils::opsPerSecond(batches, [&] {
+        for (const auto& identity : identities)
+            total += generator.generateToken(identity).identity().size();
+    });
+    auto batchSpeed = BenchmarkUtils::opsPerSecond(batches, [&] {
+        for (const auto& token : generator.generateTokens(identities))
+            total += token.identity().size();
+    });
+    REQUIRE(total > 0);
+
+    BenchmarkUtils::report("JwtGenerator, generateToken loop", sequentialSpeed * batchSize, "tokens/s");
+    BenchmarkUtils::report("JwtGenerator, generateTokens", batchSpeed * batchSize, "tokens/s");
+}
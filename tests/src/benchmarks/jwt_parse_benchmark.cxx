@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <sstream>
+
+#include <BenchmarkUtils.h>
+
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/util/Base64Url.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::jwt::Jwt;
+using virgil::sdk::jwt::JwtBodyContent;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::JwtHeaderContent;
+using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::util::Base64Url;
+using virgil::sdk::VirgilByteArrayUtils;
+
+namespace {
+    // Previous implementation, which re-serialized header and body
+    Jwt previousParse(const std::string &stringRepresentation) {
+        std::stringstream ss(stringRepresentation);
+        std::string item;
+        std::vector<std::string> parts;
+        while (std::getline(ss, item, '.'))
+            parts.push_back(item);
+
+        auto headerContent = JsonDeserializer<JwtHeaderContent>::fromJsonString(Base64Url::decode(parts[0]));
+        auto bodyContent = JsonDeserializer<JwtBodyContent>::fromJsonString(Base64Url::decode(parts[1]));
+        auto signatureContent = VirgilByteArrayUtils::stringToBytes(Base64Url::decode(parts[2]));
+
+        return Jwt(headerContent, bodyContent, signatureContent);
+    }
+}
+
+TEST_CASE("benchmark004_Jwt_Parse", "[.benchmark]") {
+    const size_t iterations = 50000;
+    auto crypto = std::make_shared<Crypto>();
+    auto generator = JwtGenerator(crypto->generateKeyPair().privateKey(), "id", crypto, "appId", 60);
+    auto tokenString = generator.generateToken("alice", { { "username", "alice" } }).stringRepresentation();
+
+    size_t total = 0;
+    auto previousSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        total += previousParse(tokenString).bodyContent().identity().size();
+    });
+    auto speed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        total += Jwt::parse(tokenString).bodyContent().identity().size();
+    });
+    REQUIRE(total == 2 * (iterations + 1) * 5);
+
+    BenchmarkUtils::report("Jwt parse, previous implementation", previousSpeed, "parses/s");
+    BenchmarkUtils::report("Jwt parse", speed, "parses/s");
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <BenchmarkUtils.h>
+
+#include <virgil/sdk/client/models/RawSignedModel.h>
+#include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
+
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::models::RawSignature;
+using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::serialization::JsonStreamDeserializer;
+using virgil::sdk::test::BenchmarkUtils;
+using virgil::sdk::VirgilByteArray;
+
+TEST_CASE("benchmark002_RawSignedModels_Deserialization", "[.benchmark]") {
+    const size_t cardsCount = 20000;
+    const size_t iterations = 5;
+
+    auto rawCard = RawSignedModel(VirgilByteArray(1024, 0x42));
+    rawCard.addSignature(RawSignature("self", VirgilByteArray(64, 0x01), VirgilByteArray()));
+    rawCard.addSignature(RawSignature("virgil", VirgilByteArray(64, 0x02), VirgilByteArray(128, 0x03)));
+    auto rawCardJson = rawCard.exportAsJson();
+
+    std::string json = "[";
+    for (size_t i = 0; i < cardsCount; ++i)
+        json += (i == 0 ? "" : ",") + rawCardJson;
+    json += "]";
+
+    // Peak RSS only grows, so the lighter path is measured first
+    auto initialRss = BenchmarkUtils::peakResidentSetSize();
+    auto streamSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        REQUIRE(JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(json).size() == cardsCount);
+    });
+    auto streamRss = BenchmarkUtils::peakResidentSetSize();
+
+    auto domSpeed = BenchmarkUtils::opsPerSecond(iterations, [&] {
+        REQUIRE(JsonDeserializer<std::vector<RawSignedModel>>::fromJsonString(json).size() == cardsCount);
+    });
+    auto domRss = BenchmarkUtils::peakResidentSetSize();
+
+    BenchmarkUtils::report("Response size", json.size() / 1024, "KB");
+    BenchmarkUtils::report("DOM deserialization", domSpeed * cardsCount, "cards/s");
+    BenchmarkUtils::report("Streaming deserialization", streamSpeed * cardsCount, "cards/s");
+    BenchmarkUtils::report("DOM deserialization peak RSS growth", domRss - initialRss, "KB");
+    BenchmarkUtils::report("Streaming deserialization peak RSS growth", streamRss - initialRss, "KB");
+}
@@ -0,0 +1,579 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <stubs/Http2ServerStub.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using virgil::sdk::test::stubs::Http2ServerStub;
+
+namespace {
+    const int kPollIntervalMs = 20;
+    const size_t kMaxFrameSize = 16384;
+    const size_t kDefaultHeaderTableSize = 4096;
+    const std::string kClientPreface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+    enum FrameType : unsigned char {
+        DATA = 0x0, HEADERS = 0x1, RST_STREAM = 0x3, SETTINGS = 0x4, PING = 0x6, GOAWAY = 0x7,
+        WINDOW_UPDATE = 0x8, CONTINUATION = 0x9
+    };
+
+    enum FrameFlag : unsigned char {
+        END_STREAM = 0x1, ACK = 0x1, END_HEADERS = 0x4, PADDED = 0x8, PRIORITY = 0x20
+    };
+
+    // RFC 7541, Appendix A
+    const std::pair<const char *, const char *> kStaticTable[] = {
+        {":authority", ""},
+        {":method", "GET"},
+        {":method", "POST"},
+        {":path", "/"},
+        {":path", "/index.html"},
+        {":scheme", "http"},
+        {":scheme", "https"},
+        {":status", "200"},
+        {":status", "204"},
+        {":status", "206"},
+        {":status", "304"},
+        {":status", "400"},
+        {":status", "404"},
+        {":status", "500"},
+        {"accept-charset", ""},
+        {"accept-encoding", "gzip, deflate"},
+        {"accept-language", ""},
+        {"accept-ranges", ""},
+        {"accept", ""},
+        {"access-control-allow-origin", ""},
+        {"age", ""},
+        {"allow", ""},
+        {"authorization", ""},
+        {"cache-control", ""},
+        {"content-disposition", ""},
+        {"content-encoding", ""},
+        {"content-language", ""},
+        {"content-length", ""},
+        {"content-location", ""},
+        {"content-range", ""},
+        {"content-type", ""},
+        {"cookie", ""},
+        {"date", ""},
+        {"etag", ""},
+        {"expect", ""},
+        {"expires", ""},
+        {"from", ""},
+        {"host", ""},
+        {"if-match", ""},
+        {"if-modified-since", ""},
+        {"if-none-match", ""},
+        {"if-range", ""},
+        {"if-unmodified-since", ""},
+        {"last-modified", ""},
+        {"link", ""},
+        {"location", ""},
+        {"max-forwards", ""},
+        {"proxy-authenticate", ""},
+        {"proxy-authorization", ""},
+        {"range", ""},
+        {"referer", ""},
+        {"refresh", ""},
+        {"retry-after", ""},
+        {"server", ""},
+        {"set-cookie", ""},
+        {"strict-transport-security", ""},
+        {"transfer-encoding", ""},
+        {"user-agent", ""},
+        {"vary", ""},
+        {"via", ""},
+        {"www-authenticate", ""},
+    };
+
+    // RFC 7541, Appendix B: code lengths of canonical Huffman code for symbols 0..256 (EOS)
+    const unsigned char kHuffmanCodeLengths[] = {
+        13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6, 5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+        13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+        15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5, 6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+        20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23, 24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+        22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23, 21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+        26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25, 19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+        20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23, 26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+        30,
+    };
+
+    class HuffmanDecoder {
+    public:
+        HuffmanDecoder() : counts_(31, 0) {
+            for (size_t length = 1; length <= 30; ++length)
+                for (int symbol = 0; symbol <= 256; ++symbol)
+                    if (kHuffmanCodeLengths[symbol] == length) {
+                        ++counts_[length];
+                        symbols_.push_back(symbol);
+                    }
+        }
+
+        std::string decode(const std::string &data) const {
+            std::string result;
+            unsigned long code = 0, first = 0, index = 0;
+            size_t length = 0;
+            for (unsigned char byte : data) {
+                for (int bit = 7; bit >= 0; --bit) {
+                    code |= (byte >> bit) & 1;
+                    ++length;
+                    if (code - first < counts_[length]) {
+                        result.push_back(static_cast<char>(symbols_[index + code - first]));
+                        code = first = index = length = 0;
+                        continue;
+                    }
+                    index += counts_[length];
+                    first = (first + counts_[length]) << 1;
+                    code <<= 1;
+                }
+            }
+            // Remaining bits are EOS prefix padding
+
+            return result;
+        }
+
+    private:
+        std::vector<unsigned long> counts_;
+        std::vector<int> symbols_;
+    };
+
+    bool waitReadable(int socket, const std::atomic<bool> &stopped) {
+        while (!stopped) {
+            pollfd fd;
+            fd.fd = socket;
+            fd.events = POLLIN;
+            fd.revents = 0;
+            auto result = poll(&fd, 1, kPollIntervalMs);
+            if (result > 0)
+                return true;
+            if (result < 0)
+                return false;
+        }
+
+        return false;
+    }
+
+    bool readExactly(int socket, const std::atomic<bool> &stopped, size_t size, std::string &data) {
+        data.clear();
+        char chunk[4096];
+        while (data.size() < size) {
+            if (!waitReadable(socket, stopped))
+                return false;
+            auto received = recv(socket, chunk, std::min(sizeof(chunk), size - data.size()), 0);
+            if (received <= 0)
+                return false;
+            data.append(chunk, static_cast<size_t>(received));
+        }
+
+        return true;
+    }
+
+    bool sendAll(int socket, const std::string &data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            auto result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (result <= 0)
+                return false;
+            sent += static_cast<size_t>(result);
+        }
+
+        return true;
+    }
+
+    std::string frame(unsigned char type, unsigned char flags, unsigned int streamId, const std::string &payload) {
+        std::string data;
+        data.push_back(static_cast<char>((payload.size() >> 16) & 0xff));
+        data.push_back(static_cast<char>((payload.size() >> 8) & 0xff));
+        data.push_back(static_cast<char>(payload.size() & 0xff));
+        data.push_back(static_cast<char>(type));
+        data.push_back(static_cast<char>(flags));
+        for (int shift = 24; shift >= 0; shift -= 8)
+            data.push_back(static_cast<char>((streamId >> shift) & 0xff));
+
+        return data + payload;
+    }
+
+    void encodeInteger(std::string &out, unsigned char prefix, int prefixBits, size_t value) {
+        size_t limit = (1u << prefixBits) - 1;
+        if (value < limit) {
+            out.push_back(static_cast<char>(prefix | value));
+            return;
+        }
+        out.push_back(static_cast<char>(prefix | limit));
+        value -= limit;
+        while (value >= 128) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    void encodeString(std::string &out, const std::string &value) {
+        encodeInteger(out, 0x00, 7, value.size());
+        out += value;
+    }
+
+    std::string lowercase(std::string value) {
+        for (auto &c : value)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+        return value;
+    }
+}
+
+class Http2ServerStub::Session {
+public:
+    Session(Http2ServerStub &server, int socket) : server_(server), socket_(socket), tableSize_(0),
+                                                  maxTableSize_(kDefaultHeaderTableSize) {}
+
+    ~Session() {
+        for (auto &responder : responders_)
+            responder.join();
+    }
+
+    void run() {
+        std::string data;
+        if (!readExactly(socket_, server_.stopped_, kClientPreface.size(), data) || data != kClientPreface)
+            return;
+
+        std::string settings;
+        settings.push_back(0x00);
+        settings.push_back(0x03);  // SETTINGS_MAX_CONCURRENT_STREAMS
+        for (int shift = 24; shift >= 0; shift -= 8)
+            settings.push_back(static_cast<char>((server_.maxConcurrentStreams_ >> shift) & 0xff));
+        if (!write(frame(SETTINGS, 0, 0, settings)))
+            return;
+
+        std::string header, payload;
+        unsigned int headersStreamId = 0;
+        bool headersEndStream = false;
+        std::string headerBlock;
+        while (readExactly(socket_, server_.stopped_, 9, header)) {
+            auto length = (static_cast<unsigned char>(header[0]) << 16) | (static_cast<unsigned char>(header[1]) << 8)
+                          | static_cast<unsigned char>(header[2]);
+            auto type = static_cast<unsigned char>(header[3]);
+            auto flags = static_cast<unsigned char>(header[4]);
+            unsigned int streamId = 0;
+            for (int i = 5; i < 9; ++i)
+                streamId = (streamId << 8) | static_cast<unsigned char>(header[i]);
+            streamId &= 0x7fffffff;
+
+            if (!readExactly(socket_, server_.stopped_, length, payload))
+                return;
+
+            switch (type) {
+                case DATA: {
+                    auto body = stripPadding(flags, payload);
+                    streams_[streamId].body += body;
+                    if (!payload.empty()) {
+                        std::string increment;
+                        for (int shift = 24; shift >= 0; shift -= 8)
+                            increment.push_back(static_cast<char>((payload.size() >> shift) & 0xff));
+                        write(frame(WINDOW_UPDATE, 0, 0, increment));
+                    }
+                    if (flags & END_STREAM)
+                        dispatch(streamId);
+                    break;
+                }
+                case HEADERS: {
+                    auto fragment = stripPadding(flags, payload);
+                    if (flags & PRIORITY)
+                        fragment.erase(0, 5);
+                    headersStreamId = streamId;
+                    headersEndStream = (flags & END_STREAM) != 0;
+                    headerBlock = fragment;
+                    if (flags & END_HEADERS)
+                        onHeaders(headersStreamId, headerBlock, headersEndStream);
+                    break;
+                }
+                case CONTINUATION:
+                    headerBlock += payload;
+                    if (flags & END_HEADERS)
+                        onHeaders(headersStreamId, headerBlock, headersEndStream);
+                    break;
+                case RST_STREAM:
+                    streams_.erase(streamId);
+                    break;
+                case SETTINGS:
+                    if (!(flags & ACK))
+                        write(frame(SETTINGS, ACK, 0, std::string()));
+                    break;
+                case PING:
+                    if (!(flags & ACK))
+                        write(frame(PING, ACK, 0, payload));
+                    break;
+                case GOAWAY:
+                    return;
+                default:
+                    break;
+            }
+        }
+    }
+
+private:
+    static std::string stripPadding(unsigned char flags, const std::string &payload) {
+        if (!(flags & PADDED) || payload.empty())
+            return payload;
+        auto padLength = static_cast<unsigned char>(payload[0]);
+
+        return payload.substr(1, payload.size() - 1 - padLength);
+    }
+
+    bool write(const std::string &data) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        return sendAll(socket_, data);
+    }
+
+    void onHeaders(unsigned int streamId, const std::string &block, bool endStream) {
+        auto &request = streams_[streamId];
+        size_t position = 0;
+        while (position < block.size()) {
+            auto byte = static_cast<unsigned char>(block[position]);
+            std::pair<std::string, std::string> field;
+            if (byte & 0x80) {
+                field = entry(decodeInteger(block, position, 7));
+            } else if (byte & 0x40) {
+                auto index = decodeInteger(block, position, 6);
+                field.first = index > 0 ? entry(index).first : decodeString(block, position);
+                field.second = decodeString(block, position);
+                insert(field);
+            } else if (byte & 0x20) {
+                maxTableSize_ = decodeInteger(block, position, 5);
+                evict();
+                continue;
+            } else {
+                auto index = decodeInteger(block, position, 4);
+                field.first = index > 0 ? entry(index).first : decodeString(block, position);
+                field.second = decodeString(block, position);
+            }
+
+            if (field.first == ":method")
+                request.method = field.second;
+            else if (field.first == ":path")
+                request.path = field.second;
+            else if (field.first[0] != ':')
+                request.header[field.first] = field.second;
+        }
+
+        if (endStream)
+            dispatch(streamId);
+    }
+
+    void dispatch(unsigned int streamId) {
+        auto request = streams_[streamId];
+        streams_.erase(streamId);
+
+        auto active = ++server_.activeStreams_;
+        auto maxActive = server_.maxActiveStreams_.load();
+        while (active > maxActive && !server_.maxActiveStreams_.compare_exchange_weak(maxActive, active)) {}
+
+        responders_.emplace_back([this, streamId, request] {
+            auto response = server_.handler_(request);
+            ++server_.handledRequests_;
+
+            if (response.delay.count() > 0)
+                std::this_thread::sleep_for(response.delay);
+
+            std::string block;
+            encodeInteger(block, 0x00, 4, 8);  // :status, literal without indexing, static name
+            encodeString(block, std::to_string(response.statusCode));
+            response.header["content-length"] = std::to_string(response.body.size());
+            for (const auto &header : response.header) {
+                block.push_back(0x00);
+                encodeString(block, lowercase(header.first));
+                encodeString(block, header.second);
+            }
+
+            auto data = frame(HEADERS, END_HEADERS | (response.body.empty() ? END_STREAM : 0), streamId, block);
+            for (size_t offset = 0; offset < response.body.size(); offset += kMaxFrameSize) {
+                auto isLast = offset + kMaxFrameSize >= response.body.size();
+                data += frame(DATA, isLast ? END_STREAM : 0, streamId, response.body.substr(offset, kMaxFrameSize));
+            }
+
+            --server_.activeStreams_;
+            write(data);
+        });
+    }
+
+    size_t decodeInteger(const std::string &block, size_t &position, int prefixBits) {
+        size_t limit = (1u << prefixBits) - 1;
+        size_t value = static_cast<unsigned char>(block[position++]) & limit;
+        if (value < limit)
+            return value;
+
+        for (int shift = 0; position < block.size(); shift += 7) {
+            auto byte = static_cast<unsigned char>(block[position++]);
+            value += static_cast<size_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+
+        return value;
+    }
+
+    std::string decodeString(const std::string &block, size_t &position) {
+        auto isHuffman = (static_cast<unsigned char>(block[position]) & 0x80) != 0;
+        auto length = decodeInteger(block, position, 7);
+        auto value = block.substr(position, length);
+        position += length;
+
+        return isHuffman ? huffmanDecoder_.decode(value) : value;
+    }
+
+    std::pair<std::string, std::string> entry(size_t index) const {
+        auto staticTableSize = sizeof(kStaticTable) / sizeof(kStaticTable[0]);
+        if (index == 0 || index > staticTableSize + dynamicTable_.size())
+            throw std::runtime_error("Invalid HPACK index");
+        if (index <= staticTableSize)
+            return std::make_pair(kStaticTable[index - 1].first, kStaticTable[index - 1].second);
+
+        return dynamicTable_[index - staticTableSize - 1];
+    }
+
+    void insert(const std::pair<std::string, std::string> &field) {
+        dynamicTable_.push_front(field);
+        tableSize_ += 32 + field.first.size() + field.second.size();
+        evict();
+    }
+
+    void evict() {
+        while (tableSize_ > maxTableSize_ && !dynamicTable_.empty()) {
+            tableSize_ -= 32 + dynamicTable_.back().first.size() + dynamicTable_.back().second.size();
+            dynamicTable_.pop_back();
+        }
+    }
+
+    Http2ServerStub &server_;
+    int socket_;
+    std::mutex writeMutex_;
+    std::unordered_map<unsigned int, Request> streams_;
+    std::deque<std::pair<std::string, std::string>> dynamicTable_;
+    size_t tableSize_;
+    size_t maxTableSize_;
+    HuffmanDecoder huffmanDecoder_;
+    std::vector<std::thread> responders_;
+};
+
+Http2ServerStub::Http2ServerStub(Handler handler, size_t maxConcurrentStreams)
+        : handler_(std::move(handler)), maxConcurrentStreams_(maxConcurrentStreams), listenSocket_(-1), port_(0),
+          stopped_(false), acceptedConnections_(0), handledRequests_(0), activeStreams_(0), maxActiveStreams_(0) {
+    listenSocket_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket_ < 0)
+        throw std::runtime_error("Can't create server socket");
+
+    int reuse = 1;
+    setsockopt(listenSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+
+    socklen_t length = sizeof(address);
+    if (bind(listenSocket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+        || listen(listenSocket_, 64) != 0
+        || getsockname(listenSocket_, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+        close(listenSocket_);
+        throw std::runtime_error("Can't start server");
+    }
+    port_ = ntohs(address.sin_port);
+
+    acceptThread_ = std::thread([this] { acceptLoop(); });
+}
+
+Http2ServerStub::~Http2ServerStub() {
+    stopped_ = true;
+    acceptThread_.join();
+
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers.swap(workers_);
+    }
+    for (auto &worker : workers)
+        worker.join();
+
+    close(listenSocket_);
+}
+
+std::string Http2ServerStub::baseAddress() const {
+    return "http://127.0.0.1:" + std::to_string(port_);
+}
+
+size_t Http2ServerStub::acceptedConnections() const { return acceptedConnections_; }
+
+size_t Http2ServerStub::handledRequests() const { return handledRequests_; }
+
+size_t Http2ServerStub::maxActiveStreams() const { return maxActiveStreams_; }
+
+void Http2ServerStub::acceptLoop() {
+    while (waitReadable(listenSocket_, stopped_)) {
+        auto socket = accept(listenSocket_, nullptr, nullptr);
+        if (socket < 0)
+            continue;
+
+        ++acceptedConnections_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers_.emplace_back([this, socket] { serve(socket); });
+    }
+}
+
+void Http2ServerStub::serve(int socket) {
+    {
+        Session session(*this, socket);
+        try {
+            session.run();
+        } catch (const std::exception &) {
+            // Malformed frames close the connection
+        }
+    }
+
+    close(socket);
+}
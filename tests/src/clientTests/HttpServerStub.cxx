@@ -0,0 +1,250 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <stubs/HttpServerStub.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using virgil::sdk::test::stubs::HttpServerStub;
+
+namespace {
+    const int kPollIntervalMs = 20;
+
+    bool waitReadable(int socket, const std::atomic<bool> &stopped) {
+        while (!stopped) {
+            pollfd fd;
+            fd.fd = socket;
+            fd.events = POLLIN;
+            fd.revents = 0;
+            auto result = poll(&fd, 1, kPollIntervalMs);
+            if (result > 0)
+                return true;
+            if (result < 0)
+                return false;
+        }
+
+        return false;
+    }
+
+    bool sendAll(int socket, const std::string &data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            auto result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (result <= 0)
+                return false;
+            sent += static_cast<size_t>(result);
+        }
+
+        return true;
+    }
+
+    std::string trim(const std::string &str) {
+        auto begin = str.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos)
+            return std::string();
+        auto end = str.find_last_not_of(" \t\r\n");
+
+        return str.substr(begin, end - begin + 1);
+    }
+
+    std::string reasonPhrase(int statusCode) {
+        switch (statusCode) {
+            case 200: return "OK";
+            case 201: return "Created";
+            case 400: return "Bad Request";
+            case 401: return "Unauthorized";
+            case 403: return "Forbidden";
+            case 404: return "Not Found";
+            case 429: return "Too Many Requests";
+            case 500: return "Internal Server Error";
+            case 502: return "Bad Gateway";
+            case 503: return "Service Unavailable";
+            case 504: return "Gateway Timeout";
+            default: return "Unknown";
+        }
+    }
+}
+
+HttpServerStub::HttpServerStub(Handler handler)
+        : handler_(std::move(handler)), listenSocket_(-1), port_(0), stopped_(false),
+          acceptedConnections_(0), handledRequests_(0) {
+    listenSocket_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket_ < 0)
+        throw std::runtime_error("Can't create server socket");
+
+    int reuse = 1;
+    setsockopt(listenSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+
+    socklen_t length = sizeof(address);
+    if (bind(listenSocket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+        || listen(listenSocket_, 64) != 0
+        || getsockname(listenSocket_, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+        close(listenSocket_);
+        throw std::runtime_error("Can't start server");
+    }
+    port_ = ntohs(address.sin_port);
+
+    acceptThread_ = std::thread([this] { acceptLoop(); });
+}
+
+HttpServerStub::~HttpServerStub() {
+    stopped_ = true;
+    acceptThread_.join();
+
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers.swap(workers_);
+    }
+    for (auto &worker : workers)
+        worker.join();
+
+    close(listenSocket_);
+}
+
+std::string HttpServerStub::baseAddress() const {
+    return "http://127.0.0.1:" + std::to_string(port_);
+}
+
+size_t HttpServerStub::acceptedConnections() const { return acceptedConnections_; }
+
+size_t HttpServerStub::handledRequests() const { return handledRequests_; }
+
+void HttpServerStub::acceptLoop() {
+    while (waitReadable(listenSocket_, stopped_)) {
+        auto socket = accept(listenSocket_, nullptr, nullptr);
+        if (socket < 0)
+            continue;
+
+        ++acceptedConnections_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers_.emplace_back([this, socket] { serve(socket); });
+    }
+}
+
+void HttpServerStub::serve(int socket) {
+    std::string buffer;
+    Request request;
+    while (readRequest(socket, buffer, request)) {
+        auto response = handler_(request);
+        ++handledRequests_;
+
+        if (response.delay.count() > 0)
+            std::this_thread::sleep_for(response.delay);
+
+        if (response.dropConnection)
+            break;
+
+        std::string data = "HTTP/1.1 " + std::to_string(response.statusCode) + " "
+                           + reasonPhrase(response.statusCode) + "\r\n";
+        data += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+        if (response.closeConnection)
+            data += "Connection: close\r\n";
+        for (const auto &header : response.header)
+            data += header.first + ": " + header.second + "\r\n";
+        data += "\r\n" + response.body;
+
+        if (!sendAll(socket, data) || response.closeConnection)
+            break;
+    }
+
+    close(socket);
+}
+
+bool HttpServerStub::readRequest(int socket, std::string &buffer, Request &request) {
+    char chunk[4096];
+    size_t headerEnd;
+    while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (!waitReadable(socket, stopped_))
+            return false;
+        auto received = recv(socket, chunk, sizeof(chunk), 0);
+        if (received <= 0)
+            return false;
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+
+    request = Request();
+    auto head = buffer.substr(0, headerEnd);
+    auto lineEnd = head.find("\r\n");
+    auto requestLine = head.substr(0, lineEnd);
+    auto methodEnd = requestLine.find(' ');
+    auto pathEnd = requestLine.find(' ', methodEnd + 1);
+    request.method = requestLine.substr(0, methodEnd);
+    request.path = requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+
+    size_t contentLength = 0;
+    while (lineEnd != std::string::npos) {
+        auto lineBegin = lineEnd + 2;
+        lineEnd = head.find("\r\n", lineBegin);
+        auto line = head.substr(lineBegin, lineEnd == std::string::npos ? std::string::npos : lineEnd - lineBegin);
+        auto separator = line.find(':');
+        if (separator == std::string::npos)
+            continue;
+        auto name = line.substr(0, separator);
+        auto value = trim(line.substr(separator + 1));
+        request.header[name] = value;
+        if (strcasecmp(name.c_str(), "Content-Length") == 0)
+            contentLength = std::stoul(value);
+    }
+
+    buffer.erase(0, headerEnd + 4);
+    while (buffer.size() < contentLength) {
+        if (!waitReadable(socket, stopped_))
+            return false;
+        auto received = recv(socket, chunk, sizeof(chunk), 0);
+        if (received <= 0)
+            return false;
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+    request.body = buffer.substr(0, contentLength);
+    buffer.erase(0, contentLength);
+
+    return true;
+}
@@ -0,0 +1,202 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/networking/ConnectionPool.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/models/RawSignedModel.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::models::RawSignature;
+using virgil::sdk::client::networking::ConnectionPool;
+using virgil::sdk::client::networking::KeepAliveConnection;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+namespace {
+    HttpServerStub::Response okResponse(const HttpServerStub::Request &request) {
+        HttpServerStub::Response response;
+        response.body = "{\"path\":\"" + request.path + "\"}";
+        return response;
+    }
+
+    Request makeRequest(const std::string &baseAddress, const std::string &endpoint) {
+        Request request;
+        request.get().baseAddress(baseAddress).endpoint(endpoint);
+        return request;
+    }
+}
+
+TEST_CASE("test001_ConnectionPool_SequentialRequests_ReuseConnection", "[connection]") {
+    HttpServerStub server(okResponse);
+    ConnectionPool pool;
+
+    for (int i = 0; i < 5; ++i) {
+        auto response = pool.send(makeRequest(server.baseAddress(), "/ping/" + std::to_string(i)));
+        REQUIRE(!response.fail());
+        REQUIRE(response.body() == "{\"path\":\"/ping/" + std::to_string(i) + "\"}");
+    }
+
+    REQUIRE(server.acceptedConnections() == 1);
+    REQUIRE(pool.newConnections() == 1);
+    REQUIRE(pool.reusedConnections() == 4);
+    REQUIRE(pool.idleConnections() == 1);
+}
+
+TEST_CASE("test002_ConnectionPool_ZeroMaxIdle_OpensNewConnections", "[connection]") {
+    HttpServerStub server(okResponse);
+    ConnectionPool pool(0);
+
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(!pool.send(makeRequest(server.baseAddress(), "/ping")).fail());
+
+    REQUIRE(server.acceptedConnections() == 3);
+    REQUIRE(pool.newConnections() == 3);
+    REQUIRE(pool.reusedConnections() == 0);
+    REQUIRE(pool.idleConnections() == 0);
+}
+
+TEST_CASE("test003_ConnectionPool_IdleTimeout_ClosesConnection", "[connection]") {
+    HttpServerStub server(okResponse);
+    ConnectionPool pool(8, std::chrono::milliseconds(50));
+
+    REQUIRE(!pool.send(makeRequest(server.baseAddress(), "/ping")).fail());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE(!pool.send(makeRequest(server.baseAddress(), "/ping")).fail());
+
+    REQUIRE(server.acceptedConnections() == 2);
+    REQUIRE(pool.newConnections() == 2);
+    REQUIRE(pool.reusedConnections() == 0);
+}
+
+TEST_CASE("test004_ConnectionPool_ServerClosesConnection_OpensNewOne", "[connection]") {
+    HttpServerStub server([](const HttpServerStub::Request &request) {
+        auto response = okResponse(request);
+        response.closeConnection = true;
+        return response;
+    });
+    ConnectionPool pool;
+
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(!pool.send(makeRequest(server.baseAddress(), "/ping")).fail());
+
+    REQUIRE(server.acceptedConnections() == 3);
+    REQUIRE(pool.reusedConnections() == 0);
+}
+
+TEST_CASE("test005_ConnectionPool_ConcurrentRequests", "[connection]") {
+    HttpServerStub server([](const HttpServerStub::Request &request) {
+        auto response = okResponse(request);
+        response.delay = std::chrono::milliseconds(20);
+        return response;
+    });
+    auto pool = std::make_shared<ConnectionPool>(4);
+
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::future<bool>> futures;
+        for (int i = 0; i < 4; ++i) {
+            futures.push_back(std::async(std::launch::async, [&server, pool] {
+                return !pool->send(makeRequest(server.baseAddress(), "/ping")).fail();
+            }));
+        }
+        for (auto &future : futures)
+            REQUIRE(future.get());
+    }
+
+    REQUIRE(pool->newConnections() + pool->reusedConnections() == 12);
+    REQUIRE(server.acceptedConnections() == pool->newConnections());
+    REQUIRE(pool->newConnections() <= 8);
+    REQUIRE(pool->idleConnections() <= 4);
+}
+
+TEST_CASE("test006_CardClient_GetCard_UsesKeepAliveConnection", "[connection]") {
+    RawSignedModel rawCard(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}"));
+    rawCard.addSignature(RawSignature("self", VirgilByteArrayUtils::stringToBytes("signature")));
+    auto rawCardJson = rawCard.exportAsJson();
+
+    HttpServerStub server([&rawCardJson](const HttpServerStub::Request &request) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        if (request.path == "/card/v5/outdated")
+            response.header["X-Virgil-Is-Superseeded"] = "true";
+        return response;
+    });
+
+    auto connection = std::make_shared<KeepAliveConnection>();
+    CardClient cardClient(server.baseAddress(), connection);
+
+    auto actual = cardClient.getCard("actual", "token").get();
+    auto outdated = cardClient.getCard("outdated", "token").get();
+
+    REQUIRE(!actual.isOutdated());
+    REQUIRE(outdated.isOutdated());
+    REQUIRE(outdated.rawCard().contentSnapshot() == rawCard.contentSnapshot());
+    REQUIRE(outdated.rawCard().signatures().size() == 1);
+    REQUIRE(outdated.rawCard().signatures()[0].signer() == "self");
+
+    REQUIRE(server.acceptedConnections() == 1);
+    REQUIRE(connection->pool()->reusedConnections() == 1);
+}
+
+TEST_CASE("test007_CardClient_DefaultConnection_SharedBetweenClients", "[connection]") {
+    auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+    HttpServerStub server([&rawCardJson](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        return response;
+    });
+
+    CardClient firstClient(server.baseAddress());
+    CardClient secondClient(server.baseAddress());
+
+    firstClient.getCard("alice", "token").get();
+    secondClient.getCard("alice", "token").get();
+
+    REQUIRE(firstClient.connection() == secondClient.connection());
+    REQUIRE(firstClient.connection() == KeepAliveConnection::defaultConnection());
+    REQUIRE(server.acceptedConnections() == 1);
+}
@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/networking/EventLoopConnection.h>
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/models/RawSignedModel.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::networking::EventLoopConnection;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+namespace {
+    Request makeRequest(const std::string &baseAddress, const std::string &endpoint) {
+        Request request;
+        request.get().baseAddress(baseAddress).endpoint(endpoint);
+        return request;
+    }
+}
+
+TEST_CASE("test001_EventLoopConnection_SequentialRequests_ReuseConnection", "[event_loop]") {
+    HttpServerStub server([](const HttpServerStub::Request &request) {
+        HttpServerStub::Response response;
+        response.body = "{\"path\":\"" + request.path + "\"}";
+        return response;
+    });
+    EventLoopConnection connection;
+
+    for (int i = 0; i < 5; ++i) {
+        auto response = connection.send(makeRequest(server.baseAddress(), "/ping/" + std::to_string(i)));
+        REQUIRE(!response.fail());
+        REQUIRE(response.body() == "{\"path\":\"/ping/" + std::to_string(i) + "\"}");
+    }
+
+    REQUIRE(server.acceptedConnections() == 1);
+    REQUIRE(connection.newConnections() == 1);
+    REQUIRE(connection.reusedConnections() == 4);
+    REQUIRE(connection.pendingRequests() == 0);
+}
+
+TEST_CASE("test002_EventLoopConnection_SendAsync_DoesNotBlockCaller", "[event_loop]") {
+    HttpServerStub server([](const HttpServerStub::Request &request) {
+        HttpServerStub::Response response;
+        response.body = request.path;
+        response.delay = std::chrono::milliseconds(100);
+        return response;
+    });
+    EventLoopConnection connection(2, 64);
+
+    const size_t requestsCount = 64;
+    std::atomic<size_t> succeeded(0);
+    std::vector<std::future<void>> completions;
+    std::vector<std::shared_ptr<std::promise<void>>> promises;
+
+    auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < requestsCount; ++i) {
+        auto promise = std::make_shared<std::promise<void>>();
+        completions.push_back(promise->get_future());
+        auto path = "/ping/" + std::to_string(i);
+        connection.sendAsync(makeRequest(server.baseAddress(), path),
+                             [promise, path, &succeeded](std::exception_ptr error, Response response) {
+                                 if (!error && response.body() == path)
+                                     ++succeeded;
+                                 promise->set_value();
+                             });
+    }
+    auto sendDuration = std::chrono::steady_clock::now() - started;
+
+    REQUIRE(sendDuration < std::chrono::milliseconds(100));
+    REQUIRE(connection.pendingRequests() > 0);
+
+    for (auto &completion : completions)
+        completion.get();
+    auto duration = std::chrono::steady_clock::now() - started;
+
+    REQUIRE(succeeded == requestsCount);
+    REQUIRE(connection.pendingRequests() == 0);
+    // Sequential sending would take requestsCount * 100ms
+    REQUIRE(duration < std::chrono::milliseconds(requestsCount * 100 / 4));
+}
+
+TEST_CASE("test003_EventLoopConnection_Errors", "[event_loop]") {
+    SECTION("Connection refused") {
+        std::string baseAddress;
+        {
+            HttpServerStub server([](const HttpServerStub::Request &) { return HttpServerStub::Response(); });
+            baseAddress = server.baseAddress();
+        }
+        EventLoopConnection connection;
+
+        REQUIRE_THROWS_AS(connection.send(makeRequest(baseAddress, "/ping")), const std::runtime_error&);
+    }
+
+    SECTION("Destroyed with pending requests") {
+        HttpServerStub server([](const HttpServerStub::Request &) {
+            HttpServerStub::Response response;
+            response.delay = std::chrono::milliseconds(300);
+            return response;
+        });
+
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto failed = promise->get_future();
+        {
+            EventLoopConnection connection;
+            connection.sendAsync(makeRequest(server.baseAddress(), "/ping"),
+                                 [promise](std::exception_ptr error, Response) { promise->set_value(error != nullptr); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+
+        REQUIRE(failed.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE(failed.get());
+    }
+}
+
+TEST_CASE("test004_CardClient_EventLoopConnection_SingleExecutorThread", "[event_loop]") {
+    auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+    HttpServerStub server([&rawCardJson](const HttpServerStub::Request &request) {
+        HttpServerStub::Response response;
+        response.delay = std::chrono::milliseconds(100);
+        if (request.method == "POST") {
+            response.body = "[" + rawCardJson + "]";
+            return response;
+        }
+        if (request.path == "/card/v5/missing") {
+            response.statusCode = 404;
+            return response;
+        }
+        response.body = rawCardJson;
+        if (request.path == "/card/v5/outdated")
+            response.header["X-Virgil-Is-Superseeded"] = "true";
+        return response;
+    });
+
+    auto connection = std::make_shared<EventLoopConnection>(1, 64);
+    CardClient cardClient(server.baseAddress(), connection, std::make_shared<ThreadPoolExecutor>(1));
+
+    auto cardIds = std::vector<std::string>();
+    for (int i = 0; i < 39; ++i)
+        cardIds.push_back("card" + std::to_string(i));
+    cardIds.push_back("outdated");
+
+    auto started = std::chrono::steady_clock::now();
+    auto responsesFuture = cardClient.getCards(cardIds, "token");
+    auto rawCardsFuture = cardClient.searchCards(std::vector<std::string>(120, "alice"), "token");
+    auto responses = responsesFuture.get();
+    auto rawCards = rawCardsFuture.get();
+    auto duration = std::chrono::steady_clock::now() - started;
+
+    REQUIRE(responses.size() == cardIds.size());
+    REQUIRE(!responses.front().isOutdated());
+    REQUIRE(responses.back().isOutdated());
+    REQUIRE(rawCards.size() == 3);
+    // Blocking connection would serialize 43 requests on single executor thread
+    REQUIRE(duration < std::chrono::milliseconds(43 * 100 / 4));
+
+    REQUIRE_THROWS(cardClient.getCard("missing", "token").get());
+}
@@ -0,0 +1,250 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/HedgingPolicy.h>
+#include <virgil/sdk/client/networking/EventLoopConnection.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
+#include <virgil/sdk/client/models/RawSignedModel.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::HedgingPolicy;
+using virgil::sdk::client::RetryPolicy;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::networking::EventLoopConnection;
+using virgil::sdk::client::networking::KeepAliveConnection;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+using std::chrono::milliseconds;
+
+namespace {
+    // Responds to the first request for "slow" card with given delay, other requests are answered at once
+    HttpServerStub::Handler slowFirstHandler(milliseconds delay) {
+        auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+        auto slowRequests = std::make_shared<std::atomic<int>>(0);
+        return [=](const HttpServerStub::Request &request) {
+            HttpServerStub::Response response;
+            response.body = request.method == "POST" ? "[" + rawCardJson + "]" : rawCardJson;
+            auto slow = request.path.find("slow") != std::string::npos || request.body.find("slow") != std::string::npos;
+            if (slow && (*slowRequests)++ == 0)
+                response.delay = delay;
+            return response;
+        };
+    }
+}
+
+TEST_CASE("test001_HedgingPolicy_Budget", "[hedging]") {
+    HedgingPolicy hedgingPolicy(0.5, milliseconds(10));
+
+    REQUIRE(!hedgingPolicy.tryHedge());
+    hedgingPolicy.requestStarted();
+    REQUIRE(!hedgingPolicy.tryHedge());
+    hedgingPolicy.requestStarted();
+    REQUIRE(hedgingPolicy.tryHedge());
+    REQUIRE(!hedgingPolicy.tryHedge());
+
+    // Budget doesn't accumulate above single hedge
+    for (int i = 0; i < 10; ++i)
+        hedgingPolicy.requestStarted();
+    REQUIRE(hedgingPolicy.tryHedge());
+    REQUIRE(!hedgingPolicy.tryHedge());
+
+    REQUIRE(hedgingPolicy.hedges() == 2);
+}
+
+TEST_CASE("test002_HedgingPolicy_HedgeDelay", "[hedging]") {
+    SECTION("Fixed delay") {
+        HedgingPolicy hedgingPolicy(0.1, milliseconds(30));
+        auto delay = milliseconds(0);
+
+        REQUIRE(hedgingPolicy.hedgeDelay(delay));
+        REQUIRE(delay == milliseconds(30));
+    }
+
+    SECTION("Observed 95th percentile") {
+        HedgingPolicy hedgingPolicy;
+        auto delay = milliseconds(0);
+
+        for (int i = 1; i < 20; ++i)
+            hedgingPolicy.requestCompleted(milliseconds(i), false);
+        REQUIRE(!hedgingPolicy.hedgeDelay(delay));
+
+        for (int i = 20; i <= 100; ++i)
+            hedgingPolicy.requestCompleted(milliseconds(i), false);
+        REQUIRE(hedgingPolicy.hedgeDelay(delay));
+        REQUIRE(delay == milliseconds(96));
+
+        // Only recent latencies are taken into account
+        for (int i = 0; i < 200; ++i)
+            hedgingPolicy.requestCompleted(milliseconds(5), i % 2 == 0);
+        REQUIRE(hedgingPolicy.hedgeDelay(delay));
+        REQUIRE(delay == milliseconds(5));
+        REQUIRE(hedgingPolicy.wonHedges() == 100);
+    }
+}
+
+TEST_CASE("test003_HedgingPolicy_Schedule", "[hedging]") {
+    HedgingPolicy hedgingPolicy;
+    auto late = std::make_shared<std::promise<void>>();
+    auto early = std::make_shared<std::promise<void>>();
+    auto lateFuture = late->get_future();
+    auto earlyFuture = early->get_future();
+
+    auto started = std::chrono::steady_clock::now();
+    hedgingPolicy.schedule(milliseconds(100), [late] { late->set_value(); });
+    hedgingPolicy.schedule(milliseconds(20), [early] { early->set_value(); });
+
+    earlyFuture.get();
+    REQUIRE(lateFuture.wait_for(milliseconds(0)) == std::future_status::timeout);
+    REQUIRE(std::chrono::steady_clock::now() - started >= milliseconds(20));
+
+    lateFuture.get();
+    REQUIRE(std::chrono::steady_clock::now() - started >= milliseconds(100));
+}
+
+TEST_CASE("test004_CardClient_SlowResponse_HedgeWins", "[hedging]") {
+    HttpServerStub server(slowFirstHandler(milliseconds(2500)));
+    auto hedgingPolicy = std::make_shared<HedgingPolicy>(1.0, milliseconds(50));
+
+    SECTION("Event loop connection") {
+        auto connection = std::make_shared<EventLoopConnection>();
+        CardClient cardClient(server.baseAddress(), connection, std::make_shared<ThreadPoolExecutor>(1),
+                              std::make_shared<RetryPolicy>(), hedgingPolicy);
+
+        auto started = std::chrono::steady_clock::now();
+        auto response = cardClient.getCard("slow", "token").get();
+
+        REQUIRE(!response.isOutdated());
+        REQUIRE(std::chrono::steady_clock::now() - started < milliseconds(1000));
+
+        // Slow request is cancelled instead of waiting for the server
+        while (connection->pendingRequests() > 0 && std::chrono::steady_clock::now() - started < milliseconds(2000))
+            std::this_thread::sleep_for(milliseconds(10));
+        REQUIRE(connection->pendingRequests() == 0);
+    }
+
+    SECTION("Blocking connection") {
+        CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), std::make_shared<RetryPolicy>(), hedgingPolicy);
+
+        auto started = std::chrono::steady_clock::now();
+        auto rawCards = cardClient.searchCards("slow", "token").get();
+
+        REQUIRE(rawCards.size() == 1);
+        REQUIRE(std::chrono::steady_clock::now() - started < milliseconds(1000));
+    }
+
+    REQUIRE(hedgingPolicy->hedges() == 1);
+    REQUIRE(hedgingPolicy->wonHedges() == 1);
+    REQUIRE(server.handledRequests() == 2);
+}
+
+TEST_CASE("test005_CardClient_HedgeRateIsCapped", "[hedging]") {
+    HttpServerStub server([](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{}")).exportAsJson();
+        response.delay = milliseconds(100);
+        return response;
+    });
+    auto hedgingPolicy = std::make_shared<HedgingPolicy>(0.5, milliseconds(20));
+    CardClient cardClient(server.baseAddress(), std::make_shared<EventLoopConnection>(1, 16),
+                          std::make_shared<ThreadPoolExecutor>(1), std::make_shared<RetryPolicy>(), hedgingPolicy);
+
+    for (int i = 0; i < 10; ++i)
+        cardClient.getCard("card" + std::to_string(i), "token").get();
+
+    REQUIRE(hedgingPolicy->hedges() == 5);
+}
+
+TEST_CASE("test006_CardClient_ObservedLatency_HedgesOutliers", "[hedging]") {
+    HttpServerStub server(slowFirstHandler(milliseconds(500)));
+    auto hedgingPolicy = std::make_shared<HedgingPolicy>(1.0);
+    CardClient cardClient(server.baseAddress(), std::make_shared<EventLoopConnection>(),
+                          std::make_shared<ThreadPoolExecutor>(1), std::make_shared<RetryPolicy>(), hedgingPolicy);
+
+    // Requests are not hedged until latencies are observed
+    for (int i = 0; i < 20; ++i)
+        cardClient.getCard("card" + std::to_string(i), "token").get();
+    REQUIRE(hedgingPolicy->hedges() == 0);
+
+    auto started = std::chrono::steady_clock::now();
+    cardClient.getCard("slow", "token").get();
+
+    REQUIRE(std::chrono::steady_clock::now() - started < milliseconds(400));
+    REQUIRE(hedgingPolicy->hedges() == 1);
+    REQUIRE(hedgingPolicy->wonHedges() == 1);
+}
+
+TEST_CASE("test007_CardClient_WithoutHedgingPolicy_SendsSingleRequest", "[hedging]") {
+    HttpServerStub server(slowFirstHandler(milliseconds(200)));
+    CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>());
+
+    auto started = std::chrono::steady_clock::now();
+    cardClient.getCard("slow", "token").get();
+
+    REQUIRE(std::chrono::steady_clock::now() - started >= milliseconds(200));
+    REQUIRE(server.handledRequests() == 1);
+    REQUIRE(cardClient.hedgingPolicy() == nullptr);
+}
+
+TEST_CASE("test008_CardClient_DestroyedWithPendingHedge_HedgeCompletes", "[hedging]") {
+    HttpServerStub server(slowFirstHandler(milliseconds(300)));
+    auto hedgingPolicy = std::make_shared<HedgingPolicy>(1.0, milliseconds(50));
+
+    std::future<virgil::sdk::client::models::GetCardResponse> future;
+    {
+        CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), std::make_shared<RetryPolicy>(), hedgingPolicy);
+        future = cardClient.getCard("slow", "token");
+    }
+
+    REQUIRE(!future.get().isOutdated());
+    REQUIRE(hedgingPolicy->hedges() == 1);
+    REQUIRE(hedgingPolicy->wonHedges() == 1);
+    REQUIRE(server.handledRequests() == 2);
+}
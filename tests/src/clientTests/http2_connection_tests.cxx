@@ -0,0 +1,206 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <future>
+#include <memory>
+
+#include <stubs/Http2ServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/networking/Http2Connection.h>
+#include <virgil/sdk/client/networking/Request.h>
+#include <virgil/sdk/client/models/RawSignedModel.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::models::RawSignature;
+using virgil::sdk::client::networking::Http2Connection;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::test::stubs::Http2ServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+namespace {
+    Http2ServerStub::Response delayedResponse(const Http2ServerStub::Request &request) {
+        Http2ServerStub::Response response;
+        response.body = "{\"path\":\"" + request.path + "\"}";
+        response.delay = std::chrono::milliseconds(50);
+        return response;
+    }
+
+    Request makeRequest(const std::string &baseAddress, const std::string &endpoint) {
+        Request request;
+        request.get().baseAddress(baseAddress).endpoint(endpoint);
+        return request;
+    }
+
+    std::vector<std::string> sendConcurrently(Http2Connection &connection, const std::string &baseAddress,
+                                              size_t count) {
+        std::vector<std::future<std::string>> futures;
+        for (size_t i = 0; i < count; ++i) {
+            futures.push_back(std::async(std::launch::async, [&connection, &baseAddress, i] {
+                return connection.send(makeRequest(baseAddress, "/ping/" + std::to_string(i))).body();
+            }));
+        }
+
+        std::vector<std::string> bodies;
+        for (auto &future : futures)
+            bodies.push_back(future.get());
+
+        return bodies;
+    }
+}
+
+TEST_CASE("test001_Http2Connection_SequentialRequests_ReuseConnection", "[http2]") {
+    if (!Http2Connection::isSupported()) {
+        WARN("libcurl is built without HTTP/2 support");
+        return;
+    }
+
+    Http2ServerStub server([](const Http2ServerStub::Request &request) {
+        Http2ServerStub::Response response;
+        response.body = "{\"method\":\"" + request.method + "\",\"path\":\"" + request.path + "\"}";
+        return response;
+    });
+    Http2Connection connection;
+
+    for (int i = 0; i < 5; ++i) {
+        auto response = connection.send(makeRequest(server.baseAddress(), "/card/v5/" + std::to_string(i)));
+        REQUIRE(!response.fail());
+        REQUIRE(response.body() == "{\"method\":\"GET\",\"path\":\"/card/v5/" + std::to_string(i) + "\"}");
+    }
+
+    REQUIRE(server.acceptedConnections() == 1);
+    REQUIRE(connection.newConnections() == 1);
+    REQUIRE(connection.reusedConnections() == 4);
+}
+
+TEST_CASE("test002_Http2Connection_ConcurrentRequests_MultiplexedOverSingleConnection", "[http2]") {
+    if (!Http2Connection::isSupported()) {
+        WARN("libcurl is built without HTTP/2 support");
+        return;
+    }
+
+    Http2ServerStub server(delayedResponse);
+    Http2Connection connection;
+
+    auto bodies = sendConcurrently(connection, server.baseAddress(), 16);
+
+    for (size_t i = 0; i < bodies.size(); ++i)
+        REQUIRE(bodies[i] == "{\"path\":\"/ping/" + std::to_string(i) + "\"}");
+    REQUIRE(server.acceptedConnections() == 1);
+    REQUIRE(server.handledRequests() == 16);
+    REQUIRE(server.maxActiveStreams() > 1);
+}
+
+TEST_CASE("test003_Http2Connection_MaxConcurrentStreams_LimitsStreams", "[http2]") {
+    if (!Http2Connection::isSupported()) {
+        WARN("libcurl is built without HTTP/2 support");
+        return;
+    }
+
+    SECTION("Client limit") {
+        Http2ServerStub server(delayedResponse);
+        Http2Connection connection(2);
+
+        auto bodies = sendConcurrently(connection, server.baseAddress(), 8);
+
+        REQUIRE(bodies.size() == 8);
+        REQUIRE(server.acceptedConnections() == 1);
+        REQUIRE(server.maxActiveStreams() <= 2);
+    }
+
+    SECTION("Server limit") {
+        Http2ServerStub server(delayedResponse, 3);
+        Http2Connection connection;
+
+        auto bodies = sendConcurrently(connection, server.baseAddress(), 8);
+
+        REQUIRE(bodies.size() == 8);
+        REQUIRE(server.acceptedConnections() == 1);
+        REQUIRE(server.maxActiveStreams() <= 3);
+    }
+}
+
+TEST_CASE("test004_CardClient_Http2Connection", "[http2]") {
+    if (!Http2Connection::isSupported()) {
+        WARN("libcurl is built without HTTP/2 support");
+        return;
+    }
+
+    RawSignedModel rawCard(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}"));
+    rawCard.addSignature(RawSignature("self", VirgilByteArrayUtils::stringToBytes("signature")));
+    auto rawCardJson = rawCard.exportAsJson();
+
+    Http2ServerStub server([&rawCardJson](const Http2ServerStub::Request &request) {
+        Http2ServerStub::Response response;
+        response.delay = std::chrono::milliseconds(20);
+        if (request.method == "POST" && request.path == "/card/v5/actions/search"
+            && request.header.at("authorization") == "Virgil token") {
+            response.body = "[" + rawCardJson + "," + rawCardJson + "]";
+            return response;
+        }
+
+        response.body = rawCardJson;
+        if (request.path == "/card/v5/outdated")
+            response.header["X-Virgil-Is-Superseeded"] = "true";
+        return response;
+    });
+
+    auto connection = std::make_shared<Http2Connection>();
+    CardClient cardClient(server.baseAddress(), connection);
+
+    auto cardIds = std::vector<std::string>();
+    for (int i = 0; i < 10; ++i)
+        cardIds.push_back("card" + std::to_string(i));
+    cardIds.push_back("outdated");
+
+    auto responses = cardClient.getCards(cardIds, "token").get();
+    auto rawCards = cardClient.searchCards("alice", "token").get();
+
+    REQUIRE(responses.size() == cardIds.size());
+    for (size_t i = 0; i + 1 < responses.size(); ++i) {
+        REQUIRE(!responses[i].isOutdated());
+        REQUIRE(responses[i].rawCard().contentSnapshot() == rawCard.contentSnapshot());
+    }
+    REQUIRE(responses.back().isOutdated());
+    REQUIRE(rawCards.size() == 2);
+    REQUIRE(rawCards[1].signatures()[0].signer() == "self");
+
+    REQUIRE(server.acceptedConnections() == 1);
+    REQUIRE(connection->newConnections() == 1);
+}
@@ -0,0 +1,340 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/client/RetryPolicy.h>
+#include <virgil/sdk/client/networking/CardEndpointUri.h>
+#include <virgil/sdk/client/networking/EventLoopConnection.h>
+#include <virgil/sdk/client/networking/KeepAliveConnection.h>
+#include <virgil/sdk/client/networking/errors/TransportError.h>
+#include <virgil/sdk/client/models/RawSignedModel.h>
+
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::RetryPolicy;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::networking::CardEndpointUri;
+using virgil::sdk::client::networking::Connection;
+using virgil::sdk::client::networking::EventLoopConnection;
+using virgil::sdk::client::networking::KeepAliveConnection;
+using virgil::sdk::client::networking::Request;
+using virgil::sdk::client::networking::Response;
+using virgil::sdk::client::networking::errors::Error;
+using virgil::sdk::client::networking::errors::TransportError;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilByteArrayUtils;
+
+using std::chrono::milliseconds;
+
+namespace {
+    Request makeRequest(Request::Method method, const std::string &endpoint) {
+        Request request;
+        request.method(method).baseAddress("http://127.0.0.1").endpoint(endpoint);
+        return request;
+    }
+
+    Response makeResponse(int statusCode) {
+        Response response;
+        response.statusCodeRaw(statusCode);
+        return response;
+    }
+
+    std::shared_ptr<RetryPolicy> makePolicy(size_t maxAttempts = 3, double retryBudgetRatio = 0.2,
+                                            size_t retryBudgetBurst = 10, std::function<double()> random = nullptr) {
+        return std::make_shared<RetryPolicy>(maxAttempts, milliseconds(1000), milliseconds(500), milliseconds(5000),
+                                             milliseconds(10), milliseconds(50), retryBudgetRatio, retryBudgetBurst,
+                                             random);
+    }
+
+    // Fails first failuresCount requests, alternating between error status and dropped connection.
+    // Connection is closed after error status, since libcurl itself resends requests dropped by reused connection
+    HttpServerStub::Handler flakyHandler(std::shared_ptr<std::atomic<int>> requests, int failuresCount) {
+        auto rawCardJson = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}")).exportAsJson();
+        return [=](const HttpServerStub::Request &request) {
+            HttpServerStub::Response response;
+            auto number = (*requests)++;
+            if (number < failuresCount) {
+                if (number % 2 == 0) {
+                    response.statusCode = 503;
+                    response.closeConnection = true;
+                } else
+                    response.dropConnection = true;
+                return response;
+            }
+            response.body = request.method == "POST" ? "[" + rawCardJson + "]" : rawCardJson;
+            return response;
+        };
+    }
+}
+
+TEST_CASE("test001_RetryPolicy_ShouldRetry", "[retry]") {
+    auto policy = makePolicy();
+    auto get = makeRequest(Request::Method::GET, CardEndpointUri::get("id"));
+    auto search = makeRequest(Request::Method::POST, CardEndpointUri::search());
+    auto publish = makeRequest(Request::Method::POST, CardEndpointUri::publish());
+    auto sent = std::make_exception_ptr(TransportError("Connection reset", true));
+    auto notSent = std::make_exception_ptr(TransportError("Connection refused", false));
+    auto delay = milliseconds(0);
+
+    SECTION("Status codes") {
+        REQUIRE(policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+        REQUIRE(policy->shouldRetry(get, nullptr, makeResponse(429), 1, milliseconds(0), delay));
+        REQUIRE(policy->shouldRetry(get, nullptr, makeResponse(500), 1, milliseconds(0), delay));
+        REQUIRE(!policy->shouldRetry(get, nullptr, makeResponse(200), 1, milliseconds(0), delay));
+        REQUIRE(!policy->shouldRetry(get, nullptr, makeResponse(401), 1, milliseconds(0), delay));
+        REQUIRE(!policy->shouldRetry(get, nullptr, makeResponse(404), 1, milliseconds(0), delay));
+        REQUIRE(policy->retries() == 3);
+    }
+
+    SECTION("Idempotency") {
+        REQUIRE(policy->shouldRetry(get, sent, Response(), 1, milliseconds(0), delay));
+        REQUIRE(policy->shouldRetry(search, sent, Response(), 1, milliseconds(0), delay));
+        REQUIRE(policy->shouldRetry(search, nullptr, makeResponse(502), 1, milliseconds(0), delay));
+        REQUIRE(policy->shouldRetry(publish, notSent, Response(), 1, milliseconds(0), delay));
+        REQUIRE(!policy->shouldRetry(publish, sent, Response(), 1, milliseconds(0), delay));
+        REQUIRE(!policy->shouldRetry(publish, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+        REQUIRE(!policy->shouldRetry(get, std::make_exception_ptr(std::logic_error("Unknown HTTP method.")),
+                                     Response(), 1, milliseconds(0), delay));
+    }
+
+    SECTION("Attempts and backoff") {
+        // Jitter is minimal for the first retry and maximal for the second one
+        auto retries = std::make_shared<int>(0);
+        auto jitteredPolicy = makePolicy(3, 0.2, 10, [retries] { return (*retries)++ == 0 ? 0.0 : 1.0; });
+
+        REQUIRE(jitteredPolicy->shouldRetry(get, sent, Response(), 1, milliseconds(0), delay));
+        REQUIRE(delay == milliseconds(5));
+        REQUIRE(jitteredPolicy->shouldRetry(get, sent, Response(), 2, milliseconds(0), delay));
+        REQUIRE(delay == milliseconds(20));
+        REQUIRE(!jitteredPolicy->shouldRetry(get, sent, Response(), 3, milliseconds(0), delay));
+        REQUIRE(*retries == 2);
+    }
+
+    SECTION("Retry-After") {
+        auto response = makeResponse(429);
+        response.header({ { "retry-after", "1" } });
+        REQUIRE(policy->shouldRetry(get, nullptr, response, 1, milliseconds(0), delay));
+        REQUIRE(delay == milliseconds(1000));
+        REQUIRE(!policy->shouldRetry(get, nullptr, response, 1, milliseconds(4500), delay));
+    }
+
+    SECTION("Deadline") {
+        REQUIRE(!policy->shouldRetry(get, sent, Response(), 1, milliseconds(4995), delay));
+
+        auto first = policy->attemptRequest(get, milliseconds(0));
+        REQUIRE(first.timeout() == milliseconds(1000));
+        REQUIRE(first.connectTimeout() == milliseconds(500));
+
+        auto last = policy->attemptRequest(get, milliseconds(4800));
+        REQUIRE(last.timeout() == milliseconds(200));
+        REQUIRE(last.connectTimeout() == milliseconds(200));
+        REQUIRE(last.uri() == get.uri());
+    }
+}
+
+TEST_CASE("test002_RetryPolicy_RetryBudget", "[retry]") {
+    auto policy = makePolicy(3, 0.5, 1);
+    auto get = makeRequest(Request::Method::GET, CardEndpointUri::get("id"));
+    auto delay = milliseconds(0);
+
+    REQUIRE(policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+    REQUIRE(!policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+    REQUIRE(policy->rejectedRetries() == 1);
+
+    policy->requestStarted();
+    REQUIRE(!policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+    policy->requestStarted();
+    REQUIRE(policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+
+    // Budget doesn't accumulate above burst
+    for (int i = 0; i < 10; ++i)
+        policy->requestStarted();
+    REQUIRE(policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+    REQUIRE(!policy->shouldRetry(get, nullptr, makeResponse(503), 1, milliseconds(0), delay));
+
+    REQUIRE(policy->retries() == 3);
+    REQUIRE(policy->rejectedRetries() == 3);
+}
+
+TEST_CASE("test003_CardClient_FlakyServer_RetriesTransientErrors", "[retry]") {
+    auto requests = std::make_shared<std::atomic<int>>(0);
+    HttpServerStub server(flakyHandler(requests, 2));
+    auto retryPolicy = makePolicy();
+
+    SECTION("Blocking connection") {
+        CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), retryPolicy);
+
+        auto response = cardClient.getCard("alice", "token").get();
+
+        REQUIRE(!response.isOutdated());
+    }
+
+    SECTION("Event loop connection") {
+        CardClient cardClient(server.baseAddress(), std::make_shared<EventLoopConnection>(),
+                              std::make_shared<ThreadPoolExecutor>(1), retryPolicy);
+
+        auto rawCards = cardClient.searchCards("alice", "token").get();
+
+        REQUIRE(rawCards.size() == 1);
+    }
+
+    REQUIRE(server.handledRequests() == 3);
+    REQUIRE(retryPolicy->retries() == 2);
+}
+
+TEST_CASE("test004_CardClient_PublishCard_RetriedOnlyIfNotSent", "[retry]") {
+    auto rawCard = RawSignedModel(VirgilByteArrayUtils::stringToBytes("{\"identity\":\"alice\"}"));
+    auto retryPolicy = makePolicy();
+
+    SECTION("Error status") {
+        auto requests = std::make_shared<std::atomic<int>>(0);
+        HttpServerStub server(flakyHandler(requests, 1));
+        CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), retryPolicy);
+
+        REQUIRE_THROWS_AS(cardClient.publishCard(rawCard, "token").get(), const Error&);
+        REQUIRE(server.handledRequests() == 1);
+        REQUIRE(retryPolicy->retries() == 0);
+    }
+
+    SECTION("Dropped connection") {
+        HttpServerStub server([](const HttpServerStub::Request &) {
+            HttpServerStub::Response response;
+            response.dropConnection = true;
+            return response;
+        });
+        CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), retryPolicy);
+
+        REQUIRE_THROWS_AS(cardClient.publishCard(rawCard, "token").get(), const TransportError&);
+        REQUIRE(server.handledRequests() == 1);
+        REQUIRE(retryPolicy->retries() == 0);
+    }
+
+    SECTION("Connection refused") {
+        std::string baseAddress;
+        {
+            HttpServerStub server([](const HttpServerStub::Request &) { return HttpServerStub::Response(); });
+            baseAddress = server.baseAddress();
+        }
+        CardClient cardClient(baseAddress, std::make_shared<KeepAliveConnection>(),
+                              ThreadPoolExecutor::defaultExecutor(), retryPolicy);
+
+        REQUIRE_THROWS_AS(cardClient.publishCard(rawCard, "token").get(), const TransportError&);
+        REQUIRE(retryPolicy->retries() == 2);
+    }
+}
+
+TEST_CASE("test005_CardClient_RetryBudgetExhausted_FailsFast", "[retry]") {
+    HttpServerStub server([](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.statusCode = 503;
+        return response;
+    });
+    auto retryPolicy = makePolicy(3, 0, 1);
+    CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                          ThreadPoolExecutor::defaultExecutor(), retryPolicy);
+
+    REQUIRE_THROWS_AS(cardClient.getCard("alice", "token").get(), const Error&);
+    REQUIRE(server.handledRequests() == 2);
+
+    REQUIRE_THROWS_AS(cardClient.getCard("alice", "token").get(), const Error&);
+    REQUIRE(server.handledRequests() == 3);
+    REQUIRE(retryPolicy->retries() == 1);
+    REQUIRE(retryPolicy->rejectedRetries() == 2);
+}
+
+TEST_CASE("test006_CardClient_SlowServer_StopsAtDeadline", "[retry]") {
+    HttpServerStub server([](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.delay = milliseconds(500);
+        return response;
+    });
+    auto retryPolicy = std::make_shared<RetryPolicy>(10, milliseconds(100), milliseconds(100), milliseconds(350),
+                                                     milliseconds(10), milliseconds(10));
+    CardClient cardClient(server.baseAddress(), std::make_shared<KeepAliveConnection>(),
+                          ThreadPoolExecutor::defaultExecutor(), retryPolicy);
+
+    REQUIRE_THROWS_AS(cardClient.getCard("alice", "token").get(), const TransportError&);
+
+    // Attempts take 100 ms each, at most 4 of them fit into deadline, though 10 are allowed
+    REQUIRE(server.handledRequests() == retryPolicy->retries() + 1);
+    REQUIRE(server.handledRequests() >= 2);
+    REQUIRE(server.handledRequests() <= 4);
+}
+
+TEST_CASE("test007_CardClient_Backoff_DoesNotBlockExecutor", "[retry]") {
+    auto requests = std::make_shared<std::atomic<int>>(0);
+    HttpServerStub server(flakyHandler(requests, 1));
+    auto retryPolicy = std::make_shared<RetryPolicy>(3, milliseconds(1000), milliseconds(500), milliseconds(5000),
+                                                     milliseconds(1000), milliseconds(1000), 0.2, 10,
+                                                     [] { return 1.0; });
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+
+    std::shared_ptr<Connection> connection;
+    SECTION("Event loop connection") {
+        connection = std::make_shared<EventLoopConnection>();
+    }
+
+    SECTION("Blocking connection") {
+        connection = std::make_shared<KeepAliveConnection>();
+    }
+
+    CardClient cardClient(server.baseAddress(), connection, executor, retryPolicy);
+
+    auto future = cardClient.searchCards("alice", "token");
+    for (int i = 0; i < 100 && retryPolicy->retries() == 0; ++i)
+        std::this_thread::sleep_for(milliseconds(5));
+    REQUIRE(retryPolicy->retries() == 1);
+
+    // Single executor thread runs other tasks while retry waits for backoff
+    REQUIRE(executor->submit([requests] { return requests->load(); }).get() == 1);
+
+    REQUIRE(future.get().size() == 1);
+    REQUIRE(server.handledRequests() == 2);
+}
@@ -34,8 +34,12 @@
  * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
  */
 
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
+#include <system_error>
+#include <thread>
 
 #include <catch.hpp>
 #include <helpers.h>
@@ -259,4 +263,272 @@ TEST_CASE("testESD002_SignAndEncryptRandomData_OneCorrectKey_ShouldDecryptValida
     auto decryptedAndVerifiedData = crypto.decryptThenVerify(signedAndEncryptedData, receiverKeyPair.privateKey(), publicKeysToVerifyWith);
 
     REQUIRE(data == decryptedAndVerifiedData);
-}
\ No newline at end of file
+}
+
+TEST_CASE("testKC001_SharedKeysUsedConcurrently_ShouldSignAndVerify", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    auto importedPrivateKey = crypto.importPrivateKey(crypto.exportPrivateKey(keyPair.privateKey()));
+    auto importedPublicKey = crypto.importPublicKey(crypto.exportPublicKey(keyPair.publicKey()));
+
+    auto data = Utils::generateRandomData(100);
+
+    std::atomic<int> failures(0);
+    auto threads = std::vector<std::thread>();
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            auto privateKey = importedPrivateKey;
+            auto publicKey = importedPublicKey;
+            for (int j = 0; j < 50; ++j) {
+                auto signature = crypto.generateSignature(data, privateKey);
+                if (!crypto.verify(data, signature, publicKey) || !crypto.verify(data, signature, keyPair.publicKey()))
+                    ++failures;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(failures == 0);
+    REQUIRE(crypto.exportPrivateKey(importedPrivateKey) == crypto.exportPrivateKey(keyPair.privateKey()));
+    REQUIRE(crypto.exportPublicKey(importedPublicKey) == crypto.exportPublicKey(keyPair.publicKey()));
+}
+
+TEST_CASE("testVB001_VerifyBatch_MixedItems_ShouldReportEachItem", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    auto wrongKeyPair = crypto.generateKeyPair();
+
+    auto data = std::vector<virgil::sdk::VirgilByteArray>();
+    auto signatures = std::vector<virgil::sdk::VirgilByteArray>();
+    for (int i = 0; i < 100; ++i) {
+        data.push_back(Utils::generateRandomData(100));
+        signatures.push_back(crypto.generateSignature(data.back(), keyPair.privateKey()));
+    }
+    // Malformed signature shouldn't break whole batch
+    signatures[7] = virgil::sdk::VirgilByteArray();
+
+    auto items = std::vector<Crypto::VerificationItem>();
+    for (size_t i = 0; i < data.size(); ++i) {
+        const auto& publicKey = i % 3 == 0 ? wrongKeyPair.publicKey() : keyPair.publicKey();
+        items.emplace_back(data[i], signatures[i], publicKey);
+    }
+
+    auto results = crypto.verifyBatch(items);
+
+    REQUIRE(results.size() == items.size());
+    for (size_t i = 0; i < results.size(); ++i)
+        REQUIRE(results[i] == (i % 3 != 0 && i != 7));
+
+    REQUIRE(crypto.verifyBatch({}).empty());
+}
+
+TEST_CASE("testES004_EncryptLargeDataStream_Pipelined_ShouldDecrypt", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+
+    // Spans several pipeline chunks, last one is partial
+    auto data = Utils::generateRandomData(3 * 1024 * 1024 + 12345);
+    auto dataStr = VirgilByteArrayUtils::bytesToString(data);
+
+    std::istringstream pipelinedInput(dataStr);
+    std::ostringstream pipelinedOutput;
+    crypto.encrypt(pipelinedInput, pipelinedOutput, { keyPair.publicKey() }, true);
+
+    std::istringstream plainInput(dataStr);
+    std::ostringstream plainOutput;
+    crypto.encrypt(plainInput, plainOutput, { keyPair.publicKey() });
+
+    // Both modes produce the same format
+    std::istringstream pipelinedEncryptedInput(pipelinedOutput.str());
+    std::ostringstream plainDecryptedOutput;
+    crypto.decrypt(pipelinedEncryptedInput, plainDecryptedOutput, keyPair.privateKey());
+    REQUIRE(plainDecryptedOutput.str() == dataStr);
+
+    std::istringstream plainEncryptedInput(plainOutput.str());
+    std::ostringstream pipelinedDecryptedOutput;
+    crypto.decrypt(plainEncryptedInput, pipelinedDecryptedOutput, keyPair.privateKey(), true);
+    REQUIRE(pipelinedDecryptedOutput.str() == dataStr);
+}
+
+TEST_CASE("testES005_EncryptDataStream_Pipelined_IncorrectKey_ShouldNotDecrypt", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    auto wrongKeyPair = crypto.generateKeyPair();
+
+    std::istringstream emptyInput;
+    std::ostringstream emptyEncryptedOutput;
+    crypto.encrypt(emptyInput, emptyEncryptedOutput, { keyPair.publicKey() }, true);
+
+    std::istringstream emptyEncryptedInput(emptyEncryptedOutput.str());
+    std::ostringstream emptyDecryptedOutput;
+    crypto.decrypt(emptyEncryptedInput, emptyDecryptedOutput, keyPair.privateKey(), true);
+    REQUIRE(emptyDecryptedOutput.str().empty());
+
+    auto dataStr = VirgilByteArrayUtils::bytesToString(Utils::generateRandomData(100000));
+    std::istringstream input(dataStr);
+    std::ostringstream encryptedOutput;
+    crypto.encrypt(input, encryptedOutput, { keyPair.publicKey() }, true);
+
+    std::istringstream encryptedInput(encryptedOutput.str());
+    std::ostringstream decryptedOutput;
+    REQUIRE_THROWS(crypto.decrypt(encryptedInput, decryptedOutput, wrongKeyPair.privateKey(), true));
+}
+
+namespace {
+    std::string readFile(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+
+        return content.str();
+    }
+
+    void writeFile(const std::string &path, const std::string &content) {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+}
+
+TEST_CASE("testEF001_EncryptFile_ShouldDecryptBothWays", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    const std::string plainPath = "testEF001.plain";
+    const std::string encryptedPath = "testEF001.encrypted";
+    const std::string decryptedPath = "testEF001.decrypted";
+
+    for (size_t size : { 0, 100, 2 * 1024 * 1024 + 17 }) {
+        auto dataStr = VirgilByteArrayUtils::bytesToString(Utils::generateRandomData(size));
+        writeFile(plainPath, dataStr);
+
+        crypto.encryptFile(plainPath, encryptedPath, { keyPair.publicKey() });
+        crypto.decryptFile(encryptedPath, decryptedPath, keyPair.privateKey());
+        REQUIRE(readFile(decryptedPath) == dataStr);
+
+        // File and stream versions produce the same format
+        std::istringstream encryptedInput(readFile(encryptedPath));
+        std::ostringstream decryptedOutput;
+        crypto.decrypt(encryptedInput, decryptedOutput, keyPair.privateKey());
+        REQUIRE(decryptedOutput.str() == dataStr);
+
+        std::istringstream plainInput(dataStr);
+        std::ostringstream encryptedOutput;
+        crypto.encrypt(plainInput, encryptedOutput, { keyPair.publicKey() });
+        writeFile(encryptedPath, encryptedOutput.str());
+        crypto.decryptFile(encryptedPath, decryptedPath, keyPair.privateKey());
+        REQUIRE(readFile(decryptedPath) == dataStr);
+    }
+
+    std::remove(plainPath.c_str());
+    std::remove(encryptedPath.c_str());
+    std::remove(decryptedPath.c_str());
+}
+
+TEST_CASE("testEF002_EncryptFile_OutputIsInput_ShouldThrow", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    const std::string path = "testEF002.data";
+
+    auto dataStr = VirgilByteArrayUtils::bytesToString(Utils::generateRandomData(64 * 1024));
+    writeFile(path, dataStr);
+
+    REQUIRE_THROWS_AS(crypto.encryptFile(path, path, { keyPair.publicKey() }), const std::system_error&);
+    // Same file through another path
+    REQUIRE_THROWS_AS(crypto.encryptFile(path, "./" + path, { keyPair.publicKey() }), const std::system_error&);
+    REQUIRE_THROWS_AS(crypto.decryptFile(path, "./" + path, keyPair.privateKey()), const std::system_error&);
+    REQUIRE(readFile(path) == dataStr);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("testSF001_SignFile_ShouldVerify", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    auto wrongKeyPair = crypto.generateKeyPair();
+    const std::string path = "testSF001.data";
+
+    auto data = Utils::generateRandomData(3 * 1024 * 1024 + 5);
+    auto dataStr = VirgilByteArrayUtils::bytesToString(data);
+    writeFile(path, dataStr);
+
+    auto signature = crypto.generateFileSignature(path, keyPair.privateKey());
+
+    REQUIRE(crypto.verifyFileSignature(path, signature, keyPair.publicKey()));
+    REQUIRE(!crypto.verifyFileSignature(path, signature, wrongKeyPair.publicKey()));
+
+    std::istringstream input(dataStr);
+    REQUIRE(crypto.verify(input, signature, keyPair.publicKey()));
+
+    std::istringstream signedInput(dataStr);
+    auto streamSignature = crypto.generateSignature(signedInput, keyPair.privateKey());
+    REQUIRE(crypto.verifyFileSignature(path, streamSignature, keyPair.publicKey()));
+
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_AS(crypto.generateFileSignature(path, keyPair.privateKey()), std::system_error&);
+    REQUIRE_THROWS_AS(crypto.encryptFile(path, "testSF001.encrypted", { keyPair.publicKey() }), std::system_error&);
+}
+
+TEST_CASE("testRS001_EncryptForRecipientSet_ShouldDecryptForEachRecipient", "[crypto]") {
+    Crypto crypto;
+    auto keyPairs = std::vector<virgil::sdk::crypto::keys::KeyPair>();
+    auto publicKeys = std::vector<PublicKey>();
+    for (int i = 0; i < 5; ++i) {
+        keyPairs.push_back(crypto.generateKeyPair());
+        publicKeys.push_back(keyPairs.back().publicKey());
+    }
+    // Duplicates are prepared once
+    publicKeys.push_back(keyPairs[0].publicKey());
+    auto senderKeyPair = crypto.generateKeyPair();
+    auto otherKeyPair = crypto.generateKeyPair();
+
+    auto recipientSet = crypto.createRecipientSet(publicKeys);
+    REQUIRE(recipientSet.size() == keyPairs.size());
+
+    auto data = Utils::generateRandomData(1000);
+
+    auto encryptedData = crypto.encrypt(data, recipientSet);
+    auto signedAndEncryptedData = crypto.signThenEncrypt(data, senderKeyPair.privateKey(), recipientSet);
+
+    auto dataStr = VirgilByteArrayUtils::bytesToString(data);
+    std::istringstream input(dataStr);
+    std::ostringstream encryptedOutput;
+    crypto.encrypt(input, encryptedOutput, recipientSet);
+
+    for (const auto& keyPair : keyPairs) {
+        REQUIRE(crypto.decrypt(encryptedData, keyPair.privateKey()) == data);
+        REQUIRE(crypto.decryptThenVerify(signedAndEncryptedData, keyPair.privateKey(), senderKeyPair.publicKey()) == data);
+
+        std::istringstream encryptedInput(encryptedOutput.str());
+        std::ostringstream decryptedOutput;
+        crypto.decrypt(encryptedInput, decryptedOutput, keyPair.privateKey());
+        REQUIRE(decryptedOutput.str() == dataStr);
+    }
+
+    REQUIRE_THROWS(crypto.decrypt(encryptedData, otherKeyPair.privateKey()));
+}
+
+TEST_CASE("testRS002_RecipientSetSharedBetweenThreads_ShouldEncrypt", "[crypto]") {
+    Crypto crypto;
+    auto keyPair = crypto.generateKeyPair();
+    auto otherKeyPair = crypto.generateKeyPair();
+    auto recipientSet = crypto.createRecipientSet({ keyPair.publicKey(), otherKeyPair.publicKey() });
+
+    std::atomic<int> failures(0);
+    auto threads = std::vector<std::thread>();
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            auto recipientSetCopy = recipientSet;
+            auto data = Utils::generateRandomData(100 + i);
+            for (int j = 0; j < 20; ++j) {
+                const auto& set = j % 2 == 0 ? recipientSet : recipientSetCopy;
+                if (crypto.decrypt(crypto.encrypt(data, set), keyPair.privateKey()) != data)
+                    ++failures;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(failures == 0);
+}
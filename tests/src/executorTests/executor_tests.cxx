@@ -0,0 +1,247 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/cards/CardManager.h>
+#include <virgil/sdk/client/CardClient.h>
+#include <virgil/sdk/executors/DelayedTaskScheduler.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/jwt/providers/CallbackJwtProvider.h>
+
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::client::CardClient;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::executors::DelayedTaskScheduler;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::TokenContext;
+using virgil::sdk::jwt::providers::CallbackJwtProvider;
+using virgil::sdk::test::stubs::HttpServerStub;
+
+TEST_CASE("test001_ThreadPoolExecutor_SubmitReturnsResults", "[executor]") {
+    ThreadPoolExecutor executor(4);
+    REQUIRE(executor.threadCount() == 4);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i)
+        futures.push_back(executor.submit([i] { return i * i; }));
+
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(futures[i].get() == i * i);
+}
+
+TEST_CASE("test002_ThreadPoolExecutor_PropagatesExceptions", "[executor]") {
+    ThreadPoolExecutor executor(2);
+
+    auto future = executor.submit([]() -> int { throw std::runtime_error("failure"); });
+
+    REQUIRE_THROWS_AS(future.get(), const std::runtime_error&);
+    REQUIRE(executor.submit([] { return true; }).get());
+}
+
+TEST_CASE("test003_ThreadPoolExecutor_QueueDepth", "[executor]") {
+    ThreadPoolExecutor executor(1);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    auto blocking = executor.submit([released] { released.wait(); });
+    while (executor.queueDepth() != 0)
+        std::this_thread::yield();
+
+    std::vector<std::future<void>> pending;
+    for (int i = 0; i < 5; ++i)
+        pending.push_back(executor.submit([] {}));
+
+    REQUIRE(executor.queueDepth() == 5);
+
+    release.set_value();
+    blocking.get();
+    for (auto &future : pending)
+        future.get();
+
+    REQUIRE(executor.queueDepth() == 0);
+}
+
+TEST_CASE("test004_ThreadPoolExecutor_NestedWaitOnSingleThread", "[executor]") {
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+
+    auto future = executor->submit([executor] {
+        auto inner = executor->submit([executor] {
+            return executor->get(executor->submit([] { return 20; })) + 1;
+        });
+        return executor->get(std::move(inner)) * 2;
+    });
+
+    REQUIRE(future.get() == 42);
+}
+
+TEST_CASE("test005_ThreadPoolExecutor_BoundedThreads", "[executor]") {
+    ThreadPoolExecutor executor(3);
+    std::atomic<int> running(0);
+    std::atomic<int> maxRunning(0);
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 30; ++i) {
+        futures.push_back(executor.submit([&running, &maxRunning] {
+            auto current = ++running;
+            auto max = maxRunning.load();
+            while (current > max && !maxRunning.compare_exchange_weak(max, current)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            --running;
+        }));
+    }
+    for (auto &future : futures)
+        future.get();
+
+    REQUIRE(maxRunning <= 3);
+}
+
+TEST_CASE("test007_ThreadPoolExecutor_GetOutsideOfPool_DoesNotRunTasks", "[executor]") {
+    ThreadPoolExecutor executor(1);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    auto blocking = executor.submit([released] { released.wait(); });
+    auto taskThread = executor.submit([] { return std::this_thread::get_id(); });
+
+    std::thread releaser([&release] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release.set_value();
+    });
+
+    // Caller just blocks, queued task is left to worker
+    REQUIRE(!executor.canRunPendingTask());
+    REQUIRE(executor.get(std::move(taskThread)) != std::this_thread::get_id());
+
+    releaser.join();
+    blocking.get();
+}
+
+TEST_CASE("test008_ThreadPoolExecutor_NestedWaits_DeepNesting", "[executor]") {
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+    std::function<int(int)> nested = [executor, &nested](int depth) -> int {
+        if (depth == 0)
+            return 0;
+        return executor->get(executor->submit([&nested, depth] { return nested(depth - 1); })) + 1;
+    };
+
+    REQUIRE(executor->submit([&nested] { return nested(10); }).get() == 10);
+}
+
+TEST_CASE("test006_CardManager_GetCard_SingleThreadExecutor", "[executor]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto rawCard = CardManager::generateRawCard(crypto, ModelSigner(crypto), keyPair.privateKey(),
+                                                keyPair.publicKey(), "alice");
+    auto cardId = CardManager::parseCard(rawCard, crypto).identifier();
+    auto rawCardJson = rawCard.exportAsJson();
+
+    HttpServerStub server([&rawCardJson](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        return response;
+    });
+
+    // Every layer shares single worker, so nested waits have to make progress by running pending tasks
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+    auto apiKeyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(apiKeyPair.privateKey(), "id", crypto, "appId", 600);
+    auto tokenProvider = std::make_shared<CallbackJwtProvider>([generator, executor](const TokenContext &) {
+        return executor->submit([generator] { return generator.generateToken("alice").stringRepresentation(); });
+    }, executor);
+    auto cardClient = std::make_shared<CardClient>(server.baseAddress(),
+                                                   std::make_shared<virgil::sdk::client::networking::KeepAliveConnection>(),
+                                                   executor);
+    CardManager cardManager(crypto, tokenProvider, nullptr, nullptr, cardClient, true, executor);
+
+    std::vector<std::future<virgil::sdk::cards::Card>> futures;
+    for (int i = 0; i < 4; ++i)
+        futures.push_back(cardManager.getCard(cardId));
+
+    for (auto &future : futures)
+        REQUIRE(future.get().identifier() == cardId);
+
+    REQUIRE(executor->queueDepth() == 0);
+}
+
+TEST_CASE("test009_DelayedTaskScheduler_FailedTask_DoesNotStopOthers", "[executor]") {
+    auto dropped = std::make_shared<std::atomic<bool>>(false);
+    auto done = std::make_shared<std::promise<void>>();
+    auto doneFuture = done->get_future();
+    {
+        DelayedTaskScheduler scheduler;
+        scheduler.schedule(std::chrono::milliseconds(10), [] { throw std::runtime_error("error"); });
+        scheduler.schedule(std::chrono::milliseconds(20), [done] { done->set_value(); });
+        scheduler.schedule(std::chrono::hours(1), [dropped] { *dropped = true; });
+
+        REQUIRE(doneFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        REQUIRE(scheduler.pendingTasks() == 1);
+    }
+
+    // Pending task is dropped by destructor
+    REQUIRE(!*dropped);
+}
+
+TEST_CASE("test010_ThreadPoolExecutor_ReleasedByHelpedTask_WaitCompletes", "[executor]") {
+    auto holder = std::make_shared<std::shared_ptr<ThreadPoolExecutor>>(std::make_shared<ThreadPoolExecutor>(1));
+    std::weak_ptr<ThreadPoolExecutor> weakExecutor = *holder;
+    auto done = std::make_shared<std::promise<int>>();
+    auto doneFuture = done->get_future();
+
+    (*holder)->execute([holder, done] {
+        // Waiting worker doesn't own executor, last reference is released by task it helps with
+        auto executor = holder->get();
+        auto result = executor->get(executor->submit([holder] {
+            holder->reset();
+            return 42;
+        }));
+        done->set_value(result);
+    });
+
+    REQUIRE(doneFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE(doneFuture.get() == 42);
+    REQUIRE(weakExecutor.expired());
+}
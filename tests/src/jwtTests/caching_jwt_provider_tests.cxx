@@ -0,0 +1,300 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/jwt/providers/CachingJwtProvider.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::executors::ExecutorInterface;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::jwt::Jwt;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::TokenContext;
+using virgil::sdk::jwt::providers::CachingJwtProvider;
+
+namespace {
+    // Runs tasks on the calling thread, or rejects them like stopped executor
+    class InlineExecutor : public ExecutorInterface {
+    public:
+        InlineExecutor() : rejecting_(false) {}
+
+        void execute(std::function<void()> task) override {
+            if (rejecting_)
+                throw std::logic_error("Executor is stopped.");
+            task();
+        }
+
+        size_t queueDepth() const override { return 0; }
+
+        void rejecting(bool rejecting) { rejecting_ = rejecting; }
+
+    private:
+        std::atomic<bool> rejecting_;
+    };
+
+    class TokenServiceFixture {
+    public:
+        explicit TokenServiceFixture(int ttl = 60, std::chrono::milliseconds delay = std::chrono::milliseconds(100))
+                : executor_(std::make_shared<ThreadPoolExecutor>(4)), requests_(0), failing_(false) {
+            auto crypto = std::make_shared<Crypto>();
+            auto generator = std::make_shared<JwtGenerator>(crypto->generateKeyPair().privateKey(), "id",
+                                                            crypto, "appId", ttl);
+            auto executor = executor_;
+            callback_ = [this, generator, executor, delay](const TokenContext& tokenContext) {
+                ++requests_;
+                auto failing = failing_.load();
+                // Token service responds asynchronously on its own thread
+                return std::async(std::launch::async, [generator, tokenContext, delay, failing] {
+                    std::this_thread::sleep_for(delay);
+                    if (failing)
+                        throw std::runtime_error("token service is unavailable");
+
+                    return generator->generateToken(tokenContext.identity()).stringRepresentation();
+                });
+            };
+        }
+
+        std::shared_ptr<CachingJwtProvider> makeProvider(double refreshFraction = 0.75, size_t maxEntries = 1024) const {
+            return std::make_shared<CachingJwtProvider>(callback_, executor_, refreshFraction, maxEntries);
+        }
+
+        size_t requests() const { return requests_; }
+
+        void failing(bool failing) { failing_ = failing; }
+
+    private:
+        std::shared_ptr<ThreadPoolExecutor> executor_;
+        std::function<std::future<std::string>(const TokenContext&)> callback_;
+        std::atomic<size_t> requests_;
+        std::atomic<bool> failing_;
+    };
+}
+
+TEST_CASE("test001_ConcurrentCallers_ShareRenewal", "[caching_jwt_provider]") {
+    TokenServiceFixture fixture;
+    auto provider = fixture.makeProvider();
+    auto tokenContext = TokenContext("get", "cards", "alice");
+
+    std::vector<std::string> tokens(16);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < tokens.size(); ++i)
+        threads.emplace_back([&, i] {
+            tokens[i] = provider->getToken(tokenContext).get()->stringRepresentation();
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(fixture.requests() == 1);
+    for (const auto& token : tokens)
+        REQUIRE(token == tokens[0]);
+
+    // Cached token is returned without waiting
+    auto future = provider->getToken(tokenContext);
+    REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    REQUIRE(future.get()->stringRepresentation() == tokens[0]);
+    REQUIRE(fixture.requests() == 1);
+}
+
+TEST_CASE("test002_ForceReload_RenewsToken", "[caching_jwt_provider]") {
+    TokenServiceFixture fixture;
+    auto provider = fixture.makeProvider();
+
+    auto token1 = provider->getToken(TokenContext("get", "cards", "alice")).get();
+
+    auto future1 = provider->getToken(TokenContext("get", "cards", "alice", true));
+    auto future2 = provider->getToken(TokenContext("get", "cards", "alice", true));
+    auto token2 = future1.get();
+
+    REQUIRE(future2.get() == token2);
+    REQUIRE(token2 != token1);
+    REQUIRE(provider->jwt(TokenContext("get", "cards", "alice")) == token2);
+    REQUIRE(fixture.requests() == 2);
+}
+
+TEST_CASE("test003_ExpiringToken_RenewedInBackground", "[caching_jwt_provider]") {
+    // Tokens are considered expired 5 seconds earlier, so lifetime has to exceed that
+    TokenServiceFixture fixture(10);
+    auto provider = fixture.makeProvider(0.2);
+    auto tokenContext = TokenContext("get", "cards", "alice");
+
+    auto token1 = provider->getToken(tokenContext).get();
+    std::this_thread::sleep_for(std::chrono::seconds(3));
+
+    // Old token is still valid, so it's returned while new one is requested
+    auto future = provider->getToken(tokenContext);
+    REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    REQUIRE(future.get() == token1);
+
+    for (int i = 0; i < 100 && provider->jwt(tokenContext) == token1; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    REQUIRE(fixture.requests() == 2);
+    REQUIRE(provider->getToken(tokenContext).get() != token1);
+}
+
+TEST_CASE("test004_FailedRenewal_Retried", "[caching_jwt_provider]") {
+    TokenServiceFixture fixture;
+    auto provider = fixture.makeProvider();
+    auto tokenContext = TokenContext("get", "cards", "alice");
+
+    fixture.failing(true);
+    auto future1 = provider->getToken(tokenContext);
+    auto future2 = provider->getToken(tokenContext);
+    REQUIRE_THROWS(future1.get());
+    REQUIRE_THROWS(future2.get());
+    REQUIRE(fixture.requests() == 1);
+
+    fixture.failing(false);
+    REQUIRE(provider->getToken(tokenContext).get() != nullptr);
+    REQUIRE(fixture.requests() == 2);
+}
+
+TEST_CASE("test005_TokensCachedPerContext", "[caching_jwt_provider]") {
+    TokenServiceFixture fixture(60, std::chrono::milliseconds(10));
+    auto provider = fixture.makeProvider();
+
+    auto aliceToken = provider->getToken(TokenContext("get", "cards", "alice")).get();
+    auto bobToken = provider->getToken(TokenContext("get", "cards", "bob")).get();
+    auto alicePublishToken = provider->getToken(TokenContext("publish", "cards", "alice")).get();
+
+    REQUIRE(aliceToken != bobToken);
+    REQUIRE(aliceToken != alicePublishToken);
+    REQUIRE(provider->getToken(TokenContext("get", "cards", "alice")).get() == aliceToken);
+    REQUIRE(provider->getToken(TokenContext("get", "cards", "bob")).get() == bobToken);
+    REQUIRE(provider->jwt(TokenContext("search", "cards", "alice")) == nullptr);
+    REQUIRE(provider->size() == 3);
+    REQUIRE(fixture.requests() == 3);
+}
+
+TEST_CASE("test006_ManyIdentities_Concurrently", "[caching_jwt_provider]") {
+    const size_t identitiesCount = 200;
+    TokenServiceFixture fixture(60, std::chrono::milliseconds(1));
+    auto provider = fixture.makeProvider();
+
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i)
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < identitiesCount; ++j) {
+                auto identity = "identity" + std::to_string(j);
+                auto token = provider->getToken(TokenContext("get", "cards", identity)).get();
+                if (std::static_pointer_cast<Jwt>(token)->bodyContent().identity() != identity)
+                    ++mismatches;
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(mismatches == 0);
+    REQUIRE(provider->size() == identitiesCount);
+    REQUIRE(fixture.requests() == identitiesCount);
+}
+
+TEST_CASE("test007_MaxEntries_Evicted", "[caching_jwt_provider]") {
+    TokenServiceFixture fixture(60, std::chrono::milliseconds(1));
+    auto provider = fixture.makeProvider(0.75, 32);
+
+    for (size_t i = 0; i < 100; ++i)
+        provider->getToken(TokenContext("get", "cards", "identity" + std::to_string(i))).get();
+
+    REQUIRE(provider->size() <= provider->maxEntries());
+    REQUIRE(provider->size() > 0);
+    REQUIRE(provider->jwt(TokenContext("get", "cards", "identity99")) != nullptr);
+}
+
+TEST_CASE("test008_InlineExecutor_RenewsTokens", "[caching_jwt_provider]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto generator = std::make_shared<JwtGenerator>(crypto->generateKeyPair().privateKey(), "id", crypto, "appId", 60);
+    std::atomic<size_t> requests(0);
+    auto callback = [generator, &requests](const TokenContext& tokenContext) {
+        ++requests;
+        std::promise<std::string> promise;
+        promise.set_value(generator->generateToken(tokenContext.identity()).stringRepresentation());
+
+        return promise.get_future();
+    };
+    // Zero refresh fraction renews token in background on every call
+    auto provider = std::make_shared<CachingJwtProvider>(callback, std::make_shared<InlineExecutor>(), 0.0);
+    auto tokenContext = TokenContext("get", "cards", "alice");
+
+    auto token1 = provider->getToken(tokenContext).get();
+    REQUIRE(provider->jwt(tokenContext) == token1);
+    REQUIRE(requests == 1);
+
+    REQUIRE(provider->getToken(tokenContext).get() == token1);
+    auto token2 = provider->jwt(tokenContext);
+    REQUIRE(token2 != token1);
+    REQUIRE(requests == 2);
+
+    REQUIRE(provider->getToken(tokenContext).get() == token2);
+    REQUIRE(provider->jwt(tokenContext) != token2);
+    REQUIRE(requests == 3);
+
+    auto token3 = provider->getToken(TokenContext("get", "cards", "alice", true)).get();
+    REQUIRE(provider->jwt(tokenContext) == token3);
+    REQUIRE(requests == 4);
+}
+
+TEST_CASE("test009_RejectedBackgroundRenewal_ReturnsCachedToken", "[caching_jwt_provider]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto generator = std::make_shared<JwtGenerator>(crypto->generateKeyPair().privateKey(), "id", crypto, "appId", 60);
+    auto callback = [generator](const TokenContext& tokenContext) {
+        std::promise<std::string> promise;
+        promise.set_value(generator->generateToken(tokenContext.identity()).stringRepresentation());
+
+        return promise.get_future();
+    };
+    auto executor = std::make_shared<InlineExecutor>();
+    auto provider = std::make_shared<CachingJwtProvider>(callback, executor, 0.0);
+    auto tokenContext = TokenContext("get", "cards", "alice");
+
+    auto token = provider->getToken(tokenContext).get();
+
+    executor->rejecting(true);
+    REQUIRE(provider->getToken(tokenContext).get() == token);
+    REQUIRE_THROWS_AS(provider->getToken(TokenContext("get", "cards", "alice", true)), const std::logic_error&);
+
+    // Rejected renewals don't stay in progress
+    executor->rejecting(false);
+    REQUIRE(provider->getToken(TokenContext("get", "cards", "alice", true)).get() != token);
+}
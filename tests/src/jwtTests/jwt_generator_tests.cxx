@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/jwt/JwtVerifier.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::jwt::Jwt;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::JwtVerifier;
+
+TEST_CASE("test001_GenerateTokens_OrderPreserved", "[jwt_generator]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto executor = std::make_shared<ThreadPoolExecutor>(4);
+    auto generator = JwtGenerator(keyPair.privateKey(), "id", crypto, "appId", 60, executor);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto);
+
+    auto identities = std::vector<std::string>();
+    for (int i = 0; i < 150; ++i)
+        identities.push_back("identity" + std::to_string(i));
+
+    auto tokens = generator.generateTokens(identities, { { "username", "alice" } });
+
+    REQUIRE(tokens.size() == identities.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const auto& token = tokens[i];
+        REQUIRE(token.identity() == identities[i]);
+        REQUIRE(token.bodyContent().appId() == "appId");
+        REQUIRE(token.bodyContent().additionalData().at("username") == "alice");
+        REQUIRE(token.bodyContent().issuedAt() == tokens[0].bodyContent().issuedAt());
+        REQUIRE(token.bodyContent().expiresAt() == token.bodyContent().issuedAt() + 60);
+        REQUIRE(verifier.verifyToken(token));
+
+        auto parsedToken = Jwt::parse(token.stringRepresentation());
+        REQUIRE(parsedToken.identity() == identities[i]);
+        REQUIRE(parsedToken.dataToSign() == token.dataToSign());
+        REQUIRE(verifier.verifyToken(parsedToken));
+    }
+}
+
+TEST_CASE("test002_GenerateTokens_SmallBatches", "[jwt_generator]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(keyPair.privateKey(), "id", crypto, "appId", 60);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto);
+
+    REQUIRE(generator.generateTokens({}).empty());
+
+    auto tokens = generator.generateTokens({ "alice" });
+    REQUIRE(tokens.size() == 1);
+    REQUIRE(tokens[0].identity() == "alice");
+    REQUIRE(verifier.verifyToken(tokens[0]));
+}
+
+TEST_CASE("test003_GenerateToken_MatchesSerialization", "[jwt_generator]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(keyPair.privateKey(), "id", crypto, "appId", 60);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto);
+
+    auto token = generator.generateToken("alice");
+    auto rebuiltToken = Jwt(token.headerContent(), token.bodyContent(), token.signatureContent());
+
+    REQUIRE(rebuiltToken.stringRepresentation() == token.stringRepresentation());
+    REQUIRE(rebuiltToken.dataToSign() == token.dataToSign());
+    REQUIRE(verifier.verifyToken(token));
+}
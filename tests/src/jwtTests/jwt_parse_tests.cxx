@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/util/Base64Url.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::jwt::Jwt;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::util::Base64Url;
+using virgil::sdk::VirgilByteArrayUtils;
+
+TEST_CASE("test001_Parse_GeneratedToken", "[jwt_parse]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto generator = JwtGenerator(crypto->generateKeyPair().privateKey(), "id", crypto, "appId", 60);
+    auto token = generator.generateToken("alice", { { "key", "value" } });
+
+    auto parsed = Jwt::parse(token.stringRepresentation());
+
+    REQUIRE(parsed.stringRepresentation() == token.stringRepresentation());
+    REQUIRE(parsed.dataToSign() == token.dataToSign());
+    REQUIRE(parsed.signatureContent() == token.signatureContent());
+    REQUIRE(parsed.headerContent().keyIdentifier() == "id");
+    REQUIRE(parsed.headerContent().algorithm() == token.headerContent().algorithm());
+    REQUIRE(parsed.bodyContent().appId() == "appId");
+    REQUIRE(parsed.bodyContent().identity() == "alice");
+    REQUIRE(parsed.bodyContent().issuedAt() == token.bodyContent().issuedAt());
+    REQUIRE(parsed.bodyContent().expiresAt() == token.bodyContent().expiresAt());
+    REQUIRE(parsed.bodyContent().additionalData() == token.bodyContent().additionalData());
+}
+
+TEST_CASE("test002_Parse_KeepsReceivedData", "[jwt_parse]") {
+    // Fields order and formatting differ from the ones produced by serializer
+    auto header = Base64Url::encode("{\"kid\":\"id\", \"typ\":\"JWT\", \"cty\":\"virgil-jwt;v=1\", \"alg\":\"VEDS512\"}");
+    auto body = Base64Url::encode("{\"exp\":1518513909, \"iat\":1518513309, \"ada\":null,"
+                                  " \"sub\":\"identity-bob\", \"iss\":\"virgil-appId\"}");
+    auto signature = Base64Url::encode("signature");
+    auto tokenString = header + "." + body + "." + signature;
+
+    auto jwt = Jwt::parse(tokenString);
+
+    REQUIRE(jwt.stringRepresentation() == tokenString);
+    REQUIRE(VirgilByteArrayUtils::bytesToString(jwt.dataToSign()) == header + "." + body);
+    REQUIRE(VirgilByteArrayUtils::bytesToString(jwt.signatureContent()) == "signature");
+    REQUIRE(jwt.bodyContent().identity() == "bob");
+    REQUIRE(jwt.bodyContent().expiresAt() == 1518513909);
+    REQUIRE(jwt.bodyContent().additionalData().empty());
+}
+
+TEST_CASE("test003_Parse_InvalidToken", "[jwt_parse]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto generator = JwtGenerator(crypto->generateKeyPair().privateKey(), "id", crypto, "appId", 60);
+    auto tokenString = generator.generateToken("alice").stringRepresentation();
+    auto bodyStart = tokenString.find('.') + 1;
+
+    REQUIRE_THROWS(Jwt::parse(""));
+    REQUIRE_THROWS(Jwt::parse(tokenString.substr(0, tokenString.rfind('.'))));
+    REQUIRE_THROWS(Jwt::parse(tokenString + ".part"));
+    REQUIRE_THROWS(Jwt::parse(tokenString.substr(bodyStart)));
+    REQUIRE_THROWS(Jwt::parse(Base64Url::encode("{}") + tokenString.substr(bodyStart - 1)));
+}
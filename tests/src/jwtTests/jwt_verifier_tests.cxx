@@ -0,0 +1,128 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/jwt/JwtVerifier.h>
+
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::jwt::Jwt;
+using virgil::sdk::jwt::JwtBodyContent;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::JwtVerifier;
+
+TEST_CASE("test001_VerifyToken_Cached", "[jwt_verifier]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(keyPair.privateKey(), "id", crypto, "appId", 60);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto, 2);
+    auto plainVerifier = JwtVerifier(keyPair.publicKey(), "id", crypto);
+
+    auto token = generator.generateToken("alice");
+    REQUIRE(plainVerifier.verifyToken(token));
+    REQUIRE(plainVerifier.cachedVerificationsCount() == 0);
+
+    REQUIRE(verifier.verifyToken(token));
+    REQUIRE(verifier.cachedVerificationsCount() == 1);
+    REQUIRE(verifier.verifyToken(Jwt::parse(token.stringRepresentation())));
+    REQUIRE(verifier.cachedVerificationsCount() == 1);
+
+    // Cache is bounded
+    REQUIRE(verifier.verifyToken(generator.generateToken("bob")));
+    REQUIRE(verifier.verifyToken(generator.generateToken("carol")));
+    REQUIRE(verifier.cachedVerificationsCount() == 2);
+}
+
+TEST_CASE("test002_VerifyToken_SignatureReusedWithOtherData", "[jwt_verifier]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(keyPair.privateKey(), "id", crypto, "appId", 60);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto, 16);
+
+    auto token = generator.generateToken("alice");
+    REQUIRE(verifier.verifyToken(token));
+
+    const auto& body = token.bodyContent();
+    auto forgedBody = JwtBodyContent(body.appId(), "mallory", body.expiresAt(), body.issuedAt(),
+                                     body.additionalData());
+    auto forgedToken = Jwt(token.headerContent(), forgedBody, token.signatureContent());
+
+    REQUIRE(!verifier.verifyToken(forgedToken));
+    REQUIRE(verifier.verifyToken(token));
+}
+
+TEST_CASE("test003_VerifyToken_InvalidNotCached", "[jwt_verifier]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto otherKeyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(otherKeyPair.privateKey(), "id", crypto, "appId", 60);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto, 16);
+
+    auto token = generator.generateToken("alice");
+    REQUIRE(!verifier.verifyToken(token));
+    REQUIRE(!verifier.verifyToken(token));
+    REQUIRE(verifier.cachedVerificationsCount() == 0);
+}
+
+TEST_CASE("test004_VerifyTokens_Batch", "[jwt_verifier]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto keyPair = crypto->generateKeyPair();
+    auto otherKeyPair = crypto->generateKeyPair();
+    auto generator = JwtGenerator(keyPair.privateKey(), "id", crypto, "appId", 60);
+    auto otherGenerator = JwtGenerator(otherKeyPair.privateKey(), "id", crypto, "appId", 60);
+    auto verifier = JwtVerifier(keyPair.publicKey(), "id", crypto, 64);
+    auto plainVerifier = JwtVerifier(keyPair.publicKey(), "id", crypto);
+
+    auto tokens = std::vector<Jwt>();
+    for (int i = 0; i < 40; ++i) {
+        auto identity = "identity" + std::to_string(i);
+        tokens.push_back(i % 4 == 0 ? otherGenerator.generateToken(identity) : generator.generateToken(identity));
+    }
+
+    REQUIRE(verifier.verifyToken(tokens[1]));
+    REQUIRE(verifier.cachedVerificationsCount() == 1);
+
+    auto results = verifier.verifyTokens(tokens);
+    auto plainResults = plainVerifier.verifyTokens(tokens);
+
+    REQUIRE(results.size() == tokens.size());
+    REQUIRE(results == plainResults);
+    for (size_t i = 0; i < tokens.size(); ++i)
+        REQUIRE(results[i] == (i % 4 != 0));
+    REQUIRE(verifier.cachedVerificationsCount() == 30);
+    REQUIRE(plainVerifier.verifyTokens({}).empty());
+}
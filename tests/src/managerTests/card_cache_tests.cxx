@@ -0,0 +1,251 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/cards/CardCache.h>
+#include <virgil/sdk/cards/CardManager.h>
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/jwt/providers/GeneratorJwtProvider.h>
+
+using virgil::sdk::cards::Card;
+using virgil::sdk::cards::CardCache;
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::providers::GeneratorJwtProvider;
+using virgil::sdk::test::stubs::HttpServerStub;
+
+namespace {
+    RawSignedModel generateRawCard(const std::shared_ptr<Crypto> &crypto, const std::string &identity,
+                                   const std::string &previousCardId = std::string()) {
+        auto keyPair = crypto->generateKeyPair();
+        return CardManager::generateRawCard(crypto, ModelSigner(crypto), keyPair.privateKey(), keyPair.publicKey(),
+                                            identity, previousCardId);
+    }
+
+    std::shared_ptr<CardManager> makeCardManager(const std::shared_ptr<Crypto> &crypto, const std::string &serviceUrl,
+                                                 const std::shared_ptr<CardCache> &cardCache) {
+        auto apiKeyPair = crypto->generateKeyPair();
+        auto generator = JwtGenerator(apiKeyPair.privateKey(), "id", crypto, "appId", 600);
+        auto tokenProvider = std::make_shared<GeneratorJwtProvider>(generator, "alice");
+
+        return std::make_shared<CardManager>(crypto, tokenProvider, nullptr, nullptr,
+                                             std::make_shared<CardClient>(serviceUrl), true,
+                                             virgil::sdk::executors::ThreadPoolExecutor::defaultExecutor(),
+                                             cardCache);
+    }
+}
+
+TEST_CASE("test001_CardCache_FindAddedCard", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto card = CardManager::parseCard(generateRawCard(crypto, "alice"), crypto);
+    CardCache cache;
+
+    REQUIRE(cache.findCard(card.identifier()) == nullptr);
+    cache.addCard(card);
+
+    auto cachedCard = cache.findCard(card.identifier());
+    REQUIRE(cachedCard != nullptr);
+    REQUIRE(cachedCard->identifier() == card.identifier());
+    REQUIRE(cachedCard->contentSnapshot() == card.contentSnapshot());
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 1);
+}
+
+TEST_CASE("test002_CardCache_EvictsLeastRecentlyUsed", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto card1 = CardManager::parseCard(generateRawCard(crypto, "alice"), crypto);
+    auto card2 = CardManager::parseCard(generateRawCard(crypto, "bob"), crypto);
+    auto card3 = CardManager::parseCard(generateRawCard(crypto, "carol"), crypto);
+    CardCache cache(2);
+
+    cache.addCard(card1);
+    cache.addCard(card2);
+    REQUIRE(cache.findCard(card1.identifier()) != nullptr);
+    cache.addCard(card3);
+
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.findCard(card1.identifier()) != nullptr);
+    REQUIRE(cache.findCard(card2.identifier()) == nullptr);
+    REQUIRE(cache.findCard(card3.identifier()) != nullptr);
+}
+
+TEST_CASE("test003_CardCache_EntriesExpire", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto card = CardManager::parseCard(generateRawCard(crypto, "alice"), crypto);
+    CardCache cache(16, std::chrono::milliseconds(50));
+
+    cache.addCard(card);
+    cache.addCards("alice", std::vector<Card> { card });
+    REQUIRE(cache.findCard(card.identifier()) != nullptr);
+    REQUIRE(cache.findCards("alice") != nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    REQUIRE(cache.findCard(card.identifier()) == nullptr);
+    REQUIRE(cache.findCards("alice") == nullptr);
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("test004_CardCache_SupersededCardsAreDropped", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto oldCard = CardManager::parseCard(generateRawCard(crypto, "alice"), crypto);
+    auto newCard = CardManager::parseCard(generateRawCard(crypto, "alice", oldCard.identifier()), crypto);
+    CardCache cache;
+
+    cache.addCard(oldCard);
+    cache.addCards("alice", std::vector<Card> { oldCard });
+    cache.addCard(newCard);
+    REQUIRE(cache.findCard(oldCard.identifier()) == nullptr);
+    REQUIRE(cache.findCard(newCard.identifier()) != nullptr);
+    REQUIRE(cache.findCards("alice") == nullptr);
+
+    cache.addCards("alice", std::vector<Card> { newCard });
+    newCard.isOutdated(true);
+    cache.addCard(newCard);
+    REQUIRE(cache.findCard(newCard.identifier()) == nullptr);
+    REQUIRE(cache.findCards("alice") == nullptr);
+}
+
+TEST_CASE("test005_CardManager_GetCard_UsesCache", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto rawCard = generateRawCard(crypto, "alice");
+    auto cardId = CardManager::parseCard(rawCard, crypto).identifier();
+    auto rawCardJson = rawCard.exportAsJson();
+
+    HttpServerStub server([&rawCardJson](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        return response;
+    });
+    auto cardCache = std::make_shared<CardCache>();
+    auto cardManager = makeCardManager(crypto, server.baseAddress(), cardCache);
+
+    for (int i = 0; i < 5; ++i)
+        REQUIRE(cardManager->getCard(cardId).get().identifier() == cardId);
+
+    REQUIRE(server.handledRequests() == 1);
+    REQUIRE(cardCache->hits() == 4);
+    REQUIRE(cardCache->misses() == 1);
+}
+
+TEST_CASE("test006_CardManager_GetCard_OutdatedCardIsNotCached", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto rawCard = generateRawCard(crypto, "alice");
+    auto cardId = CardManager::parseCard(rawCard, crypto).identifier();
+    auto rawCardJson = rawCard.exportAsJson();
+
+    HttpServerStub server([&rawCardJson](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardJson;
+        response.header[CardClient::xVirgilIsSuperseededKey] = "true";
+        return response;
+    });
+    auto cardCache = std::make_shared<CardCache>();
+    auto cardManager = makeCardManager(crypto, server.baseAddress(), cardCache);
+
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(cardManager->getCard(cardId).get().isOutdated());
+
+    REQUIRE(server.handledRequests() == 3);
+    REQUIRE(cardCache->size() == 0);
+}
+
+TEST_CASE("test007_CardManager_SearchCards_UsesCache", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto rawCard = generateRawCard(crypto, "alice");
+    auto cardId = CardManager::parseCard(rawCard, crypto).identifier();
+    auto rawCardsJson = "[" + rawCard.exportAsJson() + "]";
+
+    HttpServerStub server([&rawCardsJson](const HttpServerStub::Request &) {
+        HttpServerStub::Response response;
+        response.body = rawCardsJson;
+        return response;
+    });
+    auto cardCache = std::make_shared<CardCache>();
+    auto cardManager = makeCardManager(crypto, server.baseAddress(), cardCache);
+
+    for (int i = 0; i < 3; ++i) {
+        auto cards = cardManager->searchCards("alice").get();
+        REQUIRE(cards.size() == 1);
+        REQUIRE(cards[0].identifier() == cardId);
+    }
+    REQUIRE(cardManager->getCard(cardId).get().identifier() == cardId);
+
+    REQUIRE(server.handledRequests() == 1);
+    REQUIRE(cardCache->hits() == 3);
+}
+
+TEST_CASE("test008_CardManager_SearchCards_SupersededByFetchedCard", "[card_cache]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto oldRawCard = generateRawCard(crypto, "alice");
+    auto oldCardId = CardManager::parseCard(oldRawCard, crypto).identifier();
+    auto newRawCard = generateRawCard(crypto, "alice", oldCardId);
+    auto newCardId = CardManager::parseCard(newRawCard, crypto).identifier();
+    auto oldRawCardsJson = "[" + oldRawCard.exportAsJson() + "]";
+    auto newRawCardsJson = "[" + newRawCard.exportAsJson() + "]";
+    auto newRawCardJson = newRawCard.exportAsJson();
+    std::atomic<int> searches(0);
+
+    HttpServerStub server([&](const HttpServerStub::Request &request) {
+        HttpServerStub::Response response;
+        if (request.method == "POST")
+            response.body = searches++ == 0 ? oldRawCardsJson : newRawCardsJson;
+        else
+            response.body = newRawCardJson;
+        return response;
+    });
+    auto cardCache = std::make_shared<CardCache>();
+    auto cardManager = makeCardManager(crypto, server.baseAddress(), cardCache);
+
+    REQUIRE(cardManager->searchCards("alice").get()[0].identifier() == oldCardId);
+    REQUIRE(cardManager->getCard(newCardId).get().identifier() == newCardId);
+
+    auto cards = cardManager->searchCards("alice").get();
+    REQUIRE(cards.size() == 1);
+    REQUIRE(cards[0].identifier() == newCardId);
+    REQUIRE(searches == 2);
+}
@@ -0,0 +1,250 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include <nlohman/json.hpp>
+
+#include <stubs/HttpServerStub.h>
+
+#include <virgil/sdk/cards/CardManager.h>
+#include <virgil/sdk/jwt/JwtGenerator.h>
+#include <virgil/sdk/jwt/providers/CallbackJwtProvider.h>
+#include <virgil/sdk/VirgilSdkException.h>
+
+using virgil::sdk::cards::Card;
+using virgil::sdk::cards::CardCache;
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::client::CardClient;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::executors::ThreadPoolExecutor;
+using virgil::sdk::jwt::JwtGenerator;
+using virgil::sdk::jwt::TokenContext;
+using virgil::sdk::jwt::providers::CallbackJwtProvider;
+using virgil::sdk::test::stubs::HttpServerStub;
+using virgil::sdk::VirgilSdkException;
+
+namespace {
+    class CardsServiceFixture {
+    public:
+        CardsServiceFixture(size_t cardsNumber)
+                : crypto_(std::make_shared<Crypto>()), tokenRequests_(0),
+                  server_([this](const HttpServerStub::Request &request) { return handle(request); }) {
+            for (size_t i = 0; i < cardsNumber; ++i) {
+                auto keyPair = crypto_->generateKeyPair();
+                auto rawCard = CardManager::generateRawCard(crypto_, ModelSigner(crypto_), keyPair.privateKey(),
+                                                            keyPair.publicKey(), "identity" + std::to_string(i));
+                auto cardId = CardManager::parseCard(rawCard, crypto_).identifier();
+                cardIds_.push_back(cardId);
+                rawCards_[cardId] = rawCard.exportAsJson();
+                identityRawCards_["identity" + std::to_string(i)].push_back(rawCard.exportAsJson());
+            }
+        }
+
+        std::shared_ptr<CardManager> cardManager(const std::shared_ptr<CardCache> &cardCache = nullptr) {
+            auto apiKeyPair = crypto_->generateKeyPair();
+            auto generator = JwtGenerator(apiKeyPair.privateKey(), "id", crypto_, "appId", 600);
+            auto tokenRequests = &tokenRequests_;
+            auto tokenProvider = std::make_shared<CallbackJwtProvider>([generator, tokenRequests](const TokenContext &) {
+                ++*tokenRequests;
+                std::promise<std::string> p;
+                p.set_value(generator.generateToken("alice").stringRepresentation());
+                return p.get_future();
+            });
+
+            return std::make_shared<CardManager>(crypto_, tokenProvider, nullptr, nullptr,
+                                                 std::make_shared<CardClient>(server_.baseAddress()), true,
+                                                 ThreadPoolExecutor::defaultExecutor(), cardCache);
+        }
+
+        const std::vector<std::string>& cardIds() const { return cardIds_; }
+
+        size_t tokenRequests() const { return tokenRequests_; }
+
+        size_t handledRequests() const { return server_.handledRequests(); }
+
+        void addRawCard(const RawSignedModel &rawCard) {
+            auto card = CardManager::parseCard(rawCard, crypto_);
+            rawCards_[card.identifier()] = rawCard.exportAsJson();
+            identityRawCards_[card.identity()].push_back(rawCard.exportAsJson());
+        }
+
+        const std::shared_ptr<Crypto>& crypto() const { return crypto_; }
+
+    private:
+        HttpServerStub::Response handle(const HttpServerStub::Request &request) {
+            HttpServerStub::Response response;
+            if (request.path == "/card/v5/actions/search") {
+                auto found = std::vector<std::string>();
+                auto body = nlohmann::json::parse(request.body);
+                auto identities = body.find("identity") != body.end()
+                                  ? nlohmann::json::array({ body["identity"] }) : body["identities"];
+                for (auto &identity : identities) {
+                    auto rawCards = identityRawCards_.find(identity.get<std::string>());
+                    if (rawCards != identityRawCards_.end())
+                        found.insert(found.end(), rawCards->second.begin(), rawCards->second.end());
+                }
+                response.body = "[";
+                for (size_t i = 0; i < found.size(); ++i)
+                    response.body += (i == 0 ? "" : ",") + found[i];
+                response.body += "]";
+
+                return response;
+            }
+
+            auto cardId = request.path.substr(request.path.rfind('/') + 1);
+            auto rawCard = rawCards_.find(cardId);
+            if (rawCard == rawCards_.end()) {
+                response.statusCode = 404;
+                response.body = "{\"code\":10001,\"message\":\"Card not found\"}";
+            } else
+                response.body = rawCard->second;
+            response.delay = std::chrono::milliseconds(20);
+
+            return response;
+        }
+
+        std::shared_ptr<Crypto> crypto_;
+        std::vector<std::string> cardIds_;
+        std::map<std::string, std::string> rawCards_;
+        std::map<std::string, std::vector<std::string>> identityRawCards_;
+        std::atomic<size_t> tokenRequests_;
+        HttpServerStub server_;
+    };
+}
+
+TEST_CASE("test001_GetCards_ReturnsCardsInInputOrder", "[card_manager_batch]") {
+    CardsServiceFixture fixture(8);
+    auto cardManager = fixture.cardManager();
+
+    auto cardIds = fixture.cardIds();
+    std::reverse(cardIds.begin(), cardIds.end());
+    cardIds.push_back(cardIds.front());
+
+    auto cards = cardManager->getCards(cardIds).get();
+
+    REQUIRE(cards.size() == cardIds.size());
+    for (size_t i = 0; i < cardIds.size(); ++i)
+        REQUIRE(cards[i].identifier() == cardIds[i]);
+    REQUIRE(fixture.tokenRequests() == 1);
+    REQUIRE(fixture.handledRequests() == cardIds.size());
+}
+
+TEST_CASE("test002_GetCards_UsesCache", "[card_manager_batch]") {
+    CardsServiceFixture fixture(4);
+    auto cardCache = std::make_shared<CardCache>();
+    auto cardManager = fixture.cardManager(cardCache);
+
+    REQUIRE(cardManager->getCard(fixture.cardIds()[1]).get().identifier() == fixture.cardIds()[1]);
+    auto cards = cardManager->getCards(fixture.cardIds()).get();
+
+    REQUIRE(cards.size() == 4);
+    REQUIRE(cards[1].identifier() == fixture.cardIds()[1]);
+    REQUIRE(fixture.handledRequests() == 4);
+
+    cards = cardManager->getCards(fixture.cardIds()).get();
+    REQUIRE(cards.size() == 4);
+    REQUIRE(fixture.handledRequests() == 4);
+    REQUIRE(fixture.tokenRequests() == 2);
+}
+
+TEST_CASE("test003_GetCards_MissingCard_Throws", "[card_manager_batch]") {
+    CardsServiceFixture fixture(2);
+    auto cardManager = fixture.cardManager();
+
+    auto cardIds = fixture.cardIds();
+    cardIds.push_back("0000000000000000000000000000000000000000000000000000000000000000");
+
+    REQUIRE_THROWS_AS(cardManager->getCards(cardIds).get(), const VirgilSdkException&);
+}
+
+TEST_CASE("test004_SearchCards_MultipleIdentities_Batched", "[card_manager_batch]") {
+    CardsServiceFixture fixture(120);
+    auto crypto = fixture.crypto();
+    auto keyPair = crypto->generateKeyPair();
+    auto newRawCard = CardManager::generateRawCard(crypto, ModelSigner(crypto), keyPair.privateKey(),
+                                                   keyPair.publicKey(), "identity7", fixture.cardIds()[7]);
+    fixture.addRawCard(newRawCard);
+    auto newCardId = CardManager::parseCard(newRawCard, crypto).identifier();
+    auto cardManager = fixture.cardManager();
+
+    auto identities = std::vector<std::string>();
+    for (size_t i = 0; i < 120; ++i)
+        identities.push_back("identity" + std::to_string(i));
+    identities.push_back("unknown");
+
+    auto cards = cardManager->searchCards(identities).get();
+
+    REQUIRE(cards.size() == 121);
+    for (size_t i = 0; i < 120; ++i) {
+        auto& identityCards = cards["identity" + std::to_string(i)];
+        REQUIRE(identityCards.size() == 1);
+        if (i != 7)
+            REQUIRE(identityCards[0].identifier() == fixture.cardIds()[i]);
+    }
+    REQUIRE(cards["unknown"].empty());
+
+    auto& chainedCard = cards["identity7"][0];
+    REQUIRE(chainedCard.identifier() == newCardId);
+    REQUIRE(chainedCard.previousCard() != nullptr);
+    REQUIRE(chainedCard.previousCard()->identifier() == fixture.cardIds()[7]);
+    REQUIRE(chainedCard.previousCard()->isOutdated());
+
+    REQUIRE(fixture.tokenRequests() == 1);
+    REQUIRE(fixture.handledRequests() == 3);
+}
+
+TEST_CASE("test005_SearchCards_MultipleIdentities_UsesCache", "[card_manager_batch]") {
+    CardsServiceFixture fixture(3);
+    auto cardCache = std::make_shared<CardCache>();
+    auto cardManager = fixture.cardManager(cardCache);
+
+    REQUIRE(cardManager->searchCards("identity0").get().size() == 1);
+    auto cards = cardManager->searchCards(std::vector<std::string> { "identity0", "identity1", "identity2" }).get();
+    REQUIRE(cards.size() == 3);
+    REQUIRE(fixture.handledRequests() == 2);
+
+    cards = cardManager->searchCards(std::vector<std::string> { "identity2", "identity1" }).get();
+    REQUIRE(cards["identity1"][0].identifier() == fixture.cardIds()[1]);
+    REQUIRE(fixture.handledRequests() == 2);
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include <virgil/sdk/cards/CardManager.h>
+
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::cards::Card;
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::crypto::Crypto;
+
+namespace {
+    RawSignedModel generateRawCard(const std::shared_ptr<Crypto>& crypto) {
+        auto modelSigner = ModelSigner(crypto);
+        auto keyPair = crypto->generateKeyPair();
+        auto rawCard = CardManager::generateRawCard(crypto, modelSigner, keyPair.privateKey(),
+                                                    keyPair.publicKey(), "alice", "previous");
+
+        auto extraFields = std::unordered_map<std::string, std::string>();
+        extraFields["key"] = "value";
+        modelSigner.sign(rawCard, "extra", keyPair.privateKey(), extraFields);
+
+        return rawCard;
+    }
+}
+
+TEST_CASE("test001_ParseCardLazily_SameValues", "[lazy_card]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto rawCard = generateRawCard(crypto);
+
+    auto card = CardManager::parseCard(rawCard, crypto);
+    auto lazyCard = CardManager::parseCardLazily(rawCard, crypto);
+
+    REQUIRE(lazyCard.identifier() == card.identifier());
+    REQUIRE(lazyCard.identity() == card.identity());
+    REQUIRE(lazyCard.version() == card.version());
+    REQUIRE(lazyCard.createdAt() == card.createdAt());
+    REQUIRE(lazyCard.previousCardId() == card.previousCardId());
+    REQUIRE(lazyCard.contentSnapshot() == card.contentSnapshot());
+    REQUIRE(crypto->exportPublicKey(lazyCard.publicKey()) == crypto->exportPublicKey(card.publicKey()));
+    REQUIRE(!lazyCard.isOutdated());
+
+    REQUIRE(lazyCard.signatures().size() == card.signatures().size());
+    for (size_t i = 0; i < card.signatures().size(); ++i) {
+        REQUIRE(lazyCard.signatures()[i].signer() == card.signatures()[i].signer());
+        REQUIRE(lazyCard.signatures()[i].signature() == card.signatures()[i].signature());
+        REQUIRE(lazyCard.signatures()[i].snapshot() == card.signatures()[i].snapshot());
+        REQUIRE(lazyCard.signatures()[i].extraFields() == card.signatures()[i].extraFields());
+    }
+    REQUIRE(lazyCard.signatures()[1].extraFields().at("key") == "value");
+
+    REQUIRE(lazyCard.getRawCard().exportAsJson() == rawCard.exportAsJson());
+}
+
+TEST_CASE("test002_ParseCardLazily_SkipsContentParsing", "[lazy_card]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto malformedSnapshot = std::string("not a card content");
+    auto rawCard = RawSignedModel(VirgilByteArray(malformedSnapshot.begin(), malformedSnapshot.end()));
+
+    REQUIRE_THROWS(CardManager::parseCard(rawCard, crypto));
+
+    auto lazyCard = CardManager::parseCardLazily(rawCard, crypto);
+
+    REQUIRE(lazyCard.identifier().size() == 64);
+    REQUIRE(lazyCard.signatures().empty());
+    REQUIRE_THROWS(lazyCard.identity());
+    REQUIRE_THROWS(lazyCard.publicKey());
+    REQUIRE_THROWS(lazyCard.identity());
+}
+
+TEST_CASE("test003_ParseCardLazily_CopiesShareValues", "[lazy_card]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto lazyCard = CardManager::parseCardLazily(generateRawCard(crypto), crypto);
+    auto copy = lazyCard;
+
+    REQUIRE(&copy.identifier() == &lazyCard.identifier());
+    REQUIRE(&copy.publicKey() == &lazyCard.publicKey());
+
+    copy.previousCardId("overridden");
+    copy.isOutdated(true);
+
+    REQUIRE(copy.previousCardId() == "overridden");
+    REQUIRE(copy.isOutdated());
+    REQUIRE(lazyCard.previousCardId() == "previous");
+    REQUIRE(!lazyCard.isOutdated());
+}
+
+TEST_CASE("test004_ParseCardLazily_ConcurrentAccess", "[lazy_card]") {
+    auto crypto = std::make_shared<Crypto>();
+    auto rawCard = generateRawCard(crypto);
+    auto expectedIdentifier = CardManager::parseCard(rawCard, crypto).identifier();
+    auto lazyCard = CardManager::parseCardLazily(rawCard, crypto);
+
+    std::atomic<size_t> failures(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            if (lazyCard.identifier() != expectedIdentifier || lazyCard.identity() != "alice"
+                || lazyCard.signatures()[1].extraFields().size() != 1)
+                ++failures;
+            lazyCard.publicKey();
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(failures == 0);
+}
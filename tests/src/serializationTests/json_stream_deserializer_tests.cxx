@@ -0,0 +1,172 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <virgil/sdk/client/models/RawSignedModel.h>
+#include <virgil/sdk/jwt/JwtBodyContent.h>
+#include <virgil/sdk/serialization/JsonDeserializer.h>
+#include <virgil/sdk/serialization/JsonStreamDeserializer.h>
+
+using virgil::sdk::client::models::RawSignedModel;
+using virgil::sdk::client::models::RawSignature;
+using virgil::sdk::jwt::JwtBodyContent;
+using virgil::sdk::serialization::JsonDeserializer;
+using virgil::sdk::serialization::JsonStreamDeserializer;
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::VirgilByteArrayUtils;
+
+namespace {
+    RawSignedModel generateRawCard(size_t index) {
+        auto rawCard = RawSignedModel(VirgilByteArrayUtils::stringToBytes("content" + std::to_string(index)));
+        rawCard.addSignature(RawSignature("self", VirgilByteArrayUtils::stringToBytes("signature1"),
+                                          VirgilByteArray()));
+        rawCard.addSignature(RawSignature("extra", VirgilByteArrayUtils::stringToBytes("signature2"),
+                                          VirgilByteArrayUtils::stringToBytes("{\"key\":\"value\"}")));
+        return rawCard;
+    }
+
+    void requireEqual(const RawSignedModel& rawCard1, const RawSignedModel& rawCard2) {
+        REQUIRE(rawCard1.contentSnapshot() == rawCard2.contentSnapshot());
+        REQUIRE(rawCard1.signatures().size() == rawCard2.signatures().size());
+        for (size_t i = 0; i < rawCard1.signatures().size(); ++i) {
+            REQUIRE(rawCard1.signatures()[i].signer() == rawCard2.signatures()[i].signer());
+            REQUIRE(rawCard1.signatures()[i].signature() == rawCard2.signatures()[i].signature());
+            REQUIRE(rawCard1.signatures()[i].snapshot() == rawCard2.signatures()[i].snapshot());
+        }
+    }
+}
+
+TEST_CASE("test001_RawSignedModel_MatchesDomDeserializer", "[json_stream]") {
+    std::string json = "[";
+    for (size_t i = 0; i < 10; ++i)
+        json += (i == 0 ? "" : ",") + generateRawCard(i).exportAsJson();
+    json += "]";
+
+    auto domRawCards = JsonDeserializer<std::vector<RawSignedModel>>::fromJsonString(json);
+    auto streamRawCards = JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(json);
+
+    REQUIRE(streamRawCards.size() == 10);
+    REQUIRE(domRawCards.size() == streamRawCards.size());
+    for (size_t i = 0; i < streamRawCards.size(); ++i)
+        requireEqual(domRawCards[i], streamRawCards[i]);
+
+    REQUIRE(JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(" [ ] ").empty());
+}
+
+TEST_CASE("test002_RawSignedModel_Formatting", "[json_stream]") {
+    // Keys in arbitrary order, unknown fields, escaped slash and whitespaces
+    std::string json = "{\n"
+            "  \"signatures\" : [ { \"signature\": \"YWJj\\/+w==\", \"extra\": {\"a\": [1, -2.5e3, null, true]},"
+            " \"signer\": \"s\\u00e9lf\\n\" } ],\n"
+            "  \"unknown\": \"\\\"quoted\\\"\",\n"
+            "  \"content_snapshot\": \"Y29udGVudA\"\n"
+            "}";
+
+    auto rawCard = JsonStreamDeserializer<RawSignedModel>::fromJsonString(json);
+
+    REQUIRE(VirgilByteArrayUtils::bytesToString(rawCard.contentSnapshot()) == "content");
+    REQUIRE(rawCard.signatures().size() == 1);
+    REQUIRE(rawCard.signatures()[0].signer() == "s\xC3\xA9lf\n");
+    REQUIRE(rawCard.signatures()[0].signature() == VirgilByteArray({'a', 'b', 'c', 0xFF, 0xEC}));
+    REQUIRE(rawCard.signatures()[0].snapshot().empty());
+}
+
+TEST_CASE("test003_RawSignedModel_InvalidJson", "[json_stream]") {
+    auto valid = generateRawCard(0).exportAsJson();
+
+    REQUIRE_NOTHROW(JsonStreamDeserializer<RawSignedModel>::fromJsonString(valid));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString(valid.substr(0, valid.size() - 1)));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString(valid + "}"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString("{\"signatures\":[]}"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString("{\"content_snapshot\":\"Y2$9\"}"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString("{\"content_snapshot\":\"Y\"}"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString(
+            "{\"content_snapshot\":\"\",\"signatures\":[{\"signer\":\"self\"}]}"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString(
+            "{\"content_snapshot\":\"\",\"signatures\":[{\"signer\":\"self\",\"signature\":\"\"},]}"));
+    REQUIRE_THROWS(JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString(valid));
+}
+
+TEST_CASE("test004_RawSignedModel_SkipsNestedUnknownValues", "[json_stream]") {
+    std::string json = "{\"a\":{\"b\":[{}, [], \"x\\\\\", 0]},\"content_snapshot\":\"Y29udGVudA==\","
+            "\"signatures\":[{\"signatures\":[1],\"signer\":\"self\",\"signature\":\"\"}],\"c\":\"d\"}";
+
+    auto rawCard = JsonStreamDeserializer<RawSignedModel>::fromJsonString(json);
+
+    REQUIRE(VirgilByteArrayUtils::bytesToString(rawCard.contentSnapshot()) == "content");
+    REQUIRE(rawCard.signatures().size() == 1);
+    REQUIRE(rawCard.signatures()[0].signer() == "self");
+}
+
+TEST_CASE("test005_RawSignedModel_MalformedValues", "[json_stream]") {
+    auto withValue = [](const std::string &value) {
+        return "{\"unknown\":" + value + ",\"content_snapshot\":\"\"}";
+    };
+
+    REQUIRE_NOTHROW(JsonStreamDeserializer<RawSignedModel>::fromJsonString(withValue("-1.5e+3")));
+    for (auto value : { "01", "-", "1.", "1e", "+1", ".5", "1e+", "--1", "0x1", "tru", "nul", "\"\\x\"", "[1,]" })
+        REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString(withValue(value)));
+
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString("[]"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString("\"content_snapshot\""));
+    REQUIRE_THROWS(JsonStreamDeserializer<std::vector<RawSignedModel>>::fromJsonString("[1]"));
+    REQUIRE_THROWS(JsonStreamDeserializer<RawSignedModel>::fromJsonString(
+            "{\"content_snapshot\":\"\",\"signatures\":[\"self\"]}"));
+}
+
+TEST_CASE("test006_JwtBodyContent_Values", "[json_stream]") {
+    auto withTimestamp = [](const std::string &issuedAt) {
+        return "{\"iss\":\"virgil-app\",\"sub\":\"identity-alice\",\"iat\":" + issuedAt +
+               ",\"exp\":1500000600,\"ada\":{\"key\":\"value\"},\"extra\":{\"ada\":[1]}}";
+    };
+
+    auto bodyContent = JsonStreamDeserializer<JwtBodyContent>::fromJsonString(withTimestamp("1500000000"));
+
+    REQUIRE(bodyContent.appId() == "app");
+    REQUIRE(bodyContent.identity() == "alice");
+    REQUIRE(bodyContent.issuedAt() == 1500000000);
+    REQUIRE(bodyContent.expiresAt() == 1500000600);
+    REQUIRE(bodyContent.additionalData().size() == 1);
+    REQUIRE(bodyContent.additionalData().at("key") == "value");
+
+    REQUIRE_NOTHROW(JsonStreamDeserializer<JwtBodyContent>::fromJsonString(withTimestamp("4102444800")));
+    REQUIRE_THROWS(JsonStreamDeserializer<JwtBodyContent>::fromJsonString(withTimestamp("1.5")));
+    REQUIRE_THROWS(JsonStreamDeserializer<JwtBodyContent>::fromJsonString(withTimestamp("18446744073709551615")));
+    REQUIRE_THROWS(JsonStreamDeserializer<JwtBodyContent>::fromJsonString(withTimestamp("015")));
+    REQUIRE_THROWS(JsonStreamDeserializer<JwtBodyContent>::fromJsonString(
+            "{\"iss\":\"virgil-app\",\"sub\":\"identity-alice\",\"iat\":0,\"exp\":0,\"ada\":{\"key\":1}}"));
+}
@@ -0,0 +1,174 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <memory>
+
+#include <virgil/sdk/cards/CardManager.h>
+#include <virgil/sdk/cards/verification/VirgilCardVerifier.h>
+#include <virgil/sdk/executors/ThreadPoolExecutor.h>
+
+using virgil::sdk::cards::Card;
+using virgil::sdk::cards::CardManager;
+using virgil::sdk::cards::ModelSigner;
+using virgil::sdk::cards::verification::VerifierCredentials;
+using virgil::sdk::cards::verification::VirgilCardVerifier;
+using virgil::sdk::cards::verification::Whitelist;
+using virgil::sdk::crypto::Crypto;
+using virgil::sdk::executors::ThreadPoolExecutor;
+
+namespace {
+    class SignersFixture {
+    public:
+        SignersFixture() : crypto_(std::make_shared<Crypto>()), modelSigner_(crypto_) {
+            for (int i = 0; i < 3; ++i) {
+                keyPairs_.push_back(crypto_->generateKeyPair());
+                whitelists_.push_back(Whitelist({
+                    VerifierCredentials("signer" + std::to_string(i), crypto_->exportPublicKey(keyPairs_[i].publicKey()))
+                }));
+            }
+        }
+
+        Card generateCard(bool signedByAll = true) const {
+            auto keyPair = crypto_->generateKeyPair();
+            auto rawCard = CardManager::generateRawCard(crypto_, modelSigner_, keyPair.privateKey(),
+                                                        keyPair.publicKey(), "alice");
+            for (size_t i = 0; i < keyPairs_.size(); ++i) {
+                // Last signature is made with key which is not in whitelist
+                auto& privateKey = signedByAll || i + 1 < keyPairs_.size()
+                                   ? keyPairs_[i].privateKey() : keyPair.privateKey();
+                modelSigner_.sign(rawCard, "signer" + std::to_string(i), privateKey);
+            }
+
+            return CardManager::parseCard(rawCard, crypto_);
+        }
+
+        const std::shared_ptr<Crypto>& crypto() const { return crypto_; }
+
+        const std::vector<Whitelist>& whitelists() const { return whitelists_; }
+
+        const std::vector<virgil::sdk::crypto::keys::KeyPair>& keyPairs() const { return keyPairs_; }
+
+    private:
+        std::shared_ptr<Crypto> crypto_;
+        ModelSigner modelSigner_;
+        std::vector<virgil::sdk::crypto::keys::KeyPair> keyPairs_;
+        std::vector<Whitelist> whitelists_;
+    };
+}
+
+TEST_CASE("test001_VerifyCard_Concurrently", "[parallel_verifier]") {
+    SignersFixture fixture;
+    auto executor = std::make_shared<ThreadPoolExecutor>(2);
+    VirgilCardVerifier sequentialVerifier(fixture.crypto(), fixture.whitelists(), true, false);
+    VirgilCardVerifier concurrentVerifier(fixture.crypto(), fixture.whitelists(), true, false, true, executor);
+
+    auto validCard = fixture.generateCard();
+    auto invalidCard = fixture.generateCard(false);
+
+    REQUIRE(concurrentVerifier.verifyConcurrently());
+    REQUIRE(sequentialVerifier.verifyCard(validCard));
+    REQUIRE(concurrentVerifier.verifyCard(validCard));
+    REQUIRE(!sequentialVerifier.verifyCard(invalidCard));
+    REQUIRE(!concurrentVerifier.verifyCard(invalidCard));
+    REQUIRE(executor->queueDepth() == 0);
+}
+
+TEST_CASE("test002_VerifyCards", "[parallel_verifier]") {
+    SignersFixture fixture;
+    VirgilCardVerifier verifier(fixture.crypto(), fixture.whitelists(), true, false);
+
+    auto cards = std::vector<Card>();
+    for (int i = 0; i < 16; ++i)
+        cards.push_back(fixture.generateCard());
+
+    REQUIRE(verifier.verifyCards(cards));
+    REQUIRE(verifier.verifyCards(std::vector<Card>()));
+
+    cards.push_back(fixture.generateCard(false));
+    REQUIRE(!verifier.verifyCards(cards));
+}
+
+TEST_CASE("test003_VerifyCards_WhitelistSatisfiedByAnySigner", "[parallel_verifier]") {
+    SignersFixture fixture;
+    const auto& crypto = fixture.crypto();
+    auto whitelist = Whitelist({
+        VerifierCredentials("signer0", crypto->exportPublicKey(fixture.keyPairs()[0].publicKey())),
+        VerifierCredentials("signer2", crypto->exportPublicKey(fixture.keyPairs()[2].publicKey()))
+    });
+    auto onlyLastSignerWhitelist = Whitelist({
+        VerifierCredentials("signer2", crypto->exportPublicKey(fixture.keyPairs()[2].publicKey()))
+    });
+    VirgilCardVerifier verifier(crypto, { whitelist }, true, false);
+    VirgilCardVerifier strictVerifier(crypto, { whitelist, onlyLastSignerWhitelist }, true, false);
+
+    // Signature of signer2 is made with wrong key
+    auto cards = std::vector<Card>();
+    for (int i = 0; i < 8; ++i)
+        cards.push_back(fixture.generateCard(false));
+
+    REQUIRE(verifier.verifyCard(cards[0]));
+    REQUIRE(verifier.verifyCards(cards));
+    REQUIRE(!strictVerifier.verifyCard(cards[0]));
+    REQUIRE(!strictVerifier.verifyCards(cards));
+}
+
+TEST_CASE("test004_VerifyCards_WhitelistWithRotatedSignerKey", "[parallel_verifier]") {
+    SignersFixture fixture;
+    const auto& crypto = fixture.crypto();
+    auto retiredKeyPair = crypto->generateKeyPair();
+    auto whitelist = Whitelist({
+        VerifierCredentials("signer0", crypto->exportPublicKey(retiredKeyPair.publicKey())),
+        VerifierCredentials("signer0", crypto->exportPublicKey(fixture.keyPairs()[0].publicKey()))
+    });
+    auto executor = std::make_shared<ThreadPoolExecutor>(2);
+    VirgilCardVerifier verifier(crypto, { whitelist }, true, false);
+    VirgilCardVerifier concurrentVerifier(crypto, { whitelist }, true, false, true, executor);
+    VirgilCardVerifier retiredVerifier(crypto, {
+        Whitelist({ VerifierCredentials("signer0", crypto->exportPublicKey(retiredKeyPair.publicKey())) })
+    }, true, false);
+
+    auto cards = std::vector<Card>();
+    for (int i = 0; i < 4; ++i)
+        cards.push_back(fixture.generateCard());
+
+    REQUIRE(verifier.verifyCard(cards[0]));
+    REQUIRE(concurrentVerifier.verifyCard(cards[0]));
+    REQUIRE(verifier.verifyCards(cards));
+    REQUIRE(!retiredVerifier.verifyCard(cards[0]));
+    REQUIRE(!retiredVerifier.verifyCards(cards));
+}
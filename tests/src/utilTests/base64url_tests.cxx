@@ -0,0 +1,128 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <random>
+
+#include <virgil/sdk/util/Base64Url.h>
+
+using virgil::sdk::util::Base64Url;
+
+namespace {
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    // Previous byte-per-iteration implementation
+    std::string referenceEncode(const std::string &in) {
+        std::string out;
+        int val = 0, valb = -6;
+        for (unsigned char c : in) {
+            val = (val << 8) + c;
+            valb += 8;
+            while (valb >= 0) {
+                out.push_back(alphabet[(val >> valb) & 0x3F]);
+                valb -= 6;
+            }
+        }
+        if (valb > -6)
+            out.push_back(alphabet[((val << 8) >> (valb + 8)) & 0x3F]);
+        return out;
+    }
+
+    std::string referenceDecode(const std::string &in) {
+        std::string out;
+        std::vector<int> T(256, -1);
+        for (int i = 0; i < 64; i++)
+            T[alphabet[i]] = i;
+
+        int val = 0, valb = -8;
+        for (unsigned char c : in) {
+            if (T[c] == -1)
+                break;
+            val = (val << 6) + T[c];
+            valb += 6;
+            if (valb >= 0) {
+                out.push_back(char((val >> valb) & 0xFF));
+                valb -= 8;
+            }
+        }
+        return out;
+    }
+}
+
+TEST_CASE("test001_Encode_MatchesReference", "[base64url]") {
+    std::mt19937 random(1);
+    for (size_t length = 0; length < 300; ++length) {
+        for (int iteration = 0; iteration < 10; ++iteration) {
+            std::string data(length, '\0');
+            for (auto& c : data)
+                c = static_cast<char>(random());
+
+            auto encoded = Base64Url::encode(data);
+            REQUIRE(encoded == referenceEncode(data));
+            REQUIRE(Base64Url::decode(encoded) == data);
+        }
+    }
+}
+
+TEST_CASE("test002_Decode_MatchesReference", "[base64url]") {
+    std::mt19937 random(2);
+    for (size_t length = 0; length < 300; ++length) {
+        for (int iteration = 0; iteration < 10; ++iteration) {
+            std::string encoded(length, '\0');
+            for (auto& c : encoded)
+                c = alphabet[random() % 64];
+
+            // Sometimes put character outside of alphabet, decoding must stop there
+            if (length > 0 && iteration % 2 == 1) {
+                const char invalid[] = { '=', '.', '+', '/', ' ', '\0', '\x80', '\xFF' };
+                encoded[random() % length] = invalid[random() % sizeof(invalid)];
+            }
+
+            REQUIRE(Base64Url::decode(encoded) == referenceDecode(encoded));
+        }
+    }
+}
+
+TEST_CASE("test003_KnownValues", "[base64url]") {
+    REQUIRE(Base64Url::encode("") == "");
+    REQUIRE(Base64Url::encode("f") == "Zg");
+    REQUIRE(Base64Url::encode("fo") == "Zm8");
+    REQUIRE(Base64Url::encode("foo") == "Zm9v");
+    REQUIRE(Base64Url::encode("\xFB\xFF\xBF") == "-_-_");
+    REQUIRE(Base64Url::decode("Zm9vYg==") == "foob");
+    REQUIRE(Base64Url::decode("-_-_") == "\xFB\xFF\xBF");
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     (1) Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *     (2) Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *     (3) Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ''AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Lead Maintainer: Virgil Security Inc. <support@virgilsecurity.com>
+ */
+
+#include <catch.hpp>
+
+#include <sstream>
+
+#include <helpers.h>
+
+#include <virgil/sdk/util/ReadAheadDataSource.h>
+#include <virgil/sdk/util/WriteBehindDataSink.h>
+
+using virgil::sdk::VirgilByteArray;
+using virgil::sdk::VirgilByteArrayUtils;
+using virgil::sdk::test::Utils;
+using virgil::sdk::util::ReadAheadDataSource;
+using virgil::sdk::util::WriteBehindDataSink;
+
+TEST_CASE("test001_ReadAheadDataSource_ReadsWholeStream", "[pipelined_stream]") {
+    auto dataStr = VirgilByteArrayUtils::bytesToString(Utils::generateRandomData(100000));
+
+    for (size_t chunkSize : { 1000, 4096, 100000, 200000 }) {
+        std::istringstream input(dataStr);
+        ReadAheadDataSource dataSource(input, chunkSize, 2);
+
+        auto result = VirgilByteArray();
+        while (dataSource.hasData()) {
+            auto chunk = dataSource.read();
+            REQUIRE(!chunk.empty());
+            REQUIRE(chunk.size() <= chunkSize);
+            result.insert(result.end(), chunk.begin(), chunk.end());
+        }
+
+        REQUIRE(VirgilByteArrayUtils::bytesToString(result) == dataStr);
+        REQUIRE(dataSource.read().empty());
+    }
+}
+
+TEST_CASE("test002_ReadAheadDataSource_DestroyedBeforeStreamEnd", "[pipelined_stream]") {
+    std::istringstream input(std::string(100000, 'a'));
+    ReadAheadDataSource dataSource(input, 100, 1);
+
+    REQUIRE(dataSource.hasData());
+    REQUIRE(dataSource.read().size() == 100);
+}
+
+TEST_CASE("test003_WriteBehindDataSink_WritesInOrder", "[pipelined_stream]") {
+    std::ostringstream output;
+    auto expected = std::string();
+    {
+        WriteBehindDataSink dataSink(output, 2);
+        for (int i = 0; i < 100; ++i) {
+            auto chunk = std::to_string(i) + ",";
+            expected += chunk;
+            REQUIRE(dataSink.isGood());
+            dataSink.write(VirgilByteArrayUtils::stringToBytes(chunk));
+        }
+        dataSink.finish();
+    }
+
+    REQUIRE(output.str() == expected);
+}
+
+TEST_CASE("test004_WriteBehindDataSink_FailedStream", "[pipelined_stream]") {
+    std::ostringstream output;
+    output.setstate(std::ios::badbit);
+
+    WriteBehindDataSink dataSink(output, 2);
+    REQUIRE(!dataSink.isGood());
+    dataSink.write(VirgilByteArrayUtils::stringToBytes("data"));
+
+    REQUIRE_THROWS_AS(dataSink.finish(), const std::runtime_error&);
+}